@@ -0,0 +1,132 @@
+#include "compressed_polygon_store.hpp"
+
+#include <utility>
+
+namespace
+{
+
+using Numerator = decltype(std::declval<ScalarDeg1>().numerator());
+
+void write_varint(std::vector<uint8_t>& bytes, int64_t value)
+{
+  // Zigzag encoding maps 0, -1, 1, -2, 2, ... to 0, 1, 2, 3, 4, ...
+  uint64_t zigzag = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+  while (zigzag >= 0x80)
+  {
+    bytes.push_back(static_cast<uint8_t>(zigzag | 0x80));
+    zigzag >>= 7;
+  }
+
+  bytes.push_back(static_cast<uint8_t>(zigzag));
+}
+
+/// Reads a varint written by @c write_varint, and advances @c ptr past it. The buffer is trusted, so there are no
+/// bounds checks.
+inline int64_t read_varint(const uint8_t*& ptr)
+{
+  uint64_t zigzag = *ptr++;
+  if (zigzag >= 0x80)
+  {
+    zigzag &= 0x7f;
+    int shift = 7;
+    uint64_t byte;
+    do
+    {
+      byte = *ptr++;
+      zigzag |= (byte & 0x7f) << shift;
+      shift += 7;
+    } while (byte >= 0x80);
+  }
+
+  return static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+}
+
+} // namespace
+
+CompressedPolygonStore CompressedPolygonStore::compress(const PolygonStore& store)
+{
+  CompressedPolygonStore result;
+  result.polygons_.reserve(store.num_polygons());
+  for (size_t i = 0; i < store.num_polygons(); i++)
+  {
+    PolygonStore::PolygonWithHolesView polygon = store.polygon(i);
+    result.polygons_.push_back(PolygonStore::Range{static_cast<uint32_t>(result.rings_.size()),
+                                                   static_cast<uint32_t>(1 + polygon.num_holes())});
+
+    result.encode_ring(polygon.outer_boundary());
+    for (size_t j = 0; j < polygon.num_holes(); j++)
+    {
+      result.encode_ring(polygon.hole(j));
+    }
+  }
+
+  result.bytes_.shrink_to_fit();
+  return result;
+}
+
+size_t CompressedPolygonStore::num_polygons() const
+{
+  return polygons_.size();
+}
+
+size_t CompressedPolygonStore::num_rings(size_t polygon_index) const
+{
+  return polygons_[polygon_index].size;
+}
+
+size_t CompressedPolygonStore::num_ring_vertices(size_t polygon_index, size_t ring_index) const
+{
+  DIDA_ASSERT(ring_index < polygons_[polygon_index].size);
+  return rings_[polygons_[polygon_index].offset + ring_index].num_vertices;
+}
+
+PolygonView2 CompressedPolygonStore::decode_ring(size_t polygon_index, size_t ring_index,
+                                                 std::vector<Point2>& vertices) const
+{
+  DIDA_ASSERT(ring_index < polygons_[polygon_index].size);
+  const Ring& ring = rings_[polygons_[polygon_index].offset + ring_index];
+
+  vertices.resize(ring.num_vertices);
+
+  const uint8_t* ptr = bytes_.data() + ring.byte_offset;
+  int64_t x = 0;
+  int64_t y = 0;
+  for (Point2& vertex : vertices)
+  {
+    x += read_varint(ptr);
+    y += read_varint(ptr);
+    vertex = Point2(ScalarDeg1::from_numerator(static_cast<Numerator>(x)),
+                    ScalarDeg1::from_numerator(static_cast<Numerator>(y)));
+  }
+
+  // The encoding is lossless, and the original ring was validated when it was added to the PolygonStore.
+  return PolygonView2::unsafe_from_vertices(ArrayView<const Point2>(vertices.data(), vertices.size()));
+}
+
+size_t CompressedPolygonStore::num_vertices() const
+{
+  return num_vertices_;
+}
+
+size_t CompressedPolygonStore::memory_usage() const
+{
+  return bytes_.capacity() + rings_.capacity() * sizeof(Ring) + polygons_.capacity() * sizeof(PolygonStore::Range);
+}
+
+void CompressedPolygonStore::encode_ring(PolygonView2 ring)
+{
+  rings_.push_back(Ring{static_cast<uint32_t>(bytes_.size()), static_cast<uint32_t>(ring.size())});
+  num_vertices_ += ring.size();
+
+  int64_t prev_x = 0;
+  int64_t prev_y = 0;
+  for (Point2 vertex : ring)
+  {
+    int64_t x = vertex.x().numerator();
+    int64_t y = vertex.y().numerator();
+    write_varint(bytes_, x - prev_x);
+    write_varint(bytes_, y - prev_y);
+    prev_x = x;
+    prev_y = y;
+  }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "polygon_store.hpp"
+
+/// A compressed copy of the polygons of a @c PolygonStore.
+///
+/// The vertices of each ring are stored as the fixed point numerators of their coordinates, where the first vertex is
+/// stored as is and every following vertex as the difference with its predecessor. The values are zigzag encoded, so
+/// that small negative differences become small unsigned values, and written as LEB128 varints. Since neighbouring
+/// vertices in the dataset are close together, most coordinates take one or two bytes instead of the full width of a
+/// @c ScalarDeg1. The encoding is lossless, so decoded rings are identical to the rings of the original store.
+class CompressedPolygonStore
+{
+public:
+  /// Creates a compressed copy of all polygons of @c store. Polygon indices in the result match those of @c store.
+  static CompressedPolygonStore compress(const PolygonStore& store);
+
+  /// Returns the number of polygons in the store.
+  size_t num_polygons() const;
+
+  /// Returns the number of rings of the given polygon. Ring 0 is the outer boundary, the remaining rings are holes.
+  size_t num_rings(size_t polygon_index) const;
+
+  /// Returns the number of vertices of the given ring.
+  size_t num_ring_vertices(size_t polygon_index, size_t ring_index) const;
+
+  /// Decodes the given ring into @c vertices, replacing its contents, and returns a view of the decoded ring. The view
+  /// is valid until @c vertices is modified.
+  PolygonView2 decode_ring(size_t polygon_index, size_t ring_index, std::vector<Point2>& vertices) const;
+
+  /// Returns the total number of vertices in the store.
+  size_t num_vertices() const;
+
+  /// Returns the number of bytes used by the buffers of the store.
+  size_t memory_usage() const;
+
+private:
+  struct Ring
+  {
+    /// The offset of the first encoded coordinate of this ring in @c bytes_.
+    uint32_t byte_offset;
+
+    uint32_t num_vertices;
+  };
+
+  void encode_ring(PolygonView2 ring);
+
+  std::vector<uint8_t> bytes_;
+
+  std::vector<Ring> rings_;
+
+  /// Each polygon is a range in @c rings_.
+  std::vector<PolygonStore::Range> polygons_;
+
+  size_t num_vertices_ = 0;
+};
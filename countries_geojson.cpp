@@ -8,34 +8,98 @@
 
 #include "dida/parser.hpp"
 
-void remove_duplicates_cyclic(std::vector<Point2>& vertices)
+std::optional<ScalarDeg1> parse_scalar_deg1(std::string_view str)
 {
-  std::vector<Point2>::iterator end_it = std::unique(vertices.begin(), vertices.end());
-  if (*(end_it - 1) == vertices.front())
+  Parser parser(str);
+  std::optional<ScalarDeg1> result = parser.parse_scalar();
+  if (!parser.finished())
   {
-    end_it--;
+    return std::nullopt;
   }
 
-  vertices.erase(end_it, vertices.end());
+  return result;
 }
 
 namespace
 {
 
-std::optional<ScalarDeg1> parse_scalar_deg1(std::string_view str)
+/// Parses a single GeoJSON linear ring into a polygon, reversing the order of its vertices if @c reverse is true.
+/// Returns @c std::nullopt if the ring doesn't form a valid polygon.
+std::optional<Polygon2> parse_ring(const rapidjson::Value& ring_json, bool reverse)
 {
-  Parser parser(str);
-  std::optional<ScalarDeg1> result = parser.parse_scalar();
-  if (!parser.finished())
+  // The coordinates are visited in the order in which they end up in the polygon, and consecutive duplicates are
+  // skipped as they're decoded, so the vertex array is written once, in its final form.
+  size_t num_coordinates = ring_json.Size();
+  std::vector<Point2> vertices;
+  vertices.reserve(num_coordinates);
+  for (size_t i = 0; i < num_coordinates; i++)
+  {
+    const rapidjson::Value& coordinate_json = ring_json[reverse ? num_coordinates - 1 - i : i];
+    std::optional<ScalarDeg1> x = parse_scalar_deg1(coordinate_json[0].GetString());
+    std::optional<ScalarDeg1> y = parse_scalar_deg1(coordinate_json[1].GetString());
+    if (!x || !y)
+    {
+      return std::nullopt;
+    }
+
+    Point2 vertex(*x, *y);
+    if (vertices.empty() || !(vertices.back() == vertex))
+    {
+      vertices.push_back(vertex);
+    }
+  }
+
+  // GeoJSON rings are closed, so the first vertex is repeated at the end.
+  if (vertices.size() > 1 && vertices.back() == vertices.front())
+  {
+    vertices.pop_back();
+  }
+
+  return Polygon2::try_construct_from_vertices(std::move(vertices));
+}
+
+/// Parses the rings of a GeoJSON Polygon, where the first ring is the outer boundary and the remaining rings are holes.
+/// Returns @c std::nullopt if the outer boundary isn't a valid polygon. Invalid holes are dropped.
+std::optional<PolygonWithHoles2> parse_polygon_with_holes(const rapidjson::Value& rings_json,
+                                                          const std::string& country_name)
+{
+  // The outer boundaries in the dataset are clockwise, while the holes have the opposite orientation, so only the outer
+  // boundary needs to be reversed to end up with counter clockwise polygons.
+  std::optional<Polygon2> outer_boundary = parse_ring(rings_json[0], true);
+  if (!outer_boundary)
   {
     return std::nullopt;
   }
 
+  PolygonWithHoles2 result{*std::move(outer_boundary), {}};
+  for (size_t i = 1; i < rings_json.Size(); i++)
+  {
+    std::optional<Polygon2> hole = parse_ring(rings_json[i], false);
+    if (!hole)
+    {
+      std::cout << "Country " << country_name << " has a hole which is not a valid polygon." << std::endl;
+      continue;
+    }
+
+    result.holes.push_back(*std::move(hole));
+  }
+
   return result;
 }
 
 } // namespace
 
+size_t PolygonWithHoles2::num_vertices() const
+{
+  size_t result = outer_boundary.size();
+  for (const Polygon2& hole : holes)
+  {
+    result += hole.size();
+  }
+
+  return result;
+}
+
 std::shared_ptr<CountriesGeoJson> CountriesGeoJson::read_from_file(const std::string& file_name)
 {
   std::ifstream stream(file_name);
@@ -64,21 +128,25 @@ std::shared_ptr<CountriesGeoJson> CountriesGeoJson::read_from_file(const std::st
 
     std::string country_name = feature_properties["ADMIN"].GetString();
 
-    const rapidjson::Value* vertices_json;
+    std::vector<PolygonWithHoles2> parts;
     const rapidjson::Value& geometry_type = feature_geometry["type"];
     const rapidjson::Value& geometry_coordinates = feature_geometry["coordinates"];
     if (strcmp(geometry_type.GetString(), "Polygon") == 0)
     {
-      vertices_json = &geometry_coordinates[0];
+      std::optional<PolygonWithHoles2> part = parse_polygon_with_holes(geometry_coordinates, country_name);
+      if (part)
+      {
+        parts.push_back(*std::move(part));
+      }
     }
     else if (strcmp(geometry_type.GetString(), "MultiPolygon") == 0)
     {
-      vertices_json = &geometry_coordinates[0][0];
-      for (size_t j = 1; j < geometry_coordinates.Size(); j++)
+      for (size_t j = 0; j < geometry_coordinates.Size(); j++)
       {
-        if (geometry_coordinates[j][0].Size() > vertices_json->Size())
+        std::optional<PolygonWithHoles2> part = parse_polygon_with_holes(geometry_coordinates[j], country_name);
+        if (part)
         {
-          vertices_json = &geometry_coordinates[j][0];
+          parts.push_back(*std::move(part));
         }
       }
     }
@@ -90,25 +158,13 @@ std::shared_ptr<CountriesGeoJson> CountriesGeoJson::read_from_file(const std::st
       continue;
     }
 
-    std::vector<Point2> vertices(vertices_json->Size());
-    for (size_t j = 0; j < vertices_json->Size(); j++)
-    {
-      std::optional<ScalarDeg1> x = parse_scalar_deg1((*vertices_json)[j][0].GetString());
-      std::optional<ScalarDeg1> y = parse_scalar_deg1((*vertices_json)[j][1].GetString());
-      vertices[j] = Point2(*x, *y);
-    }
-
-    remove_duplicates_cyclic(vertices);
-    std::reverse(vertices.begin(), vertices.end());
-
-    std::optional<Polygon2> polygon = Polygon2::try_construct_from_vertices(std::move(vertices));
-    if (!polygon)
+    if (parts.empty())
     {
       std::cout << "Country " << country_name << " not a valid polygon." << std::endl;
       continue;
     }
 
-    result->countries_.insert(std::make_pair(country_name, *std::move(polygon)));
+    result->countries_.insert(std::make_pair(country_name, std::move(parts)));
   }
 
   return result;
@@ -116,7 +172,29 @@ std::shared_ptr<CountriesGeoJson> CountriesGeoJson::read_from_file(const std::st
 
 PolygonView2 CountriesGeoJson::polygon_for_country(const std::string& country_name) const
 {
-  std::unordered_map<std::string, Polygon2>::const_iterator it = countries_.find(country_name);
+  const std::vector<PolygonWithHoles2>& parts = parts_for_country(country_name);
+  std::vector<PolygonWithHoles2>::const_iterator largest_it =
+      std::max_element(parts.begin(), parts.end(), [](const PolygonWithHoles2& a, const PolygonWithHoles2& b)
+                       { return a.outer_boundary.size() < b.outer_boundary.size(); });
+  return largest_it->outer_boundary;
+}
+
+const std::vector<PolygonWithHoles2>& CountriesGeoJson::parts_for_country(const std::string& country_name) const
+{
+  std::unordered_map<std::string, std::vector<PolygonWithHoles2>>::const_iterator it = countries_.find(country_name);
   DIDA_ASSERT(it != countries_.end());
   return it->second;
-}
\ No newline at end of file
+}
+
+std::vector<std::string> CountriesGeoJson::country_names() const
+{
+  std::vector<std::string> result;
+  result.reserve(countries_.size());
+  for (const std::pair<const std::string, std::vector<PolygonWithHoles2>>& country : countries_)
+  {
+    result.push_back(country.first);
+  }
+
+  std::sort(result.begin(), result.end());
+  return result;
+}
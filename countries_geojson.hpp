@@ -1,21 +1,48 @@
 #pragma once
 
+#include <optional>
 #include <unordered_map>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "dida/polygon2.hpp"
 
 using namespace dida;
 
+/// Parses a GeoJSON coordinate, which was read as a string to keep its exact decimal value. Returns @c std::nullopt if
+/// @c str isn't a valid scalar.
+std::optional<ScalarDeg1> parse_scalar_deg1(std::string_view str);
+
+/// A polygon with zero or more holes, as described by a GeoJSON Polygon, or by one part of a GeoJSON MultiPolygon.
+struct PolygonWithHoles2
+{
+  /// The outer boundary, in counter clockwise order.
+  Polygon2 outer_boundary;
+
+  /// The holes, each in counter clockwise order.
+  std::vector<Polygon2> holes;
+
+  /// Returns the total number of vertices of the outer boundary and all holes.
+  size_t num_vertices() const;
+};
+
 class CountriesGeoJson
 {
 public:
   static std::shared_ptr<CountriesGeoJson> read_from_file(const std::string& file_name);
 
+  /// Returns the outer boundary of the largest part of the given country, ignoring its holes.
   PolygonView2 polygon_for_country(const std::string& country_name) const;
 
+  /// Returns all parts of the given country, including their holes.
+  const std::vector<PolygonWithHoles2>& parts_for_country(const std::string& country_name) const;
+
+  /// Returns the names of all countries, in alphabetical order.
+  std::vector<std::string> country_names() const;
+
 private:
   CountriesGeoJson() = default;
 
-  std::unordered_map<std::string, Polygon2> countries_;
+  std::unordered_map<std::string, std::vector<PolygonWithHoles2>> countries_;
 };
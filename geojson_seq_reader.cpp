@@ -0,0 +1,418 @@
+#include "geojson_seq_reader.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <rapidjson/istreamwrapper.h>
+#include <rapidjson/reader.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include "countries_geojson.hpp"
+
+namespace
+{
+
+/// SAX handler which copies each element of the "features" array of a GeoJSON FeatureCollection to its own line of
+/// @c out. The input is parsed with kParseNumbersAsStringsFlag, so numbers arrive as raw numbers and keep their exact
+/// text, and strings, booleans and nulls are written back as they were. Everything outside the features is dropped.
+class FeatureLineWriter
+{
+public:
+  explicit FeatureLineWriter(std::ostream& out) : out_(&out), writer_(buffer_)
+  {
+  }
+
+  /// Whether the top level object had a "features" array.
+  bool found_features() const
+  {
+    return found_features_;
+  }
+
+  bool Null()
+  {
+    return !in_feature() || (writer_.Null() && end_scalar());
+  }
+
+  bool Bool(bool b)
+  {
+    return !in_feature() || (writer_.Bool(b) && end_scalar());
+  }
+
+  bool Int(int i)
+  {
+    return !in_feature() || (writer_.Int(i) && end_scalar());
+  }
+
+  bool Uint(unsigned u)
+  {
+    return !in_feature() || (writer_.Uint(u) && end_scalar());
+  }
+
+  bool Int64(int64_t i)
+  {
+    return !in_feature() || (writer_.Int64(i) && end_scalar());
+  }
+
+  bool Uint64(uint64_t u)
+  {
+    return !in_feature() || (writer_.Uint64(u) && end_scalar());
+  }
+
+  bool Double(double d)
+  {
+    return !in_feature() || (writer_.Double(d) && end_scalar());
+  }
+
+  bool RawNumber(const char* str, rapidjson::SizeType length, bool)
+  {
+    return !in_feature() || (writer_.RawNumber(str, length) && end_scalar());
+  }
+
+  bool String(const char* str, rapidjson::SizeType length, bool)
+  {
+    return !in_feature() || (writer_.String(str, length) && end_scalar());
+  }
+
+  bool Key(const char* str, rapidjson::SizeType length, bool)
+  {
+    if (in_feature())
+    {
+      return writer_.Key(str, length);
+    }
+
+    is_features_key_ = depth_ == 1 && length == 8 && strncmp(str, "features", 8) == 0;
+    return true;
+  }
+
+  bool StartObject()
+  {
+    return start_container(false);
+  }
+
+  bool EndObject(rapidjson::SizeType)
+  {
+    return end_container(false);
+  }
+
+  bool StartArray()
+  {
+    return start_container(true);
+  }
+
+  bool EndArray(rapidjson::SizeType)
+  {
+    return end_container(true);
+  }
+
+private:
+  /// Whether the current value is part of a feature, that is, lies within the features array.
+  bool in_feature() const
+  {
+    return in_features_ && depth_ >= 2;
+  }
+
+  bool start_container(bool is_array)
+  {
+    bool ok = true;
+    if (in_feature())
+    {
+      ok = is_array ? writer_.StartArray() : writer_.StartObject();
+    }
+    else if (is_array && is_features_key_)
+    {
+      in_features_ = true;
+      found_features_ = true;
+    }
+
+    is_features_key_ = false;
+    depth_++;
+    return ok;
+  }
+
+  bool end_container(bool is_array)
+  {
+    depth_--;
+    if (!in_feature())
+    {
+      in_features_ = false;
+      return true;
+    }
+
+    bool ok = is_array ? writer_.EndArray() : writer_.EndObject();
+    return ok && (depth_ != 2 || end_feature());
+  }
+
+  /// Ends the feature if the scalar which was just written was a whole element of the features array.
+  bool end_scalar()
+  {
+    return depth_ != 2 || end_feature();
+  }
+
+  bool end_feature()
+  {
+    *out_ << buffer_.GetString() << '\n';
+    buffer_.Clear();
+    writer_.Reset(buffer_);
+    return static_cast<bool>(*out_);
+  }
+
+  std::ostream* out_;
+  rapidjson::StringBuffer buffer_;
+  rapidjson::Writer<rapidjson::StringBuffer> writer_;
+
+  /// The number of open objects and arrays, where the top level object is depth 1.
+  int depth_ = 0;
+  bool is_features_key_ = false;
+  bool in_features_ = false;
+  bool found_features_ = false;
+};
+
+} // namespace
+
+GeoJsonSeqReader::GeoJsonSeqReader(std::istream& stream, std::string name_property)
+    : stream_(&stream), name_property_(std::move(name_property))
+{
+}
+
+bool GeoJsonSeqReader::next()
+{
+  while (true)
+  {
+    while (next_part_ < num_parts_)
+    {
+      const rapidjson::Value& rings_json = is_multi_polygon_ ? (*coordinates_)[next_part_] : *coordinates_;
+      next_part_++;
+
+      if (decode_polygon(rings_json))
+      {
+        return true;
+      }
+    }
+
+    if (!read_feature())
+    {
+      return false;
+    }
+  }
+}
+
+const std::string& GeoJsonSeqReader::name() const
+{
+  return name_;
+}
+
+size_t GeoJsonSeqReader::num_rings() const
+{
+  return ring_ends_.size();
+}
+
+ArrayView<const Point2> GeoJsonSeqReader::ring(size_t index) const
+{
+  size_t begin = index == 0 ? 0 : ring_ends_[index - 1];
+  return ArrayView<const Point2>(vertices_.data() + begin, ring_ends_[index] - begin);
+}
+
+size_t GeoJsonSeqReader::num_vertices() const
+{
+  return vertices_.size();
+}
+
+size_t GeoJsonSeqReader::num_features() const
+{
+  return num_features_;
+}
+
+bool GeoJsonSeqReader::read_feature()
+{
+  coordinates_ = nullptr;
+  next_part_ = 0;
+  num_parts_ = 0;
+
+  while (std::getline(*stream_, line_))
+  {
+    // Each record may be preceded by an ASCII record separator, and blank lines are allowed between records.
+    size_t start = line_.find_first_not_of("\x1e \t\r");
+    if (start == std::string::npos)
+    {
+      continue;
+    }
+
+    // Release the previous feature before parsing the next one, so that the document doesn't grow with the stream.
+    document_.SetNull();
+    document_.GetAllocator().Clear();
+    if (document_.Parse<rapidjson::kParseNumbersAsStringsFlag>(line_.c_str() + start).HasParseError())
+    {
+      std::cout << "Failed to parse GeoJSONSeq record " << num_features_ << std::endl;
+      continue;
+    }
+
+    if (!document_.IsObject())
+    {
+      std::cout << "GeoJSONSeq record " << num_features_ << " is not an object" << std::endl;
+      continue;
+    }
+
+    num_features_++;
+
+    // A feature without a geometry, or with a null geometry, has no polygons.
+    rapidjson::Value::ConstMemberIterator geometry_it = document_.FindMember("geometry");
+    if (geometry_it == document_.MemberEnd() || !geometry_it->value.IsObject())
+    {
+      continue;
+    }
+
+    const rapidjson::Value& feature_geometry = geometry_it->value;
+    rapidjson::Value::ConstMemberIterator type_it = feature_geometry.FindMember("type");
+    rapidjson::Value::ConstMemberIterator coordinates_it = feature_geometry.FindMember("coordinates");
+    if (type_it == feature_geometry.MemberEnd() || !type_it->value.IsString() ||
+        coordinates_it == feature_geometry.MemberEnd() || !coordinates_it->value.IsArray())
+    {
+      continue;
+    }
+
+    coordinates_ = &coordinates_it->value;
+    if (strcmp(type_it->value.GetString(), "Polygon") == 0)
+    {
+      is_multi_polygon_ = false;
+      num_parts_ = 1;
+    }
+    else if (strcmp(type_it->value.GetString(), "MultiPolygon") == 0)
+    {
+      is_multi_polygon_ = true;
+      num_parts_ = coordinates_->Size();
+    }
+    else
+    {
+      continue;
+    }
+
+    // The properties may be null, and the name property may be missing.
+    name_.clear();
+    rapidjson::Value::ConstMemberIterator properties_it = document_.FindMember("properties");
+    if (properties_it != document_.MemberEnd() && properties_it->value.IsObject())
+    {
+      const rapidjson::Value& feature_properties = properties_it->value;
+      rapidjson::Value::ConstMemberIterator name_it = feature_properties.FindMember(name_property_.c_str());
+      if (name_it != feature_properties.MemberEnd() && name_it->value.IsString())
+      {
+        name_ = name_it->value.GetString();
+      }
+    }
+
+    return true;
+  }
+
+  return false;
+}
+
+bool GeoJsonSeqReader::decode_polygon(const rapidjson::Value& rings_json)
+{
+  vertices_.clear();
+  ring_ends_.clear();
+
+  if (!rings_json.IsArray() || rings_json.Size() == 0 || !decode_ring(rings_json[0]))
+  {
+    return false;
+  }
+
+  for (rapidjson::SizeType i = 1; i < rings_json.Size(); i++)
+  {
+    decode_ring(rings_json[i]);
+  }
+
+  return true;
+}
+
+bool GeoJsonSeqReader::decode_ring(const rapidjson::Value& ring_json)
+{
+  if (!ring_json.IsArray())
+  {
+    return false;
+  }
+
+  size_t begin = vertices_.size();
+  for (rapidjson::SizeType i = 0; i < ring_json.Size(); i++)
+  {
+    const rapidjson::Value& coordinate_json = ring_json[i];
+    if (!coordinate_json.IsArray() || coordinate_json.Size() < 2 || !coordinate_json[0].IsString() ||
+        !coordinate_json[1].IsString())
+    {
+      vertices_.resize(begin);
+      return false;
+    }
+
+    std::optional<ScalarDeg1> x = parse_scalar_deg1(coordinate_json[0].GetString());
+    std::optional<ScalarDeg1> y = parse_scalar_deg1(coordinate_json[1].GetString());
+    if (!x || !y)
+    {
+      vertices_.resize(begin);
+      return false;
+    }
+
+    Point2 vertex(*x, *y);
+    if (vertices_.size() == begin || !(vertices_.back() == vertex))
+    {
+      vertices_.push_back(vertex);
+    }
+  }
+
+  // GeoJSON rings are closed, so the first vertex is repeated at the end.
+  while (vertices_.size() > begin + 1 && vertices_.back() == vertices_[begin])
+  {
+    vertices_.pop_back();
+  }
+
+  if (vertices_.size() - begin < 3)
+  {
+    vertices_.resize(begin);
+    return false;
+  }
+
+  double twice_signed_area = 0.0;
+  Point2 prev = vertices_.back();
+  for (size_t i = begin; i < vertices_.size(); i++)
+  {
+    twice_signed_area += static_cast<double>(prev.x()) * static_cast<double>(vertices_[i].y()) -
+                         static_cast<double>(vertices_[i].x()) * static_cast<double>(prev.y());
+    prev = vertices_[i];
+  }
+
+  if (twice_signed_area < 0.0)
+  {
+    std::reverse(vertices_.begin() + static_cast<std::ptrdiff_t>(begin), vertices_.end());
+  }
+
+  ring_ends_.push_back(vertices_.size());
+  return true;
+}
+
+bool convert_geojson_to_geojson_seq(const std::string& geojson_file_name, const std::string& geojson_seq_file_name)
+{
+  std::ifstream in_stream(geojson_file_name);
+  if (!in_stream)
+  {
+    std::cout << "Couldn't open " << geojson_file_name << std::endl;
+    return false;
+  }
+
+  std::ofstream out_stream(geojson_seq_file_name);
+  if (!out_stream)
+  {
+    std::cout << "Couldn't open " << geojson_seq_file_name << std::endl;
+    return false;
+  }
+
+  FeatureLineWriter handler(out_stream);
+  rapidjson::Reader reader;
+  rapidjson::IStreamWrapper stream_wrapper(in_stream);
+  if (!reader.Parse<rapidjson::kParseNumbersAsStringsFlag>(stream_wrapper, handler) || !handler.found_features())
+  {
+    std::cout << "Failed to convert " << geojson_file_name << std::endl;
+    return false;
+  }
+
+  return static_cast<bool>(out_stream);
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <istream>
+#include <optional>
+#include <rapidjson/document.h>
+#include <string>
+#include <vector>
+
+#include "dida/polygon2.hpp"
+
+using namespace dida;
+
+/// Reads polygons from a GeoJSONSeq (RFC 8142) stream, in which each line holds a single GeoJSON Feature.
+///
+/// Unlike @c CountriesGeoJson::read_from_file, the reader never holds more than one feature in memory, and all polygons
+/// are decoded into the same vertex buffer, so the memory usage is bounded by the size of the largest feature rather
+/// than by the size of the stream. The polygon returned by the accessors is only valid until the next call to @c next.
+///
+/// Consecutive duplicate vertices are removed and all rings, including holes, are made counter clockwise, but the rings
+/// are not otherwise validated, since constructing a @c Polygon2 would require giving up the shared vertex buffer.
+class GeoJsonSeqReader
+{
+public:
+  /// Creates a reader which reads from @c stream, and takes the name of each feature from the @c name_property
+  /// property. The stream must outlive the reader.
+  explicit GeoJsonSeqReader(std::istream& stream, std::string name_property = "ADMIN");
+
+  /// Advances to the next polygon, which is either a GeoJSON Polygon, or one part of a GeoJSON MultiPolygon. Returns
+  /// false once the end of the stream is reached.
+  bool next();
+
+  /// Returns the name of the feature the current polygon belongs to.
+  const std::string& name() const;
+
+  /// Returns the number of rings of the current polygon. The first ring is the outer boundary, the remaining rings are
+  /// holes.
+  size_t num_rings() const;
+
+  /// Returns the ring with the given index of the current polygon.
+  ArrayView<const Point2> ring(size_t index) const;
+
+  /// Returns the total number of vertices of all rings of the current polygon.
+  size_t num_vertices() const;
+
+  /// Returns the number of features read so far.
+  size_t num_features() const;
+
+private:
+  bool read_feature();
+
+  bool decode_polygon(const rapidjson::Value& rings_json);
+
+  bool decode_ring(const rapidjson::Value& ring_json);
+
+  std::istream* stream_;
+  std::string name_property_;
+
+  /// The current line, and the document it was parsed into. Both are reused from feature to feature.
+  std::string line_;
+  rapidjson::Document document_;
+
+  /// The coordinates of the geometry of the current feature, and the range of parts which still have to be visited.
+  const rapidjson::Value* coordinates_ = nullptr;
+  bool is_multi_polygon_ = false;
+  rapidjson::SizeType next_part_ = 0;
+  rapidjson::SizeType num_parts_ = 0;
+
+  std::string name_;
+
+  /// The vertices of all rings of the current polygon, and the end offset of each ring.
+  std::vector<Point2> vertices_;
+  std::vector<size_t> ring_ends_;
+
+  size_t num_features_ = 0;
+};
+
+/// Converts the GeoJSON FeatureCollection in @c geojson_file_name to a GeoJSONSeq file with one feature per line.
+/// Returns false if the input couldn't be read or parsed, or the output couldn't be written.
+bool convert_geojson_to_geojson_seq(const std::string& geojson_file_name, const std::string& geojson_seq_file_name);
@@ -31,7 +31,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
-#include "tesselator.h"
+#include "tessnames.h"
 
 //#define CHECK_BOUNDS
 
@@ -53,26 +53,13 @@ struct BucketAlloc
 	TESSalloc* alloc;
 };
 
-static int CreateBucket( struct BucketAlloc* ba )
+static void AddBucketItems( struct BucketAlloc* ba, Bucket* bucket )
 {
-	size_t size;
-	Bucket* bucket;
 	void* freelist;
 	unsigned char* head;
 	unsigned char* it;
 
-	// Allocate memory for the bucket
-	size = sizeof(Bucket) + ba->itemSize * ba->bucketSize;
-	bucket = (Bucket*)ba->alloc->memalloc( ba->alloc->userData, size );
-	if ( !bucket )
-		return 0;
-	bucket->next = 0;
-
-	// Add the bucket into the list of buckets.
-	bucket->next = ba->buckets;
-	ba->buckets = bucket;
-
-	// Add new items to the free list.
+	// Add the items of the bucket to the free list.
 	freelist = ba->freelist;
 	head = (unsigned char*)bucket + sizeof(Bucket);
 	it = head + ba->itemSize * ba->bucketSize;
@@ -87,6 +74,25 @@ static int CreateBucket( struct BucketAlloc* ba )
 	while ( it != head );
 	// Update pointer to next location containing a free item.
 	ba->freelist = (void*)it;
+}
+
+static int CreateBucket( struct BucketAlloc* ba )
+{
+	size_t size;
+	Bucket* bucket;
+
+	// Allocate memory for the bucket
+	size = sizeof(Bucket) + ba->itemSize * ba->bucketSize;
+	bucket = (Bucket*)ba->alloc->memalloc( ba->alloc->userData, size );
+	if ( !bucket )
+		return 0;
+	bucket->next = 0;
+
+	// Add the bucket into the list of buckets.
+	bucket->next = ba->buckets;
+	ba->buckets = bucket;
+
+	AddBucketItems( ba, bucket );
 
 	return 1;
 }
@@ -174,6 +180,40 @@ void bucketFree( struct BucketAlloc *ba, void *ptr )
 #endif
 }
 
+void bucketReset( struct BucketAlloc *ba, unsigned int maxItems )
+{
+	TESSalloc* alloc = ba->alloc;
+	unsigned int maxBuckets = (maxItems + ba->bucketSize - 1) / ba->bucketSize;
+	unsigned int numBuckets = 0;
+	Bucket *bucket = ba->buckets;
+	Bucket *next;
+
+	// Always keep one bucket, createBucketAlloc() starts with one too.
+	if ( maxBuckets < 1 )
+		maxBuckets = 1;
+
+	// Release the buckets beyond the limit, and put all items of the
+	// remaining buckets back on the free list.
+	ba->freelist = 0;
+	ba->buckets = 0;
+	while ( bucket )
+	{
+		next = bucket->next;
+		if ( numBuckets < maxBuckets )
+		{
+			bucket->next = ba->buckets;
+			ba->buckets = bucket;
+			AddBucketItems( ba, bucket );
+			numBuckets++;
+		}
+		else
+		{
+			alloc->memfree( alloc->userData, bucket );
+		}
+		bucket = next;
+	}
+}
+
 void deleteBucketAlloc( struct BucketAlloc *ba )
 {
 	TESSalloc* alloc = ba->alloc;
@@ -36,12 +36,17 @@
 extern "C" {
 #endif
 
-#include "tesselator.h"
+#include "tessnames.h"
 	
 struct BucketAlloc *createBucketAlloc( TESSalloc* alloc, const char *name,
 									  unsigned int itemSize, unsigned int bucketSize );
 void *bucketAlloc( struct BucketAlloc *ba);
 void bucketFree( struct BucketAlloc *ba, void *ptr );
+/* Frees all items at once, so that the allocator can be reused without
+* giving its buckets back to the system.  At most enough buckets to hold
+* maxItems items are kept, the rest are released.
+*/
+void bucketReset( struct BucketAlloc *ba, unsigned int maxItems );
 void deleteBucketAlloc( struct BucketAlloc *ba );
 
 #ifdef __cplusplus
@@ -34,20 +34,69 @@
 #include "bucketalloc.h"
 #include "dict.h"
 
+#define NEXT(n,l)	(*((l) == 0 ? &(n)->next : &(n)->up[2*((l)-1)]))
+#define PREV(n,l)	(*((l) == 0 ? &(n)->prev : &(n)->up[2*((l)-1)+1]))
+
+static unsigned int nodeSize( int height )
+{
+	int numUp = height > 1 ? 2*(height-1) : 1;
+	return (unsigned int)(offsetof( DictNode, up ) + numUp * sizeof(DictNode *));
+}
+
+/* Picks the height of a new node, where each level is used by a quarter
+* of the nodes of the level below it.  The generator is a xorshift, which
+* keeps the tesselation deterministic and independent of rand().
+*/
+static int randomHeight( Dict *dict )
+{
+	unsigned int x = dict->seed;
+	int height = 1;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	dict->seed = x;
+
+	while( height < DICT_MAX_LEVEL && (x & 3) == 0 ) {
+		height++;
+		x >>= 2;
+	}
+	return height;
+}
+
+static void InitHead( Dict *dict )
+{
+	DictNode *head = dict->head;
+	int l;
+
+	for( l = 0; l < DICT_MAX_LEVEL; ++l ) {
+		NEXT(head, l) = head;
+		PREV(head, l) = head;
+	}
+	dict->level = 1;
+	dict->seed = 0x9e3779b9;
+}
+
 /* really tessDictListNewDict */
 Dict *dictNewDict( TESSalloc* alloc, void *frame, int (*leq)(void *frame, DictKey key1, DictKey key2) )
 {
 	Dict *dict = (Dict *)alloc->memalloc( alloc->userData, sizeof( Dict ));
 	DictNode *head;
+	int l;
 
 	if (dict == NULL) return NULL;
 
-	head = &dict->head;
+	head = (DictNode *)alloc->memalloc( alloc->userData, nodeSize( DICT_MAX_LEVEL ));
+	if (head == NULL) {
+		alloc->memfree( alloc->userData, dict );
+		return NULL;
+	}
 
 	head->key = NULL;
-	head->next = head;
-	head->prev = head;
+	head->height = DICT_MAX_LEVEL;
 
+	dict->head = head;
+	InitHead( dict );
 	dict->frame = frame;
 	dict->leq = leq;
 
@@ -55,35 +104,97 @@ Dict *dictNewDict( TESSalloc* alloc, void *frame, int (*leq)(void *frame, DictKe
 		alloc->dictNodeBucketSize = 16;
 	if (alloc->dictNodeBucketSize > 4096)
 		alloc->dictNodeBucketSize = 4096;
-	dict->nodePool = createBucketAlloc( alloc, "Dict", sizeof(DictNode), alloc->dictNodeBucketSize );
+
+	/* The pool for each node height is created when the first node of that
+	* height is inserted, since small inputs never reach the taller heights.
+	*/
+	dict->alloc = alloc;
+	for( l = 0; l < DICT_MAX_LEVEL; ++l )
+		dict->nodePools[l] = NULL;
 
 	return dict;
 }
 
+/* NodePool( dict, height ) returns the allocator for nodes of the given
+* height, creating it if needed.  Returns NULL if out of memory.
+*/
+static struct BucketAlloc *NodePool( Dict *dict, int height )
+{
+	unsigned int bucketSize;
+
+	if (dict->nodePools[height-1] != NULL)
+		return dict->nodePools[height-1];
+
+	/* Each level holds a quarter of the nodes of the level below it, so the
+	* buckets of the taller nodes can be correspondingly smaller.
+	*/
+	bucketSize = (unsigned int)dict->alloc->dictNodeBucketSize >> (2*(height-1));
+	if (bucketSize < 16)
+		bucketSize = 16;
+	dict->nodePools[height-1] = createBucketAlloc( dict->alloc, "Dict", nodeSize( height ), bucketSize );
+	return dict->nodePools[height-1];
+}
+
 /* really tessDictListDeleteDict */
 void dictDeleteDict( TESSalloc* alloc, Dict *dict )
 {
-	deleteBucketAlloc( dict->nodePool );
+	int l;
+
+	for( l = 0; l < DICT_MAX_LEVEL; ++l ) {
+		if (dict->nodePools[l] != NULL)
+			deleteBucketAlloc( dict->nodePools[l] );
+	}
+	alloc->memfree( alloc->userData, dict->head );
 	alloc->memfree( alloc->userData, dict );
 }
 
+void dictReset( Dict *dict, unsigned int maxItems )
+{
+	int l;
+
+	for( l = 0; l < DICT_MAX_LEVEL; ++l ) {
+		if (dict->nodePools[l] != NULL)
+			bucketReset( dict->nodePools[l], maxItems );
+	}
+	InitHead( dict );
+}
+
 /* really tessDictListInsertBefore */
 DictNode *dictInsertBefore( Dict *dict, DictNode *node, DictKey key )
 {
+	struct BucketAlloc *pool;
 	DictNode *newNode;
+	int height, l;
 
 	do {
 		node = node->prev;
 	} while( node->key != NULL && ! (*dict->leq)(dict->frame, node->key, key));
 
-	newNode = (DictNode *)bucketAlloc( dict->nodePool );
+	height = randomHeight( dict );
+	pool = NodePool( dict, height );
+	if (pool == NULL) return NULL;
+	newNode = (DictNode *)bucketAlloc( pool );
 	if (newNode == NULL) return NULL;
 
 	newNode->key = key;
-	newNode->next = node->next;
-	node->next->prev = newNode;
-	newNode->prev = node;
-	node->next = newNode;
+	newNode->height = height;
+	if (height > dict->level)
+		dict->level = height;
+
+	/* node is the predecessor at level 0.  The predecessor at level l is the
+	* first node of height > l found walking back from the predecessor at
+	* level l-1, which takes a constant number of steps on average.
+	*/
+	for( l = 0; l < height; ++l ) {
+		if (l > 0) {
+			while( node->height <= l )
+				node = PREV(node, l-1);
+		}
+		NEXT(newNode, l) = NEXT(node, l);
+		PREV(NEXT(node, l), l) = newNode;
+		PREV(newNode, l) = node;
+		NEXT(node, l) = newNode;
+	}
 
 	return newNode;
 }
@@ -91,19 +202,37 @@ DictNode *dictInsertBefore( Dict *dict, DictNode *node, DictKey key )
 /* really tessDictListDelete */
 void dictDelete( Dict *dict, DictNode *node ) /*ARGSUSED*/
 {
-	node->next->prev = node->prev;
-	node->prev->next = node->next;
-	bucketFree( dict->nodePool, node );
+	int l;
+
+	for( l = 0; l < node->height; ++l ) {
+		PREV(NEXT(node, l), l) = PREV(node, l);
+		NEXT(PREV(node, l), l) = NEXT(node, l);
+	}
+	bucketFree( dict->nodePools[node->height-1], node );
 }
 
 /* really tessDictListSearch */
 DictNode *dictSearch( Dict *dict, DictKey key )
 {
-	DictNode *node = &dict->head;
+	DictNode *node = dict->head;
+	DictNode *next;
+	int l;
+
+	/* Skip ahead over the nodes whose keys are less than the given key on
+	* the sparser levels, then finish with the same walk as before.
+	*/
+	for( l = dict->level-1; l > 0; --l ) {
+		for( ;; ) {
+			next = NEXT(node, l);
+			if (next->key == NULL || (*dict->leq)(dict->frame, key, next->key))
+				break;
+			node = next;
+		}
+	}
 
 	do {
 		node = node->next;
 	} while( node->key != NULL && ! (*dict->leq)(dict->frame, key, node->key));
 
 	return node;
-}
\ No newline at end of file
+}
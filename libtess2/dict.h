@@ -32,6 +32,8 @@
 #ifndef DICT_LIST_H
 #define DICT_LIST_H
 
+#include "tessnames.h"
+
 typedef void *DictKey;
 typedef struct Dict Dict;
 typedef struct DictNode DictNode;
@@ -40,6 +42,11 @@ Dict *dictNewDict( TESSalloc* alloc, void *frame, int (*leq)(void *frame, DictKe
 
 void dictDeleteDict( TESSalloc* alloc, Dict *dict );
 
+/* Reset empties the dictionary, keeping storage for at most maxItems
+* nodes of each height for reuse.
+*/
+void dictReset( Dict *dict, unsigned int maxItems );
+
 /* Search returns the node with the smallest key greater than or equal
 * to the given key.  If there is no such key, returns a node whose
 * key is NULL.  Similarly, Succ(Max(d)) has a NULL key, etc.
@@ -51,23 +58,40 @@ void dictDelete( Dict *dict, DictNode *node );
 #define dictKey(n)	((n)->key)
 #define dictSucc(n)	((n)->next)
 #define dictPred(n)	((n)->prev)
-#define dictMin(d)	((d)->head.next)
-#define dictMax(d)	((d)->head.prev)
-#define dictInsert(d,k) (dictInsertBefore((d),&(d)->head,(k)))
+#define dictMin(d)	((d)->head->next)
+#define dictMax(d)	((d)->head->prev)
+#define dictInsert(d,k) (dictInsertBefore((d),(d)->head,(k)))
 
 
 /*** Private data structures ***/
 
+/* The dictionary is a skip list.  Level 0 is the doubly linked list of
+* all nodes, which is what dictSucc and dictPred walk.  A node of height h
+* is also linked into levels 1 .. h-1, which let dictSearch skip ahead in
+* O(log n) expected time.  Each level is doubly linked as well, so that
+* nodes can be inserted next to a known node and deleted without a search.
+*/
+#define DICT_MAX_LEVEL	12
+
 struct DictNode {
 	DictKey	key;
 	DictNode *next;
 	DictNode *prev;
+	int height;
+	/* Links for levels 1 .. height-1: up[2*(l-1)] is the next node and
+	* up[2*(l-1)+1] the previous node at level l.  Nodes are allocated
+	* with room for exactly as many links as their height needs.
+	*/
+	DictNode *up[1];
 };
 
 struct Dict {
-	DictNode head;
+	DictNode *head;
+	int level;
+	unsigned int seed;
 	void *frame;
-	struct BucketAlloc *nodePool;
+	TESSalloc *alloc;
+	struct BucketAlloc *nodePools[DICT_MAX_LEVEL];	/* NULL until a node of that height is inserted */
 	int (*leq)(void *frame, DictKey key1, DictKey key2);
 };
 
@@ -34,6 +34,7 @@
 #include "mesh.h"
 #include "geom.h"
 #include <math.h>
+#include <string.h>
 
 int tesvertLeq( TESSvertex *u, TESSvertex *v )
 {
@@ -72,12 +73,51 @@ TESSreal tesedgeEval( TESSvertex *u, TESSvertex *v, TESSvertex *w )
 	return 0;
 }
 
+#ifdef TESS_USE_FIXED
+
+/* The coordinates are integers of at most TESS_FIXED_MAX in magnitude, and
+* the sentinels lie one unit further out, so the difference of two
+* coordinates fits in 32 bits, and the product of two differences in 63.
+*/
+typedef long long TESSfixed;
+
+/* Returns a*b + c*d, with the exact sign.  The sum itself may overflow
+* when both products have the same sign, so it's only evaluated in integer
+* arithmetic when they don't.
+*/
+static TESSreal SumOfProducts( TESSfixed a, TESSfixed b, TESSfixed c, TESSfixed d )
+{
+	TESSfixed p = a * b;
+	TESSfixed q = c * d;
+
+	if( (p < 0) != (q < 0) ) {
+		return (TESSreal)(p + q);
+	}
+	return (TESSreal)p + (TESSreal)q;
+}
+
+#endif
+
 TESSreal tesedgeSign( TESSvertex *u, TESSvertex *v, TESSvertex *w )
 {
 	/* Returns a number whose sign matches EdgeEval(u,v,w) but which
 	* is cheaper to evaluate.  Returns > 0, == 0 , or < 0
 	* as v is above, on, or below the edge uw.
 	*/
+#ifdef TESS_USE_FIXED
+	TESSfixed gapL, gapR;
+
+	assert( VertLeq( u, v ) && VertLeq( v, w ));
+
+	gapL = (TESSfixed)v->s - (TESSfixed)u->s;
+	gapR = (TESSfixed)w->s - (TESSfixed)v->s;
+
+	if( gapL + gapR > 0 ) {
+		return SumOfProducts( (TESSfixed)v->t - (TESSfixed)w->t, gapL, (TESSfixed)v->t - (TESSfixed)u->t, gapR );
+	}
+	/* vertical line */
+	return 0;
+#else
 	TESSreal gapL, gapR;
 
 	assert( VertLeq( u, v ) && VertLeq( v, w ));
@@ -90,6 +130,7 @@ TESSreal tesedgeSign( TESSvertex *u, TESSvertex *v, TESSvertex *w )
 	}
 	/* vertical line */
 	return 0;
+#endif
 }
 
 
@@ -133,6 +174,20 @@ TESSreal testransSign( TESSvertex *u, TESSvertex *v, TESSvertex *w )
 	* is cheaper to evaluate.  Returns > 0, == 0 , or < 0
 	* as v is above, on, or below the edge uw.
 	*/
+#ifdef TESS_USE_FIXED
+	TESSfixed gapL, gapR;
+
+	assert( TransLeq( u, v ) && TransLeq( v, w ));
+
+	gapL = (TESSfixed)v->t - (TESSfixed)u->t;
+	gapR = (TESSfixed)w->t - (TESSfixed)v->t;
+
+	if( gapL + gapR > 0 ) {
+		return SumOfProducts( (TESSfixed)v->s - (TESSfixed)w->s, gapL, (TESSfixed)v->s - (TESSfixed)u->s, gapR );
+	}
+	/* vertical line */
+	return 0;
+#else
 	TESSreal gapL, gapR;
 
 	assert( TransLeq( u, v ) && TransLeq( v, w ));
@@ -145,6 +200,7 @@ TESSreal testransSign( TESSvertex *u, TESSvertex *v, TESSvertex *w )
 	}
 	/* vertical line */
 	return 0;
+#endif
 }
 
 
@@ -156,7 +212,13 @@ int tesvertCCW( TESSvertex *u, TESSvertex *v, TESSvertex *w )
 	* on some degenerate inputs, so the client must have some way to
 	* handle this situation.
 	*/
+#ifdef TESS_USE_FIXED
+	/* The fixed point build evaluates it without rounding errors. */
+	return SumOfProducts( (TESSfixed)v->s - (TESSfixed)u->s, (TESSfixed)w->t - (TESSfixed)u->t,
+						  (TESSfixed)u->t - (TESSfixed)v->t, (TESSfixed)w->s - (TESSfixed)u->s ) >= 0;
+#else
 	return (u->s*(v->t - w->t) + v->s*(w->t - u->t) + w->s*(u->t - v->t)) >= 0;
+#endif
 }
 
 /* Given parameters a,x,b,y returns the value (b*x+a*y)/(a+b),
@@ -259,35 +321,256 @@ void tesedgeIntersect( TESSvertex *o1, TESSvertex *d1,
 		if( z1+z2 < 0 ) { z1 = -z1; z2 = -z2; }
 		v->t = Interpolate( z1, o2->t, z2, d2->t );
 	}
+
+	/* Rounding to the grid keeps the point inside the bounding rectangles,
+	* since their corners lie on the grid too.
+	*/
+	v->s = SnapToGrid( v->s );
+	v->t = SnapToGrid( v->t );
 }
 
-TESSreal inCircle( TESSvertex *v, TESSvertex *v0, TESSvertex *v1, TESSvertex *v2 ) {
-	TESSreal adx, ady, bdx, bdy, cdx, cdy;
-	TESSreal abdet, bcdet, cadet;
-	TESSreal alift, blift, clift;
+/*
+	Exact arithmetic for the in-circle test, after Shewchuk, "Adaptive Precision
+	Floating-Point Arithmetic and Fast Robust Geometric Predicates".  A number is
+	kept as an expansion: an array of doubles of increasing magnitude whose exact
+	sum is its value.  TESSreal coordinates convert to double without rounding,
+	so the expansions below hold the determinant exactly.
+*/
+
+#define EXACT_SPLITTER		134217729.0				/* 2^27 + 1 */
+#define EXACT_EPSILON		1.1102230246251565e-16	/* 2^-53 */
+#define INCIRCLE_ERRBOUND	((10.0 + 96.0 * EXACT_EPSILON) * EXACT_EPSILON)
 
-	adx = v0->s - v->s;
-	ady = v0->t - v->t;
-	bdx = v1->s - v->s;
-	bdy = v1->t - v->t;
-	cdx = v2->s - v->s;
-	cdy = v2->t - v->t;
+/* Sizes of the scratch expansions of InCircleExact(). */
+#define EXACT_MAX_FACTOR	16
+#define EXACT_MAX_PRODUCT	(2 * EXACT_MAX_FACTOR * EXACT_MAX_FACTOR)
+
+static void FastTwoSum( double a, double b, double *x, double *y )
+{
+	*x = a + b;
+	*y = b - (*x - a);
+}
 
-	abdet = adx * bdy - bdx * ady;
-	bcdet = bdx * cdy - cdx * bdy;
-	cadet = cdx * ady - adx * cdy;
+static void TwoSum( double a, double b, double *x, double *y )
+{
+	double bv, av;
+
+	*x = a + b;
+	bv = *x - a;
+	av = *x - bv;
+	*y = (a - av) + (b - bv);
+}
+
+static void TwoDiff( double a, double b, double *x, double *y )
+{
+	double bv, av;
+
+	*x = a - b;
+	bv = a - *x;
+	av = *x + bv;
+	*y = (a - av) + (bv - b);
+}
+
+static void Split( double a, double *hi, double *lo )
+{
+	double c = EXACT_SPLITTER * a;
+
+	*hi = c - (c - a);
+	*lo = a - *hi;
+}
+
+static void TwoProduct( double a, double b, double *x, double *y )
+{
+	double ahi, alo, bhi, blo, err;
+
+	*x = a * b;
+	Split( a, &ahi, &alo );
+	Split( b, &bhi, &blo );
+	err = *x - ahi * bhi - alo * bhi - ahi * blo;
+	*y = alo * blo - err;
+}
+
+/* h = e * b, with zero components removed.  h has room for 2 * elen items. */
+static int ScaleExpansion( int elen, const double *e, double b, double *h )
+{
+	double q, sum, hh, product1, product0;
+	int i, hlen = 0;
+
+	TwoProduct( e[0], b, &q, &hh );
+	if( hh != 0 ) h[hlen++] = hh;
+	for( i = 1; i < elen; i++ ) {
+		TwoProduct( e[i], b, &product1, &product0 );
+		TwoSum( q, product0, &sum, &hh );
+		if( hh != 0 ) h[hlen++] = hh;
+		FastTwoSum( product1, sum, &q, &hh );
+		if( hh != 0 ) h[hlen++] = hh;
+	}
+	if( q != 0 || hlen == 0 ) h[hlen++] = q;
+	return hlen;
+}
+
+/* h = e + f, with zero components removed.  h has room for elen + flen items. */
+static int SumExpansions( int elen, const double *e, int flen, const double *f, double *h )
+{
+	double q, qNew, hh;
+	int ei = 0, fi = 0, hlen = 0;
+
+	/* Merge the components by magnitude, carrying the running sum in q. */
+	if( (f[0] > e[0]) == (f[0] > -e[0]) )
+		q = e[ei++];
+	else
+		q = f[fi++];
+	if( ei < elen && fi < flen ) {
+		if( (f[fi] > e[ei]) == (f[fi] > -e[ei]) )
+			FastTwoSum( e[ei++], q, &qNew, &hh );
+		else
+			FastTwoSum( f[fi++], q, &qNew, &hh );
+		q = qNew;
+		if( hh != 0 ) h[hlen++] = hh;
+		while( ei < elen && fi < flen ) {
+			if( (f[fi] > e[ei]) == (f[fi] > -e[ei]) )
+				TwoSum( q, e[ei++], &qNew, &hh );
+			else
+				TwoSum( q, f[fi++], &qNew, &hh );
+			q = qNew;
+			if( hh != 0 ) h[hlen++] = hh;
+		}
+	}
+	while( ei < elen ) {
+		TwoSum( q, e[ei++], &qNew, &hh );
+		q = qNew;
+		if( hh != 0 ) h[hlen++] = hh;
+	}
+	while( fi < flen ) {
+		TwoSum( q, f[fi++], &qNew, &hh );
+		q = qNew;
+		if( hh != 0 ) h[hlen++] = hh;
+	}
+	if( q != 0 || hlen == 0 ) h[hlen++] = q;
+	return hlen;
+}
+
+/* h = e * f.  elen is at most EXACT_MAX_FACTOR, h has room for 2 * elen * flen items. */
+static int MultiplyExpansions( int elen, const double *e, int flen, const double *f, double *h )
+{
+	double part[2 * EXACT_MAX_FACTOR], sum[EXACT_MAX_PRODUCT];
+	int i, n, hlen, plen;
+
+	hlen = ScaleExpansion( elen, e, f[0], h );
+	for( i = 1; i < flen; i++ ) {
+		plen = ScaleExpansion( elen, e, f[i], part );
+		n = SumExpansions( hlen, h, plen, part, sum );
+		memcpy( h, sum, sizeof(double) * (unsigned int)n );
+		hlen = n;
+	}
+	return hlen;
+}
+
+/* h = ax * by - bx * ay for two-component expansions. */
+static int CrossExpansions( const double *ax, const double *ay, const double *bx, const double *by, double *h )
+{
+	double p[8], q[8];
+	int plen, qlen, i;
+
+	plen = MultiplyExpansions( 2, ax, 2, by, p );
+	qlen = MultiplyExpansions( 2, bx, 2, ay, q );
+	for( i = 0; i < qlen; i++ )
+		q[i] = -q[i];
+	return SumExpansions( plen, p, qlen, q, h );
+}
+
+/* h = x * x + y * y for two-component expansions. */
+static int LiftExpansions( const double *x, const double *y, double *h )
+{
+	double p[8], q[8];
+	int plen, qlen;
+
+	plen = MultiplyExpansions( 2, x, 2, x, p );
+	qlen = MultiplyExpansions( 2, y, 2, y, q );
+	return SumExpansions( plen, p, qlen, q, h );
+}
+
+/* Evaluates the in-circle determinant exactly, and returns its most
+* significant component, which has the sign of the determinant.
+*/
+static double InCircleExact( TESSvertex *v, TESSvertex *v0, TESSvertex *v1, TESSvertex *v2 )
+{
+	double d[3][2][2];	/* exact differences (v_i - v), per vertex and axis */
+	double det[EXACT_MAX_FACTOR], lift[EXACT_MAX_FACTOR], term[EXACT_MAX_PRODUCT];
+	double sum[2][3 * EXACT_MAX_PRODUCT];
+	TESSvertex *p[3];
+	int i, a, b, detlen, liftlen, termlen, sumlen = 0;
+
+	p[0] = v0; p[1] = v1; p[2] = v2;
+	for( i = 0; i < 3; i++ ) {
+		TwoDiff( (double)p[i]->s, (double)v->s, &d[i][0][1], &d[i][0][0] );
+		TwoDiff( (double)p[i]->t, (double)v->t, &d[i][1][1], &d[i][1][0] );
+	}
+
+	/* Sum lift(i) * cross(i+1, i+2) over the three vertices. */
+	for( i = 0; i < 3; i++ ) {
+		a = (i + 1) % 3;
+		b = (i + 2) % 3;
+		detlen = CrossExpansions( d[a][0], d[a][1], d[b][0], d[b][1], det );
+		liftlen = LiftExpansions( d[i][0], d[i][1], lift );
+		termlen = MultiplyExpansions( liftlen, lift, detlen, det, term );
+		if( i == 0 ) {
+			memcpy( sum[0], term, sizeof(double) * (unsigned int)termlen );
+			sumlen = termlen;
+		} else {
+			sumlen = SumExpansions( sumlen, sum[(i + 1) & 1], termlen, term, sum[i & 1] );
+		}
+	}
+	return sum[0][sumlen - 1];
+}
+
+/* Returns a value with the sign of the in-circle determinant: positive if v
+* lies inside the circle through v0, v1, v2 (in counter clockwise order),
+* negative if it lies outside, zero if the four are cocircular.  The
+* determinant is first evaluated in double precision; only when it is within
+* the rounding error bound of zero is it recomputed exactly.
+*/
+double inCircle( TESSvertex *v, TESSvertex *v0, TESSvertex *v1, TESSvertex *v2 ) {
+	double adx, ady, bdx, bdy, cdx, cdy;
+	double bdxcdy, cdxbdy, cdxady, adxcdy, adxbdy, bdxady;
+	double alift, blift, clift;
+	double det, permanent;
+
+	adx = (double)v0->s - (double)v->s;
+	ady = (double)v0->t - (double)v->t;
+	bdx = (double)v1->s - (double)v->s;
+	bdy = (double)v1->t - (double)v->t;
+	cdx = (double)v2->s - (double)v->s;
+	cdy = (double)v2->t - (double)v->t;
+
+	bdxcdy = bdx * cdy;
+	cdxbdy = cdx * bdy;
+	cdxady = cdx * ady;
+	adxcdy = adx * cdy;
+	adxbdy = adx * bdy;
+	bdxady = bdx * ady;
 
 	alift = adx * adx + ady * ady;
 	blift = bdx * bdx + bdy * bdy;
 	clift = cdx * cdx + cdy * cdy;
 
-	return alift * bcdet + blift * cadet + clift * abdet;
+	det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+
+	permanent = (fabs(bdxcdy) + fabs(cdxbdy)) * alift
+			  + (fabs(cdxady) + fabs(adxcdy)) * blift
+			  + (fabs(adxbdy) + fabs(bdxady)) * clift;
+	if( det > INCIRCLE_ERRBOUND * permanent || -det > INCIRCLE_ERRBOUND * permanent )
+		return det;
+
+	return InCircleExact( v, v0, v1, v2 );
 }
 
 /*
-	Returns 1 is edge is locally delaunay
+	Returns 1 is edge is locally delaunay.  Cocircular quads count as
+	Delaunay, so that they are not flipped back and forth.
  */
-int tesedgeIsLocallyDelaunay( TESShalfEdge *e )
+int tesedgeIsLocallyDelaunay( TESSmesh *mesh, TESShalfEdge e )
 {
-	return inCircle(e->Sym->Lnext->Lnext->Org, e->Lnext->Org, e->Lnext->Lnext->Org, e->Org) < 0;
+	return inCircle(Org(mesh, Lnext(mesh, Lnext(mesh, Sym(e)))), Org(mesh, Lnext(mesh, e)),
+					Org(mesh, Lnext(mesh, Lnext(mesh, e))), Org(mesh, e)) <= 0;
 }
\ No newline at end of file
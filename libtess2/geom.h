@@ -57,15 +57,22 @@
 #define TransSign(u,v,w) testransSign(u,v,w)
 
 
-#define EdgeGoesLeft(e) VertLeq( (e)->Dst, (e)->Org )
-#define EdgeGoesRight(e) VertLeq( (e)->Org, (e)->Dst )
-#define EdgeIsInternal(e) e->Rface && e->Rface->inside
+#define EdgeGoesLeft(m,e) VertLeq( Dst(m,e), Org(m,e) )
+#define EdgeGoesRight(m,e) VertLeq( Org(m,e), Dst(m,e) )
+#define EdgeIsInternal(m,e) (Rface(m,e) && Rface(m,e)->inside)
 
 #define ABS(x) ((x) < 0 ? -(x) : (x))
 #define VertL1dist(u,v) (ABS(u->s - v->s) + ABS(u->t - v->t))
 
 #define VertCCW(u,v,w) tesvertCCW(u,v,w)
 
+/* In the fixed point build all coordinates lie on the integer grid. */
+#ifdef TESS_USE_FIXED
+#define SnapToGrid(x)	((TESSreal)floor( (x) + (TESSreal)0.5 ))
+#else
+#define SnapToGrid(x)	(x)
+#endif
+
 int tesvertLeq( TESSvertex *u, TESSvertex *v );
 TESSreal	tesedgeEval( TESSvertex *u, TESSvertex *v, TESSvertex *w );
 TESSreal	tesedgeSign( TESSvertex *u, TESSvertex *v, TESSvertex *w );
@@ -73,6 +80,6 @@ TESSreal	testransEval( TESSvertex *u, TESSvertex *v, TESSvertex *w );
 TESSreal	testransSign( TESSvertex *u, TESSvertex *v, TESSvertex *w );
 int tesvertCCW( TESSvertex *u, TESSvertex *v, TESSvertex *w );
 void tesedgeIntersect( TESSvertex *o1, TESSvertex *d1, TESSvertex *o2, TESSvertex *d2, TESSvertex *v );
-int tesedgeIsLocallyDelaunay( TESShalfEdge *e );
+int tesedgeIsLocallyDelaunay( TESSmesh *mesh, TESShalfEdge e );
 
 #endif
\ No newline at end of file
@@ -29,8 +29,10 @@
 ** Author: Eric Veach, July 1994.
 */
 
+
 //#include "tesos.h"
 #include <stddef.h>
+#include <string.h>
 #include <assert.h>
 #include "mesh.h"
 #include "geom.h"
@@ -41,55 +43,143 @@
 
 /************************ Utility Routines ************************/
 
-/* Allocate and free half-edges in pairs for efficiency.
-* The *only* place that should use this fact is allocation/free.
+/* ResizeArray( alloc, p, oldSize, newSize ) changes the size of one of the
+* half-edge arrays, keeping its contents.  Returns NULL if out of memory,
+* in which case p is still valid.
+*/
+static void *ResizeArray( TESSalloc *alloc, void *p, unsigned int oldSize, unsigned int newSize )
+{
+	void *q;
+
+	if( p != NULL && alloc->memrealloc != NULL ) {
+		return alloc->memrealloc( alloc->userData, p, newSize );
+	}
+	q = alloc->memalloc( alloc->userData, newSize );
+	if( q != NULL && p != NULL ) {
+		memcpy( q, p, oldSize < newSize ? oldSize : newSize );
+		alloc->memfree( alloc->userData, p );
+	}
+	return q;
+}
+
+/* ResizeEdges( mesh, capacity ) makes room for "capacity" half-edges.
+* Returns 0 if out of memory.  The arrays which could be resized are
+* kept, since an array which is longer than mesh->edgeCapacity is fine.
+*/
+static int ResizeEdges( TESSmesh *mesh, TESShalfEdge capacity )
+{
+	TESShalfEdge oldCapacity = mesh->edgeCapacity;
+	void *p;
+	int ok = TRUE;
+
+	/* The sizes of the arrays must fit in an unsigned int */
+	if( capacity > (~0u) / sizeof(void *) ) return 0;
+
+#define RESIZE_EDGE_ARRAY( field, type ) \
+	p = ResizeArray( mesh->alloc, mesh->field, (unsigned int)(oldCapacity * sizeof(type)), \
+					 (unsigned int)(capacity * sizeof(type)) ); \
+	if( p != NULL ) mesh->field = (type *)p; else ok = FALSE;
+
+	RESIZE_EDGE_ARRAY( eNext, TESShalfEdge )
+	RESIZE_EDGE_ARRAY( eOnext, TESShalfEdge )
+	RESIZE_EDGE_ARRAY( eLnext, TESShalfEdge )
+	RESIZE_EDGE_ARRAY( eOrg, TESSvertex * )
+	RESIZE_EDGE_ARRAY( eLface, TESSface * )
+	RESIZE_EDGE_ARRAY( eRegion, ActiveRegion * )
+	RESIZE_EDGE_ARRAY( eWinding, int )
+	RESIZE_EDGE_ARRAY( eMark, unsigned char )
+
+#undef RESIZE_EDGE_ARRAY
+
+	/* When shrinking, the arrays which failed to shrink are merely too long. */
+	if( ok || capacity < oldCapacity ) {
+		mesh->edgeCapacity = capacity;
+	}
+	return ok;
+}
+
+/* GrowEdges( mesh, count ) makes room for at least "count" half-edges.
+* The capacity grows by half rather than doubling, so that the arrays
+* are never more than a third empty, and an edge pair takes at most
+* about 123 bytes with the slack, less than two 64 byte edge records.
+*/
+static int GrowEdges( TESSmesh *mesh, TESShalfEdge count )
+{
+	TESShalfEdge capacity = mesh->edgeCapacity;
+
+	while( capacity < count ) {
+		capacity += (capacity / 4) * 2 + 2;
+	}
+	return ResizeEdges( mesh, capacity );
+}
+
+/* Allocate and free half-edges in pairs, so that e and e^1 are mates.
+* Freed pairs are kept in a list linked through eNext, and are reused
+* before the arrays are grown.
 */
-typedef struct { TESShalfEdge e, eSym; } EdgePair;
+static TESShalfEdge AllocEdgePair( TESSmesh *mesh )
+{
+	TESShalfEdge e = mesh->freeEdges;
+
+	if( e != NULL_EDGE ) {
+		mesh->freeEdges = NextEdge( mesh, e );
+		return e;
+	}
+	if( mesh->edgeCount == mesh->edgeCapacity ) {
+		if ( !GrowEdges( mesh, mesh->edgeCount + 2 )) return NULL_EDGE;
+	}
+	e = mesh->edgeCount;
+	mesh->edgeCount += 2;
+	return e;
+}
+
+static void FreeEdgePair( TESSmesh *mesh, TESShalfEdge e )
+{
+	NextEdge( mesh, e ) = mesh->freeEdges;
+	mesh->freeEdges = e;
+}
 
 /* MakeEdge creates a new pair of half-edges which form their own loop.
 * No vertex or face structures are allocated, but these must be assigned
 * before the current edge operation is completed.
 */
-static TESShalfEdge *MakeEdge( TESSmesh* mesh, TESShalfEdge *eNext )
+static TESShalfEdge MakeEdge( TESSmesh* mesh, TESShalfEdge eNext )
 {
-	TESShalfEdge *e;
-	TESShalfEdge *eSym;
-	TESShalfEdge *ePrev;
-	EdgePair *pair = (EdgePair *)bucketAlloc( mesh->edgeBucket );
-	if (pair == NULL) return NULL;
+	TESShalfEdge e;
+	TESShalfEdge eSym;
+	TESShalfEdge ePrev;
 
-	e = &pair->e;
-	eSym = &pair->eSym;
+	e = AllocEdgePair( mesh );
+	if (e == NULL_EDGE) return NULL_EDGE;
+	eSym = Sym(e);
 
 	/* Make sure eNext points to the first edge of the edge pair */
-	if( eNext->Sym < eNext ) { eNext = eNext->Sym; }
+	if( Sym(eNext) < eNext ) { eNext = Sym(eNext); }
 
 	/* Insert in circular doubly-linked list before eNext.
 	* Note that the prev pointer is stored in Sym->next.
 	*/
-	ePrev = eNext->Sym->next;
-	eSym->next = ePrev;
-	ePrev->Sym->next = e;
-	e->next = eNext;
-	eNext->Sym->next = eSym;
-
-	e->Sym = eSym;
-	e->Onext = e;
-	e->Lnext = eSym;
-	e->Org = NULL;
-	e->Lface = NULL;
-	e->winding = 0;
-	e->activeRegion = NULL;
-	e->mark = 0;
-
-	eSym->Sym = e;
-	eSym->Onext = eSym;
-	eSym->Lnext = e;
-	eSym->Org = NULL;
-	eSym->Lface = NULL;
-	eSym->winding = 0;
-	eSym->activeRegion = NULL;
-	eSym->mark = 0;
+	ePrev = NextEdge( mesh, Sym(eNext) );
+	NextEdge( mesh, eSym ) = ePrev;
+	NextEdge( mesh, Sym(ePrev) ) = e;
+	NextEdge( mesh, e ) = eNext;
+	NextEdge( mesh, Sym(eNext) ) = eSym;
+
+	Onext( mesh, e ) = e;
+	Lnext( mesh, e ) = eSym;
+	Org( mesh, e ) = NULL;
+	Lface( mesh, e ) = NULL;
+	Winding( mesh, e ) = 0;
+	EdgeRegion( mesh, e ) = NULL;
+	EdgeMark( mesh, e ) = 0;
+
+	Onext( mesh, eSym ) = eSym;
+	Lnext( mesh, eSym ) = e;
+	Org( mesh, eSym ) = NULL;
+	Lface( mesh, eSym ) = NULL;
+	Winding( mesh, eSym ) = 0;
+	EdgeRegion( mesh, eSym ) = NULL;
+	EdgeMark( mesh, eSym ) = 0;
 
 	return e;
 }
@@ -100,15 +190,15 @@ static TESShalfEdge *MakeEdge( TESSmesh* mesh, TESShalfEdge *eNext )
 * depending on whether a and b belong to different face or vertex rings.
 * For more explanation see tessMeshSplice() below.
 */
-static void Splice( TESShalfEdge *a, TESShalfEdge *b )
+static void Splice( TESSmesh *mesh, TESShalfEdge a, TESShalfEdge b )
 {
-	TESShalfEdge *aOnext = a->Onext;
-	TESShalfEdge *bOnext = b->Onext;
+	TESShalfEdge aOnext = Onext( mesh, a );
+	TESShalfEdge bOnext = Onext( mesh, b );
 
-	aOnext->Sym->Lnext = b;
-	bOnext->Sym->Lnext = a;
-	a->Onext = bOnext;
-	b->Onext = aOnext;
+	Lnext( mesh, Sym(aOnext) ) = b;
+	Lnext( mesh, Sym(bOnext) ) = a;
+	Onext( mesh, a ) = bOnext;
+	Onext( mesh, b ) = aOnext;
 }
 
 /* MakeVertex( newVertex, eOrig, vNext ) attaches a new vertex and makes it the
@@ -117,10 +207,10 @@ static void Splice( TESShalfEdge *a, TESShalfEdge *b )
 * the new vertex *before* vNext so that algorithms which walk the vertex
 * list will not see the newly created vertices.
 */
-static void MakeVertex( TESSvertex *newVertex, 
-					   TESShalfEdge *eOrig, TESSvertex *vNext )
+static void MakeVertex( TESSmesh *mesh, TESSvertex *newVertex, 
+					   TESShalfEdge eOrig, TESSvertex *vNext )
 {
-	TESShalfEdge *e;
+	TESShalfEdge e;
 	TESSvertex *vPrev;
 	TESSvertex *vNew = newVertex;
 
@@ -139,25 +229,58 @@ static void MakeVertex( TESSvertex *newVertex,
 	/* fix other edges on this vertex loop */
 	e = eOrig;
 	do {
-		e->Org = vNew;
-		e = e->Onext;
+		Org( mesh, e ) = vNew;
+		e = Onext( mesh, e );
 	} while( e != eOrig );
 }
 
+/* LoopIsSmaller( a, b ) walks the face loops of a and b in lockstep and
+* returns TRUE if the loop of a has fewer edges.  The work done is
+* proportional to the size of the smaller loop.
+*/
+static int LoopIsSmaller( TESSmesh *mesh, TESShalfEdge a, TESShalfEdge b )
+{
+	TESShalfEdge ea = Lnext( mesh, a );
+	TESShalfEdge eb = Lnext( mesh, b );
+
+	for( ;; ) {
+		if( eb == b ) return FALSE;
+		if( ea == a ) return TRUE;
+		ea = Lnext( mesh, ea );
+		eb = Lnext( mesh, eb );
+	}
+}
+
 /* MakeFace( newFace, eOrig, fNext ) attaches a new face and makes it the left
 * face of all edges in the face loop to which eOrig belongs.  "fNext" gives
 * a place to insert the new face in the global face list.  We insert
 * the new face *before* fNext so that algorithms which walk the face
 * list will not see the newly created faces.
+*
+* When a loop is split in two, fNext is the old face and fNext->anEdge
+* must already belong to the other half.  If mesh->relabelSmallerLoop is
+* set and that half is the smaller one, newFace takes over the place and
+* contents of fNext, and the old face record becomes the new face instead.
+* The face list ends up the same, but only the smaller loop is relabeled.
 */
-static void MakeFace( TESSface *newFace, TESShalfEdge *eOrig, TESSface *fNext )
+static void MakeFace( TESSmesh *mesh, TESSface *newFace, TESShalfEdge eOrig, TESSface *fNext )
 {
-	TESShalfEdge *e;
+	TESShalfEdge e, eStart = eOrig;
 	TESSface *fPrev;
 	TESSface *fNew = newFace;
 
 	assert(fNew != NULL); 
 
+	if( mesh->relabelSmallerLoop && fNext->anEdge != NULL_EDGE
+		&& LoopIsSmaller( mesh, fNext->anEdge, eOrig )) {
+		eStart = fNext->anEdge;
+		*newFace = *fNext;
+		newFace->prev->next = newFace;
+		newFace->next->prev = newFace;
+		fNew = fNext;
+		fNext = newFace;
+	}
+
 	/* insert in circular doubly-linked list before fNext */
 	fPrev = fNext->prev;
 	fNew->prev = fPrev;
@@ -175,30 +298,30 @@ static void MakeFace( TESSface *newFace, TESShalfEdge *eOrig, TESSface *fNext )
 	fNew->inside = fNext->inside;
 
 	/* fix other edges on this face loop */
-	e = eOrig;
+	e = eStart;
 	do {
-		e->Lface = fNew;
-		e = e->Lnext;
-	} while( e != eOrig );
+		Lface( mesh, e ) = newFace;
+		e = Lnext( mesh, e );
+	} while( e != eStart );
 }
 
 /* KillEdge( eDel ) destroys an edge (the half-edges eDel and eDel->Sym),
 * and removes from the global edge list.
 */
-static void KillEdge( TESSmesh *mesh, TESShalfEdge *eDel )
+static void KillEdge( TESSmesh *mesh, TESShalfEdge eDel )
 {
-	TESShalfEdge *ePrev, *eNext;
+	TESShalfEdge ePrev, eNext;
 
-	/* Half-edges are allocated in pairs, see EdgePair above */
-	if( eDel->Sym < eDel ) { eDel = eDel->Sym; }
+	/* Half-edges are allocated in pairs, see AllocEdgePair above */
+	if( Sym(eDel) < eDel ) { eDel = Sym(eDel); }
 
 	/* delete from circular doubly-linked list */
-	eNext = eDel->next;
-	ePrev = eDel->Sym->next;
-	eNext->Sym->next = ePrev;
-	ePrev->Sym->next = eNext;
+	eNext = NextEdge( mesh, eDel );
+	ePrev = NextEdge( mesh, Sym(eDel) );
+	NextEdge( mesh, Sym(eNext) ) = ePrev;
+	NextEdge( mesh, Sym(ePrev) ) = eNext;
 
-	bucketFree( mesh->edgeBucket, eDel );
+	FreeEdgePair( mesh, eDel );
 }
 
 
@@ -207,14 +330,14 @@ static void KillEdge( TESSmesh *mesh, TESShalfEdge *eDel )
 */
 static void KillVertex( TESSmesh *mesh, TESSvertex *vDel, TESSvertex *newOrg )
 {
-	TESShalfEdge *e, *eStart = vDel->anEdge;
+	TESShalfEdge e, eStart = vDel->anEdge;
 	TESSvertex *vPrev, *vNext;
 
 	/* change the origin of all affected edges */
 	e = eStart;
 	do {
-		e->Org = newOrg;
-		e = e->Onext;
+		Org( mesh, e ) = newOrg;
+		e = Onext( mesh, e );
 	} while( e != eStart );
 
 	/* delete from circular doubly-linked list */
@@ -228,25 +351,44 @@ static void KillVertex( TESSmesh *mesh, TESSvertex *vDel, TESSvertex *newOrg )
 
 /* KillFace( fDel ) destroys a face and removes it from the global face
 * list.  It updates the face loop to point to a given new face.
+*
+* If mesh->relabelSmallerLoop is set and the loop of newLface is the
+* smaller one, that loop is relabeled instead: fDel survives in the
+* place and with the contents of newLface, which is destroyed.
 */
 static void KillFace( TESSmesh *mesh, TESSface *fDel, TESSface *newLface )
 {
-	TESShalfEdge *e, *eStart = fDel->anEdge;
+	TESShalfEdge e, eStart = fDel->anEdge;
 	TESSface *fPrev, *fNext;
 
-	/* change the left face of all affected edges */
-	e = eStart;
-	do {
-		e->Lface = newLface;
-		e = e->Lnext;
-	} while( e != eStart );
-
 	/* delete from circular doubly-linked list */
 	fPrev = fDel->prev;
 	fNext = fDel->next;
 	fNext->prev = fPrev;
 	fPrev->next = fNext;
 
+	if( newLface != NULL && mesh->relabelSmallerLoop
+		&& LoopIsSmaller( mesh, newLface->anEdge, eStart )) {
+		e = eStart = newLface->anEdge;
+		do {
+			Lface( mesh, e ) = fDel;
+			e = Lnext( mesh, e );
+		} while( e != eStart );
+
+		*fDel = *newLface;
+		fDel->prev->next = fDel;
+		fDel->next->prev = fDel;
+		bucketFree( mesh->faceBucket, newLface );
+		return;
+	}
+
+	/* change the left face of all affected edges */
+	e = eStart;
+	do {
+		Lface( mesh, e ) = newLface;
+		e = Lnext( mesh, e );
+	} while( e != eStart );
+
 	bucketFree( mesh->faceBucket, fDel );
 }
 
@@ -256,27 +398,27 @@ static void KillFace( TESSmesh *mesh, TESSface *fDel, TESSface *newLface )
 /* tessMeshMakeEdge creates one edge, two vertices, and a loop (face).
 * The loop consists of the two new half-edges.
 */
-TESShalfEdge *tessMeshMakeEdge( TESSmesh *mesh )
+TESShalfEdge tessMeshMakeEdge( TESSmesh *mesh )
 {
 	TESSvertex *newVertex1 = (TESSvertex*)bucketAlloc(mesh->vertexBucket);
 	TESSvertex *newVertex2 = (TESSvertex*)bucketAlloc(mesh->vertexBucket);
 	TESSface *newFace = (TESSface*)bucketAlloc(mesh->faceBucket);
-	TESShalfEdge *e;
+	TESShalfEdge e;
 
 	/* if any one is null then all get freed */
 	if (newVertex1 == NULL || newVertex2 == NULL || newFace == NULL) {
 		if (newVertex1 != NULL) bucketFree( mesh->vertexBucket, newVertex1 );
 		if (newVertex2 != NULL) bucketFree( mesh->vertexBucket, newVertex2 );
 		if (newFace != NULL) bucketFree( mesh->faceBucket, newFace );     
-		return NULL;
+		return NULL_EDGE;
 	} 
 
-	e = MakeEdge( mesh, &mesh->eHead );
-	if (e == NULL) return NULL;
+	e = MakeEdge( mesh, EDGE_HEAD );
+	if (e == NULL_EDGE) return NULL_EDGE;
 
-	MakeVertex( newVertex1, e, &mesh->vHead );
-	MakeVertex( newVertex2, e->Sym, &mesh->vHead );
-	MakeFace( newFace, e, &mesh->fHead );
+	MakeVertex( mesh, newVertex1, e, &mesh->vHead );
+	MakeVertex( mesh, newVertex2, Sym(e), &mesh->vHead );
+	MakeFace( mesh, newFace, e, &mesh->fHead );
 	return e;
 }
 
@@ -304,26 +446,26 @@ TESShalfEdge *tessMeshMakeEdge( TESSmesh *mesh )
 * If eDst == eOrg->Onext, the new vertex will have a single edge.
 * If eDst == eOrg->Oprev, the old vertex will have a single edge.
 */
-int tessMeshSplice( TESSmesh* mesh, TESShalfEdge *eOrg, TESShalfEdge *eDst )
+int tessMeshSplice( TESSmesh* mesh, TESShalfEdge eOrg, TESShalfEdge eDst )
 {
 	int joiningLoops = FALSE;
 	int joiningVertices = FALSE;
 
 	if( eOrg == eDst ) return 1;
 
-	if( eDst->Org != eOrg->Org ) {
+	if( Org( mesh, eDst ) != Org( mesh, eOrg )) {
 		/* We are merging two disjoint vertices -- destroy eDst->Org */
 		joiningVertices = TRUE;
-		KillVertex( mesh, eDst->Org, eOrg->Org );
+		KillVertex( mesh, Org( mesh, eDst ), Org( mesh, eOrg ));
 	}
-	if( eDst->Lface != eOrg->Lface ) {
+	if( Lface( mesh, eDst ) != Lface( mesh, eOrg )) {
 		/* We are connecting two disjoint loops -- destroy eDst->Lface */
 		joiningLoops = TRUE;
-		KillFace( mesh, eDst->Lface, eOrg->Lface );
+		KillFace( mesh, Lface( mesh, eDst ), Lface( mesh, eOrg ));
 	}
 
 	/* Change the edge structure */
-	Splice( eDst, eOrg );
+	Splice( mesh, eDst, eOrg );
 
 	if( ! joiningVertices ) {
 		TESSvertex *newVertex = (TESSvertex*)bucketAlloc( mesh->vertexBucket );
@@ -332,8 +474,8 @@ int tessMeshSplice( TESSmesh* mesh, TESShalfEdge *eOrg, TESShalfEdge *eDst )
 		/* We split one vertex into two -- the new vertex is eDst->Org.
 		* Make sure the old vertex points to a valid half-edge.
 		*/
-		MakeVertex( newVertex, eDst, eOrg->Org );
-		eOrg->Org->anEdge = eOrg;
+		MakeVertex( mesh, newVertex, eDst, Org( mesh, eOrg ));
+		Org( mesh, eOrg )->anEdge = eOrg;
 	}
 	if( ! joiningLoops ) {
 		TESSface *newFace = (TESSface*)bucketAlloc( mesh->faceBucket );  
@@ -342,8 +484,8 @@ int tessMeshSplice( TESSmesh* mesh, TESShalfEdge *eOrg, TESShalfEdge *eDst )
 		/* We split one loop into two -- the new loop is eDst->Lface.
 		* Make sure the old face points to a valid half-edge.
 		*/
-		MakeFace( newFace, eDst, eOrg->Lface );
-		eOrg->Lface->anEdge = eOrg;
+		Lface( mesh, eOrg )->anEdge = eOrg;
+		MakeFace( mesh, newFace, eDst, Lface( mesh, eOrg ));
 	}
 
 	return 1;
@@ -360,48 +502,48 @@ int tessMeshSplice( TESSmesh* mesh, TESShalfEdge *eOrg, TESShalfEdge *eDst )
 * plus a few calls to memFree, but this would allocate and delete
 * unnecessary vertices and faces.
 */
-int tessMeshDelete( TESSmesh *mesh, TESShalfEdge *eDel )
+int tessMeshDelete( TESSmesh *mesh, TESShalfEdge eDel )
 {
-	TESShalfEdge *eDelSym = eDel->Sym;
+	TESShalfEdge eDelSym = Sym(eDel);
 	int joiningLoops = FALSE;
 
 	/* First step: disconnect the origin vertex eDel->Org.  We make all
 	* changes to get a consistent mesh in this "intermediate" state.
 	*/
-	if( eDel->Lface != eDel->Rface ) {
+	if( Lface( mesh, eDel ) != Rface( mesh, eDel )) {
 		/* We are joining two loops into one -- remove the left face */
 		joiningLoops = TRUE;
-		KillFace( mesh, eDel->Lface, eDel->Rface );
+		KillFace( mesh, Lface( mesh, eDel ), Rface( mesh, eDel ));
 	}
 
-	if( eDel->Onext == eDel ) {
-		KillVertex( mesh, eDel->Org, NULL );
+	if( Onext( mesh, eDel ) == eDel ) {
+		KillVertex( mesh, Org( mesh, eDel ), NULL );
 	} else {
 		/* Make sure that eDel->Org and eDel->Rface point to valid half-edges */
-		eDel->Rface->anEdge = eDel->Oprev;
-		eDel->Org->anEdge = eDel->Onext;
+		Rface( mesh, eDel )->anEdge = Oprev( mesh, eDel );
+		Org( mesh, eDel )->anEdge = Onext( mesh, eDel );
 
-		Splice( eDel, eDel->Oprev );
+		Splice( mesh, eDel, Oprev( mesh, eDel ));
 		if( ! joiningLoops ) {
 			TESSface *newFace= (TESSface*)bucketAlloc( mesh->faceBucket );
 			if (newFace == NULL) return 0; 
 
 			/* We are splitting one loop into two -- create a new loop for eDel. */
-			MakeFace( newFace, eDel, eDel->Lface );
+			MakeFace( mesh, newFace, eDel, Lface( mesh, eDel ));
 		}
 	}
 
 	/* Claim: the mesh is now in a consistent state, except that eDel->Org
 	* may have been deleted.  Now we disconnect eDel->Dst.
 	*/
-	if( eDelSym->Onext == eDelSym ) {
-		KillVertex( mesh, eDelSym->Org, NULL );
-		KillFace( mesh, eDelSym->Lface, NULL );
+	if( Onext( mesh, eDelSym ) == eDelSym ) {
+		KillVertex( mesh, Org( mesh, eDelSym ), NULL );
+		KillFace( mesh, Lface( mesh, eDelSym ), NULL );
 	} else {
 		/* Make sure that eDel->Dst and eDel->Lface point to valid half-edges */
-		eDel->Lface->anEdge = eDelSym->Oprev;
-		eDelSym->Org->anEdge = eDelSym->Onext;
-		Splice( eDelSym, eDelSym->Oprev );
+		Lface( mesh, eDel )->anEdge = Oprev( mesh, eDelSym );
+		Org( mesh, eDelSym )->anEdge = Onext( mesh, eDelSym );
+		Splice( mesh, eDelSym, Oprev( mesh, eDelSym ));
 	}
 
 	/* Any isolated vertices or faces have already been freed. */
@@ -422,26 +564,26 @@ int tessMeshDelete( TESSmesh *mesh, TESShalfEdge *eDel )
 * eNew == eOrg->Lnext, and eNew->Dst is a newly created vertex.
 * eOrg and eNew will have the same left face.
 */
-TESShalfEdge *tessMeshAddEdgeVertex( TESSmesh *mesh, TESShalfEdge *eOrg )
+TESShalfEdge tessMeshAddEdgeVertex( TESSmesh *mesh, TESShalfEdge eOrg )
 {
-	TESShalfEdge *eNewSym;
-	TESShalfEdge *eNew = MakeEdge( mesh, eOrg );
-	if (eNew == NULL) return NULL;
+	TESShalfEdge eNewSym;
+	TESShalfEdge eNew = MakeEdge( mesh, eOrg );
+	if (eNew == NULL_EDGE) return NULL_EDGE;
 
-	eNewSym = eNew->Sym;
+	eNewSym = Sym(eNew);
 
 	/* Connect the new edge appropriately */
-	Splice( eNew, eOrg->Lnext );
+	Splice( mesh, eNew, Lnext( mesh, eOrg ));
 
 	/* Set the vertex and face information */
-	eNew->Org = eOrg->Dst;
+	Org( mesh, eNew ) = Dst( mesh, eOrg );
 	{
 		TESSvertex *newVertex= (TESSvertex*)bucketAlloc( mesh->vertexBucket );
-		if (newVertex == NULL) return NULL;
+		if (newVertex == NULL) return NULL_EDGE;
 
-		MakeVertex( newVertex, eNewSym, eNew->Org );
+		MakeVertex( mesh, newVertex, eNewSym, Org( mesh, eNew ));
 	}
-	eNew->Lface = eNewSym->Lface = eOrg->Lface;
+	Lface( mesh, eNew ) = Lface( mesh, eNewSym ) = Lface( mesh, eOrg );
 
 	return eNew;
 }
@@ -451,24 +593,24 @@ TESShalfEdge *tessMeshAddEdgeVertex( TESSmesh *mesh, TESShalfEdge *eOrg )
 * such that eNew == eOrg->Lnext.  The new vertex is eOrg->Dst == eNew->Org.
 * eOrg and eNew will have the same left face.
 */
-TESShalfEdge *tessMeshSplitEdge( TESSmesh *mesh, TESShalfEdge *eOrg )
+TESShalfEdge tessMeshSplitEdge( TESSmesh *mesh, TESShalfEdge eOrg )
 {
-	TESShalfEdge *eNew;
-	TESShalfEdge *tempHalfEdge= tessMeshAddEdgeVertex( mesh, eOrg );
-	if (tempHalfEdge == NULL) return NULL;
+	TESShalfEdge eNew;
+	TESShalfEdge tempHalfEdge= tessMeshAddEdgeVertex( mesh, eOrg );
+	if (tempHalfEdge == NULL_EDGE) return NULL_EDGE;
 
-	eNew = tempHalfEdge->Sym;
+	eNew = Sym(tempHalfEdge);
 
 	/* Disconnect eOrg from eOrg->Dst and connect it to eNew->Org */
-	Splice( eOrg->Sym, eOrg->Sym->Oprev );
-	Splice( eOrg->Sym, eNew );
+	Splice( mesh, Sym(eOrg), Oprev( mesh, Sym(eOrg) ));
+	Splice( mesh, Sym(eOrg), eNew );
 
 	/* Set the vertex and face information */
-	eOrg->Dst = eNew->Org;
-	eNew->Dst->anEdge = eNew->Sym;	/* may have pointed to eOrg->Sym */
-	eNew->Rface = eOrg->Rface;
-	eNew->winding = eOrg->winding;	/* copy old winding information */
-	eNew->Sym->winding = eOrg->Sym->winding;
+	Dst( mesh, eOrg ) = Org( mesh, eNew );
+	Dst( mesh, eNew )->anEdge = Sym(eNew);	/* may have pointed to eOrg->Sym */
+	Rface( mesh, eNew ) = Rface( mesh, eOrg );
+	Winding( mesh, eNew ) = Winding( mesh, eOrg );	/* copy old winding information */
+	Winding( mesh, Sym(eNew) ) = Winding( mesh, Sym(eOrg) );
 
 	return eNew;
 }
@@ -484,39 +626,39 @@ TESShalfEdge *tessMeshSplitEdge( TESSmesh *mesh, TESShalfEdge *eOrg )
 * If (eOrg->Lnext == eDst), the old face is reduced to a single edge.
 * If (eOrg->Lnext->Lnext == eDst), the old face is reduced to two edges.
 */
-TESShalfEdge *tessMeshConnect( TESSmesh *mesh, TESShalfEdge *eOrg, TESShalfEdge *eDst )
+TESShalfEdge tessMeshConnect( TESSmesh *mesh, TESShalfEdge eOrg, TESShalfEdge eDst )
 {
-	TESShalfEdge *eNewSym;
+	TESShalfEdge eNewSym;
 	int joiningLoops = FALSE;  
-	TESShalfEdge *eNew = MakeEdge( mesh, eOrg );
-	if (eNew == NULL) return NULL;
+	TESShalfEdge eNew = MakeEdge( mesh, eOrg );
+	if (eNew == NULL_EDGE) return NULL_EDGE;
 
-	eNewSym = eNew->Sym;
+	eNewSym = Sym(eNew);
 
-	if( eDst->Lface != eOrg->Lface ) {
+	if( Lface( mesh, eDst ) != Lface( mesh, eOrg )) {
 		/* We are connecting two disjoint loops -- destroy eDst->Lface */
 		joiningLoops = TRUE;
-		KillFace( mesh, eDst->Lface, eOrg->Lface );
+		KillFace( mesh, Lface( mesh, eDst ), Lface( mesh, eOrg ));
 	}
 
 	/* Connect the new edge appropriately */
-	Splice( eNew, eOrg->Lnext );
-	Splice( eNewSym, eDst );
+	Splice( mesh, eNew, Lnext( mesh, eOrg ));
+	Splice( mesh, eNewSym, eDst );
 
 	/* Set the vertex and face information */
-	eNew->Org = eOrg->Dst;
-	eNewSym->Org = eDst->Org;
-	eNew->Lface = eNewSym->Lface = eOrg->Lface;
+	Org( mesh, eNew ) = Dst( mesh, eOrg );
+	Org( mesh, eNewSym ) = Org( mesh, eDst );
+	Lface( mesh, eNew ) = Lface( mesh, eNewSym ) = Lface( mesh, eOrg );
 
 	/* Make sure the old face points to a valid half-edge */
-	eOrg->Lface->anEdge = eNewSym;
+	Lface( mesh, eOrg )->anEdge = eNewSym;
 
 	if( ! joiningLoops ) {
 		TESSface *newFace= (TESSface*)bucketAlloc( mesh->faceBucket );
-		if (newFace == NULL) return NULL;
+		if (newFace == NULL) return NULL_EDGE;
 
 		/* We split one loop into two -- the new loop is eNew->Lface */
-		MakeFace( newFace, eNew, eOrg->Lface );
+		MakeFace( mesh, newFace, eNew, Lface( mesh, eOrg ));
 	}
 	return eNew;
 }
@@ -533,34 +675,34 @@ TESShalfEdge *tessMeshConnect( TESSmesh *mesh, TESShalfEdge *eOrg, TESShalfEdge
 */
 void tessMeshZapFace( TESSmesh *mesh, TESSface *fZap )
 {
-	TESShalfEdge *eStart = fZap->anEdge;
-	TESShalfEdge *e, *eNext, *eSym;
+	TESShalfEdge eStart = fZap->anEdge;
+	TESShalfEdge e, eNext, eSym;
 	TESSface *fPrev, *fNext;
 
 	/* walk around face, deleting edges whose right face is also NULL */
-	eNext = eStart->Lnext;
+	eNext = Lnext( mesh, eStart );
 	do {
 		e = eNext;
-		eNext = e->Lnext;
+		eNext = Lnext( mesh, e );
 
-		e->Lface = NULL;
-		if( e->Rface == NULL ) {
+		Lface( mesh, e ) = NULL;
+		if( Rface( mesh, e ) == NULL ) {
 			/* delete the edge -- see TESSmeshDelete above */
 
-			if( e->Onext == e ) {
-				KillVertex( mesh, e->Org, NULL );
+			if( Onext( mesh, e ) == e ) {
+				KillVertex( mesh, Org( mesh, e ), NULL );
 			} else {
 				/* Make sure that e->Org points to a valid half-edge */
-				e->Org->anEdge = e->Onext;
-				Splice( e, e->Oprev );
+				Org( mesh, e )->anEdge = Onext( mesh, e );
+				Splice( mesh, e, Oprev( mesh, e ));
 			}
-			eSym = e->Sym;
-			if( eSym->Onext == eSym ) {
-				KillVertex( mesh, eSym->Org, NULL );
+			eSym = Sym(e);
+			if( Onext( mesh, eSym ) == eSym ) {
+				KillVertex( mesh, Org( mesh, eSym ), NULL );
 			} else {
 				/* Make sure that eSym->Org points to a valid half-edge */
-				eSym->Org->anEdge = eSym->Onext;
-				Splice( eSym, eSym->Oprev );
+				Org( mesh, eSym )->anEdge = Onext( mesh, eSym );
+				Splice( mesh, eSym, Oprev( mesh, eSym ));
 			}
 			KillEdge( mesh, e );
 		}
@@ -576,15 +718,58 @@ void tessMeshZapFace( TESSmesh *mesh, TESSface *fZap )
 }
 
 
+static void InitMeshHeads( TESSmesh *mesh )
+{
+	TESSvertex *v;
+	TESSface *f;
+	TESShalfEdge e;
+
+	v = &mesh->vHead;
+	f = &mesh->fHead;
+
+	v->next = v->prev = v;
+	v->anEdge = NULL_EDGE;
+
+	f->next = f->prev = f;
+	f->anEdge = NULL_EDGE;
+	f->trail = NULL;
+	f->marked = FALSE;
+	f->inside = FALSE;
+
+	/* The pair NULL_EDGE is never used, EDGE_HEAD is the dummy header. */
+	for( e = NULL_EDGE; e <= Sym(EDGE_HEAD); ++e ) {
+		NextEdge( mesh, e ) = e;
+		Onext( mesh, e ) = NULL_EDGE;
+		Lnext( mesh, e ) = NULL_EDGE;
+		Org( mesh, e ) = NULL;
+		Lface( mesh, e ) = NULL;
+		Winding( mesh, e ) = 0;
+		EdgeRegion( mesh, e ) = NULL;
+		EdgeMark( mesh, e ) = 0;
+	}
+	mesh->edgeCount = Sym(EDGE_HEAD) + 1;
+	mesh->freeEdges = NULL_EDGE;
+
+	mesh->relabelSmallerLoop = FALSE;
+}
+
+static void FreeEdgeArrays( TESSalloc* alloc, TESSmesh *mesh )
+{
+	if (mesh->eNext != NULL) alloc->memfree( alloc->userData, mesh->eNext );
+	if (mesh->eOnext != NULL) alloc->memfree( alloc->userData, mesh->eOnext );
+	if (mesh->eLnext != NULL) alloc->memfree( alloc->userData, mesh->eLnext );
+	if (mesh->eOrg != NULL) alloc->memfree( alloc->userData, mesh->eOrg );
+	if (mesh->eLface != NULL) alloc->memfree( alloc->userData, mesh->eLface );
+	if (mesh->eRegion != NULL) alloc->memfree( alloc->userData, mesh->eRegion );
+	if (mesh->eWinding != NULL) alloc->memfree( alloc->userData, mesh->eWinding );
+	if (mesh->eMark != NULL) alloc->memfree( alloc->userData, mesh->eMark );
+}
+
 /* tessMeshNewMesh() creates a new mesh with no edges, no vertices,
 * and no loops (what we usually call a "face").
 */
 TESSmesh *tessMeshNewMesh( TESSalloc* alloc )
 {
-	TESSvertex *v;
-	TESSface *f;
-	TESShalfEdge *e;
-	TESShalfEdge *eSym;
 	TESSmesh *mesh = (TESSmesh *)alloc->memalloc( alloc->userData, sizeof( TESSmesh ));
 	if (mesh == NULL) {
 		return NULL;
@@ -605,41 +790,27 @@ TESSmesh *tessMeshNewMesh( TESSalloc* alloc )
 	if (alloc->meshFaceBucketSize > 4096)
 		alloc->meshFaceBucketSize = 4096;
 
-	mesh->edgeBucket = createBucketAlloc( alloc, "Mesh Edges", sizeof(EdgePair), alloc->meshEdgeBucketSize );
+	/* The half-edge arrays start out with room for meshEdgeBucketSize
+	* edges, and grow by half whenever they are full.
+	*/
+	mesh->alloc = alloc;
+	mesh->eNext = mesh->eOnext = mesh->eLnext = NULL;
+	mesh->eOrg = NULL;
+	mesh->eLface = NULL;
+	mesh->eRegion = NULL;
+	mesh->eWinding = NULL;
+	mesh->eMark = NULL;
+	mesh->edgeCapacity = 0;
+	if (!ResizeEdges( mesh, 2 * (TESShalfEdge)alloc->meshEdgeBucketSize )) {
+		FreeEdgeArrays( alloc, mesh );
+		alloc->memfree( alloc->userData, mesh );
+		return NULL;
+	}
+
 	mesh->vertexBucket = createBucketAlloc( alloc, "Mesh Vertices", sizeof(TESSvertex), alloc->meshVertexBucketSize );
 	mesh->faceBucket = createBucketAlloc( alloc, "Mesh Faces", sizeof(TESSface), alloc->meshFaceBucketSize );
 
-	v = &mesh->vHead;
-	f = &mesh->fHead;
-	e = &mesh->eHead;
-	eSym = &mesh->eHeadSym;
-
-	v->next = v->prev = v;
-	v->anEdge = NULL;
-
-	f->next = f->prev = f;
-	f->anEdge = NULL;
-	f->trail = NULL;
-	f->marked = FALSE;
-	f->inside = FALSE;
-
-	e->next = e;
-	e->Sym = eSym;
-	e->Onext = NULL;
-	e->Lnext = NULL;
-	e->Org = NULL;
-	e->Lface = NULL;
-	e->winding = 0;
-	e->activeRegion = NULL;
-
-	eSym->next = eSym;
-	eSym->Sym = e;
-	eSym->Onext = NULL;
-	eSym->Lnext = NULL;
-	eSym->Org = NULL;
-	eSym->Lface = NULL;
-	eSym->winding = 0;
-	eSym->activeRegion = NULL;
+	InitMeshHeads( mesh );
 
 	return mesh;
 }
@@ -647,15 +818,54 @@ TESSmesh *tessMeshNewMesh( TESSalloc* alloc )
 
 /* tessMeshUnion( mesh1, mesh2 ) forms the union of all structures in
 * both meshes, and returns the new mesh (the old meshes are destroyed).
+*
+* The half-edges of mesh2 are appended to the arrays of mesh1, which
+* moves each index e >= 4 of mesh2 to e - 4 + mesh1->edgeCount.
 */
 TESSmesh *tessMeshUnion( TESSalloc* alloc, TESSmesh *mesh1, TESSmesh *mesh2 )
 {
 	TESSface *f1 = &mesh1->fHead;
 	TESSvertex *v1 = &mesh1->vHead;
-	TESShalfEdge *e1 = &mesh1->eHead;
+	TESShalfEdge e1 = EDGE_HEAD;
 	TESSface *f2 = &mesh2->fHead;
 	TESSvertex *v2 = &mesh2->vHead;
-	TESShalfEdge *e2 = &mesh2->eHead;
+	TESShalfEdge e2, e2Next, e2SymNext;
+	TESShalfEdge offset = mesh1->edgeCount - (Sym(EDGE_HEAD) + 1);
+	TESShalfEdge count = mesh2->edgeCount - (Sym(EDGE_HEAD) + 1);
+	TESShalfEdge e;
+	TESSvertex *v;
+	TESSface *f;
+
+#define MOVED(x)	((x) > Sym(EDGE_HEAD) ? (x) + offset : (x))
+
+	if( mesh1->edgeCapacity < mesh1->edgeCount + count ) {
+		if ( !GrowEdges( mesh1, mesh1->edgeCount + count )) return NULL;
+	}
+	for( e2 = Sym(EDGE_HEAD) + 1; e2 < mesh2->edgeCount; ++e2 ) {
+		e = MOVED(e2);
+		NextEdge( mesh1, e ) = MOVED(NextEdge( mesh2, e2 ));
+		Onext( mesh1, e ) = MOVED(Onext( mesh2, e2 ));
+		Lnext( mesh1, e ) = MOVED(Lnext( mesh2, e2 ));
+		Org( mesh1, e ) = Org( mesh2, e2 );
+		Lface( mesh1, e ) = Lface( mesh2, e2 );
+		EdgeRegion( mesh1, e ) = EdgeRegion( mesh2, e2 );
+		Winding( mesh1, e ) = Winding( mesh2, e2 );
+		EdgeMark( mesh1, e ) = EdgeMark( mesh2, e2 );
+	}
+	mesh1->edgeCount += count;
+	for( v = v2->next; v != v2; v = v->next ) {
+		v->anEdge = MOVED(v->anEdge);
+	}
+	for( f = f2->next; f != f2; f = f->next ) {
+		f->anEdge = MOVED(f->anEdge);
+	}
+	for( e2 = mesh2->freeEdges; e2 != NULL_EDGE; e2 = NextEdge( mesh2, e2 )) {
+		FreeEdgePair( mesh1, MOVED(e2) );
+	}
+	e2Next = MOVED(NextEdge( mesh2, EDGE_HEAD ));
+	e2SymNext = MOVED(NextEdge( mesh2, Sym(EDGE_HEAD) ));
+
+#undef MOVED
 
 	/* Add the faces, vertices, and edges of mesh2 to those of mesh1 */
 	if( f2->next != f2 ) {
@@ -672,26 +882,27 @@ TESSmesh *tessMeshUnion( TESSalloc* alloc, TESSmesh *mesh1, TESSmesh *mesh2 )
 		v1->prev = v2->prev;
 	}
 
-	if( e2->next != e2 ) {
-		e1->Sym->next->Sym->next = e2->next;
-		e2->next->Sym->next = e1->Sym->next;
-		e2->Sym->next->Sym->next = e1;
-		e1->Sym->next = e2->Sym->next;
+	if( e2Next != EDGE_HEAD ) {
+		NextEdge( mesh1, Sym(NextEdge( mesh1, Sym(e1) )) ) = e2Next;
+		NextEdge( mesh1, Sym(e2Next) ) = NextEdge( mesh1, Sym(e1) );
+		NextEdge( mesh1, Sym(e2SymNext) ) = e1;
+		NextEdge( mesh1, Sym(e1) ) = e2SymNext;
 	}
 
+	FreeEdgeArrays( alloc, mesh2 );
 	alloc->memfree( alloc->userData, mesh2 );
 	return mesh1;
 }
 
 
-static int CountFaceVerts( TESSface *f )
+static int CountFaceVerts( TESSmesh *mesh, TESSface *f )
 {
-	TESShalfEdge *eCur = f->anEdge;
+	TESShalfEdge eCur = f->anEdge;
 	int n = 0;
 	do
 	{
 		n++;
-		eCur = eCur->Lnext;
+		eCur = Lnext( mesh, eCur );
 	}
 	while (eCur != f->anEdge);
 	return n;
@@ -699,26 +910,24 @@ static int CountFaceVerts( TESSface *f )
 
 int tessMeshMergeConvexFaces( TESSmesh *mesh, int maxVertsPerFace )
 {
-	TESShalfEdge *e, *eNext, *eSym;
-	TESShalfEdge *eHead = &mesh->eHead;
+	TESShalfEdge e, eNext, eSym;
+	TESShalfEdge eHead = EDGE_HEAD;
 	TESSvertex *va, *vb, *vc, *vd, *ve, *vf;
 	int leftNv, rightNv;
 	
-	for( e = eHead->next; e != eHead; e = eNext )
+	for( e = NextEdge( mesh, eHead ); e != eHead; e = eNext )
 	{
-		eNext = e->next;
-		eSym = e->Sym;
-		if( !eSym )
-			continue;
+		eNext = NextEdge( mesh, e );
+		eSym = Sym(e);
 		
 		// Both faces must be inside
-		if( !e->Lface || !e->Lface->inside )
+		if( !Lface( mesh, e ) || !Lface( mesh, e )->inside )
 			continue;
-		if( !eSym->Lface || !eSym->Lface->inside )
+		if( !Lface( mesh, eSym ) || !Lface( mesh, eSym )->inside )
 			continue;
 
-		leftNv = CountFaceVerts( e->Lface );
-		rightNv = CountFaceVerts( eSym->Lface );
+		leftNv = CountFaceVerts( mesh, Lface( mesh, e ) );
+		rightNv = CountFaceVerts( mesh, Lface( mesh, eSym ) );
 		if( (leftNv+rightNv-2) > maxVertsPerFace )
 			continue;
 
@@ -730,16 +939,16 @@ int tessMeshMergeConvexFaces( TESSmesh *mesh, int maxVertsPerFace )
 		//          |v
 		//      va--vb--vc
 
-		va = e->Lprev->Org;
-		vb = e->Org;
-		vc = e->Sym->Lnext->Dst;
+		va = Org( mesh, Lprev( mesh, e ));
+		vb = Org( mesh, e );
+		vc = Dst( mesh, Lnext( mesh, Sym(e) ));
 
-		vd = e->Sym->Lprev->Org;
-		ve = e->Sym->Org;
-		vf = e->Lnext->Dst;
+		vd = Org( mesh, Lprev( mesh, Sym(e) ));
+		ve = Org( mesh, Sym(e) );
+		vf = Dst( mesh, Lnext( mesh, e ));
 
 		if( VertCCW( va, vb, vc ) && VertCCW( vd, ve, vf ) ) {
-			if( e == eNext || e == eNext->Sym ) { eNext = eNext->next; }
+			if( e == eNext || e == Sym(eNext) ) { eNext = NextEdge( mesh, eNext ); }
 			if( !tessMeshDelete( mesh, e ) )
 				return 0;
 		}
@@ -748,46 +957,46 @@ int tessMeshMergeConvexFaces( TESSmesh *mesh, int maxVertsPerFace )
 	return 1;
 }
 
-void tessMeshFlipEdge( TESSmesh *mesh, TESShalfEdge *edge )
+void tessMeshFlipEdge( TESSmesh *mesh, TESShalfEdge edge )
 {
-	TESShalfEdge *a0 = edge;
-	TESShalfEdge *a1 = a0->Lnext;
-	TESShalfEdge *a2 = a1->Lnext;
-	TESShalfEdge *b0 = edge->Sym;
-	TESShalfEdge *b1 = b0->Lnext;
-	TESShalfEdge *b2 = b1->Lnext;
-
-	TESSvertex *aOrg = a0->Org;
-	TESSvertex *aOpp = a2->Org;
-	TESSvertex *bOrg = b0->Org;
-	TESSvertex *bOpp = b2->Org;
-
-	TESSface *fa = a0->Lface;
-	TESSface *fb = b0->Lface;
-
-	assert(EdgeIsInternal(edge));
-	assert(a2->Lnext == a0);
-	assert(b2->Lnext == b0);
-
-	a0->Org = bOpp;
-	a0->Onext = b1->Sym;
-	b0->Org = aOpp;
-	b0->Onext = a1->Sym;
-	a2->Onext = b0;
-	b2->Onext = a0;
-	b1->Onext = a2->Sym;
-	a1->Onext = b2->Sym;
-
-	a0->Lnext = a2;
-	a2->Lnext = b1;
-	b1->Lnext = a0;
-
-	b0->Lnext = b2;
-	b2->Lnext = a1;
-	a1->Lnext = b0;
-
-	a1->Lface = fb;
-	b1->Lface = fa;
+	TESShalfEdge a0 = edge;
+	TESShalfEdge a1 = Lnext( mesh, a0 );
+	TESShalfEdge a2 = Lnext( mesh, a1 );
+	TESShalfEdge b0 = Sym(edge);
+	TESShalfEdge b1 = Lnext( mesh, b0 );
+	TESShalfEdge b2 = Lnext( mesh, b1 );
+
+	TESSvertex *aOrg = Org( mesh, a0 );
+	TESSvertex *aOpp = Org( mesh, a2 );
+	TESSvertex *bOrg = Org( mesh, b0 );
+	TESSvertex *bOpp = Org( mesh, b2 );
+
+	TESSface *fa = Lface( mesh, a0 );
+	TESSface *fb = Lface( mesh, b0 );
+
+	assert(EdgeIsInternal(mesh, edge));
+	assert(Lnext( mesh, a2 ) == a0);
+	assert(Lnext( mesh, b2 ) == b0);
+
+	Org( mesh, a0 ) = bOpp;
+	Onext( mesh, a0 ) = Sym(b1);
+	Org( mesh, b0 ) = aOpp;
+	Onext( mesh, b0 ) = Sym(a1);
+	Onext( mesh, a2 ) = b0;
+	Onext( mesh, b2 ) = a0;
+	Onext( mesh, b1 ) = Sym(a2);
+	Onext( mesh, a1 ) = Sym(b2);
+
+	Lnext( mesh, a0 ) = a2;
+	Lnext( mesh, a2 ) = b1;
+	Lnext( mesh, b1 ) = a0;
+
+	Lnext( mesh, b0 ) = b2;
+	Lnext( mesh, b2 ) = a1;
+	Lnext( mesh, a1 ) = b0;
+
+	Lface( mesh, a1 ) = fb;
+	Lface( mesh, b1 ) = fa;
 
 	fa->anEdge = a0;
 	fb->anEdge = b0;
@@ -795,35 +1004,35 @@ void tessMeshFlipEdge( TESSmesh *mesh, TESShalfEdge *edge )
 	if (aOrg->anEdge == a0) aOrg->anEdge = b1;
 	if (bOrg->anEdge == b0) bOrg->anEdge = a1;
 
-	assert( a0->Lnext->Onext->Sym == a0 );
-	assert( a0->Onext->Sym->Lnext == a0 );
-	assert( a0->Org->anEdge->Org == a0->Org );
+	assert( Sym(Onext( mesh, Lnext( mesh, a0 ) )) == a0 );
+	assert( Lnext( mesh, Sym(Onext( mesh, a0 )) ) == a0 );
+	assert( Org( mesh, Org( mesh, a0 )->anEdge ) == Org( mesh, a0 ) );
 
 
-	assert( a1->Lnext->Onext->Sym == a1 );
-	assert( a1->Onext->Sym->Lnext == a1 );
-	assert( a1->Org->anEdge->Org == a1->Org );
+	assert( Sym(Onext( mesh, Lnext( mesh, a1 ) )) == a1 );
+	assert( Lnext( mesh, Sym(Onext( mesh, a1 )) ) == a1 );
+	assert( Org( mesh, Org( mesh, a1 )->anEdge ) == Org( mesh, a1 ) );
 
-	assert( a2->Lnext->Onext->Sym == a2 );
-	assert( a2->Onext->Sym->Lnext == a2 );
-	assert( a2->Org->anEdge->Org == a2->Org );
+	assert( Sym(Onext( mesh, Lnext( mesh, a2 ) )) == a2 );
+	assert( Lnext( mesh, Sym(Onext( mesh, a2 )) ) == a2 );
+	assert( Org( mesh, Org( mesh, a2 )->anEdge ) == Org( mesh, a2 ) );
 
-	assert( b0->Lnext->Onext->Sym == b0 );
-	assert( b0->Onext->Sym->Lnext == b0 );
-	assert( b0->Org->anEdge->Org == b0->Org );
+	assert( Sym(Onext( mesh, Lnext( mesh, b0 ) )) == b0 );
+	assert( Lnext( mesh, Sym(Onext( mesh, b0 )) ) == b0 );
+	assert( Org( mesh, Org( mesh, b0 )->anEdge ) == Org( mesh, b0 ) );
 
-	assert( b1->Lnext->Onext->Sym == b1 );
-	assert( b1->Onext->Sym->Lnext == b1 );
-	assert( b1->Org->anEdge->Org == b1->Org );
+	assert( Sym(Onext( mesh, Lnext( mesh, b1 ) )) == b1 );
+	assert( Lnext( mesh, Sym(Onext( mesh, b1 )) ) == b1 );
+	assert( Org( mesh, Org( mesh, b1 )->anEdge ) == Org( mesh, b1 ) );
 
-	assert( b2->Lnext->Onext->Sym == b2 );
-	assert( b2->Onext->Sym->Lnext == b2 );
-	assert( b2->Org->anEdge->Org == b2->Org );
+	assert( Sym(Onext( mesh, Lnext( mesh, b2 ) )) == b2 );
+	assert( Lnext( mesh, Sym(Onext( mesh, b2 )) ) == b2 );
+	assert( Org( mesh, Org( mesh, b2 )->anEdge ) == Org( mesh, b2 ) );
 
-	assert(aOrg->anEdge->Org == aOrg);
-	assert(bOrg->anEdge->Org == bOrg);
+	assert(Org( mesh, aOrg->anEdge ) == aOrg);
+	assert(Org( mesh, bOrg->anEdge ) == bOrg);
 
-	assert(a0->Oprev->Onext->Org == a0->Org);
+	assert(Org( mesh, Onext( mesh, Oprev( mesh, a0 ))) == Org( mesh, a0 ));
 }
 
 #ifdef DELETE_BY_ZAPPING
@@ -835,10 +1044,11 @@ void tessMeshDeleteMesh( TESSalloc* alloc, TESSmesh *mesh )
 	TESSface *fHead = &mesh->fHead;
 
 	while( fHead->next != fHead ) {
-		tessMeshZapFace( fHead->next );
+		tessMeshZapFace( mesh, fHead->next );
 	}
 	assert( mesh->vHead.next == &mesh->vHead );
 
+	FreeEdgeArrays( alloc, mesh );
 	alloc->memfree( alloc->userData, mesh );
 }
 
@@ -848,7 +1058,7 @@ void tessMeshDeleteMesh( TESSalloc* alloc, TESSmesh *mesh )
 */
 void tessMeshDeleteMesh( TESSalloc* alloc, TESSmesh *mesh )
 {
-	deleteBucketAlloc(mesh->edgeBucket);
+	FreeEdgeArrays( alloc, mesh );
 	deleteBucketAlloc(mesh->vertexBucket);
 	deleteBucketAlloc(mesh->faceBucket);
 
@@ -857,6 +1067,24 @@ void tessMeshDeleteMesh( TESSalloc* alloc, TESSmesh *mesh )
 
 #endif
 
+/* tessMeshResetMesh( mesh, maxItems ) empties a mesh for reuse.  All
+* edges, vertices and faces are freed at once, instead of one by one.
+* The half-edge arrays are shrunk if they hold more than maxItems edges.
+*/
+void tessMeshResetMesh( TESSmesh *mesh, unsigned int maxItems )
+{
+	TESShalfEdge capacity = 2 * (TESShalfEdge)maxItems;
+
+	if (capacity < 16)
+		capacity = 16;
+	if (mesh->edgeCapacity > capacity)
+		ResizeEdges( mesh, capacity );
+	bucketReset( mesh->vertexBucket, maxItems );
+	bucketReset( mesh->faceBucket, maxItems );
+
+	InitMeshHeads( mesh );
+}
+
 #ifndef NDEBUG
 
 /* tessMeshCheckMesh( mesh ) checks a mesh for self-consistency.
@@ -865,53 +1093,48 @@ void tessMeshCheckMesh( TESSmesh *mesh )
 {
 	TESSface *fHead = &mesh->fHead;
 	TESSvertex *vHead = &mesh->vHead;
-	TESShalfEdge *eHead = &mesh->eHead;
+	TESShalfEdge eHead = EDGE_HEAD;
 	TESSface *f, *fPrev;
 	TESSvertex *v, *vPrev;
-	TESShalfEdge *e, *ePrev;
+	TESShalfEdge e, ePrev;
 
 	for( fPrev = fHead ; (f = fPrev->next) != fHead; fPrev = f) {
 		assert( f->prev == fPrev );
 		e = f->anEdge;
 		do {
-			assert( e->Sym != e );
-			assert( e->Sym->Sym == e );
-			assert( e->Lnext->Onext->Sym == e );
-			assert( e->Onext->Sym->Lnext == e );
-			assert( e->Lface == f );
-			e = e->Lnext;
+			assert( e > Sym(EDGE_HEAD) && e < mesh->edgeCount );
+			assert( Sym(Onext( mesh, Lnext( mesh, e ))) == e );
+			assert( Lnext( mesh, Sym(Onext( mesh, e ))) == e );
+			assert( Lface( mesh, e ) == f );
+			e = Lnext( mesh, e );
 		} while( e != f->anEdge );
 	}
-	assert( f->prev == fPrev && f->anEdge == NULL );
+	assert( f->prev == fPrev && f->anEdge == NULL_EDGE );
 
 	for( vPrev = vHead ; (v = vPrev->next) != vHead; vPrev = v) {
 		assert( v->prev == vPrev );
 		e = v->anEdge;
 		do {
-			assert( e->Sym != e );
-			assert( e->Sym->Sym == e );
-			assert( e->Lnext->Onext->Sym == e );
-			assert( e->Onext->Sym->Lnext == e );
-			assert( e->Org == v );
-			e = e->Onext;
+			assert( e > Sym(EDGE_HEAD) && e < mesh->edgeCount );
+			assert( Sym(Onext( mesh, Lnext( mesh, e ))) == e );
+			assert( Lnext( mesh, Sym(Onext( mesh, e ))) == e );
+			assert( Org( mesh, e ) == v );
+			e = Onext( mesh, e );
 		} while( e != v->anEdge );
 	}
-	assert( v->prev == vPrev && v->anEdge == NULL );
-
-	for( ePrev = eHead ; (e = ePrev->next) != eHead; ePrev = e) {
-		assert( e->Sym->next == ePrev->Sym );
-		assert( e->Sym != e );
-		assert( e->Sym->Sym == e );
-		assert( e->Org != NULL );
-		assert( e->Dst != NULL );
-		assert( e->Lnext->Onext->Sym == e );
-		assert( e->Onext->Sym->Lnext == e );
-	}
-	assert( e->Sym->next == ePrev->Sym
-		&& e->Sym == &mesh->eHeadSym
-		&& e->Sym->Sym == e
-		&& e->Org == NULL && e->Dst == NULL
-		&& e->Lface == NULL && e->Rface == NULL );
+	assert( v->prev == vPrev && v->anEdge == NULL_EDGE );
+
+	for( ePrev = eHead ; (e = NextEdge( mesh, ePrev )) != eHead; ePrev = e) {
+		assert( NextEdge( mesh, Sym(e) ) == Sym(ePrev) );
+		assert( e > Sym(EDGE_HEAD) && e < mesh->edgeCount );
+		assert( Org( mesh, e ) != NULL );
+		assert( Dst( mesh, e ) != NULL );
+		assert( Sym(Onext( mesh, Lnext( mesh, e ))) == e );
+		assert( Lnext( mesh, Sym(Onext( mesh, e ))) == e );
+	}
+	assert( NextEdge( mesh, Sym(e) ) == Sym(ePrev)
+		&& Org( mesh, e ) == NULL && Dst( mesh, e ) == NULL
+		&& Lface( mesh, e ) == NULL && Rface( mesh, e ) == NULL );
 }
 
-#endif
\ No newline at end of file
+#endif
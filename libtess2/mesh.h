@@ -32,12 +32,12 @@
 #ifndef MESH_H
 #define MESH_H
 
-#include "tesselator.h"
+#include "tessnames.h"
 
 typedef struct TESSmesh TESSmesh; 
 typedef struct TESSvertex TESSvertex;
 typedef struct TESSface TESSface;
-typedef struct TESShalfEdge TESShalfEdge;
+typedef unsigned int TESShalfEdge;
 typedef struct ActiveRegion ActiveRegion;
 
 /* The mesh structure is similar in spirit, notation, and operations
@@ -53,11 +53,19 @@ typedef struct ActiveRegion ActiveRegion;
 *
 * The fundamental data structure is the "half-edge".  Two half-edges
 * go together to make an edge, but they point in opposite directions.
-* Each half-edge has a pointer to its mate (the "symmetric" half-edge Sym),
-* its origin vertex (Org), the face on its left side (Lface), and the
-* adjacent half-edges in the CCW direction around the origin vertex
-* (Onext) and around the left face (Lnext).  There is also a "next"
-* pointer for the global edge list (see below).
+* Each half-edge has a mate (the "symmetric" half-edge Sym), an origin
+* vertex (Org), a face on its left side (Lface), and adjacent half-edges
+* in the CCW direction around the origin vertex (Onext) and around the
+* left face (Lnext).  There is also a "next" link for the global edge
+* list (see below).
+*
+* Half-edges are not separate records.  Each field of the half-edges is
+* an array in TESSmesh, and a half-edge (TESShalfEdge) is a 32-bit index
+* into these arrays.  The two halves of an edge always have the indices
+* 2i and 2i+1, so the mate of e is e^1 and is not stored at all.  The
+* pair 0,1 is never used, which lets 0 stand for "no half-edge" the way
+* a NULL pointer would.  The fields are read and written through the
+* macros below, eg. Lnext(mesh,e) where the original code had e->Lnext.
 *
 * The notation used for mesh navigation:
 *  Sym   = the mate of a half-edge (same edge, but opposite direction)
@@ -73,20 +81,20 @@ typedef struct ActiveRegion ActiveRegion;
 * The mesh stores pointers to these dummy headers (vHead, fHead, eHead).
 *
 * The circular edge list is special; since half-edges always occur
-* in pairs (e and e->Sym), each half-edge stores a pointer in only
-* one direction.  Starting at eHead and following the e->next pointers
-* will visit each *edge* once (ie. e or e->Sym, but not both).
-* e->Sym stores a pointer in the opposite direction, thus it is
-* always true that e->Sym->next->Sym->next == e.
+* in pairs (e and Sym(e)), each half-edge stores a link in only
+* one direction.  Starting at EDGE_HEAD and following NextEdge(mesh,e)
+* will visit each *edge* once (ie. e or Sym(e), but not both).
+* Sym(e) stores a link in the opposite direction, thus it is always
+* true that NextEdge(mesh,Sym(NextEdge(mesh,Sym(e)))) == e.
 *
 * Each vertex has a pointer to next and previous vertices in the
 * circular list, and a pointer to a half-edge with this vertex as
-* the origin (NULL if this is the dummy header).  There is also a
+* the origin (NULL_EDGE if this is the dummy header).  There is also a
 * field "data" for client data.
 *
 * Each face has a pointer to the next and previous faces in the
 * circular list, and a pointer to a half-edge with this face as
-* the left face (NULL if this is the dummy header).  There is also
+* the left face (NULL_EDGE if this is the dummy header).  There is also
 * a field "data" for client data.
 *
 * Note that what we call a "face" is really a loop; faces may consist
@@ -109,11 +117,14 @@ typedef struct ActiveRegion ActiveRegion;
 struct TESSvertex {
 	TESSvertex *next;      /* next vertex (never NULL) */
 	TESSvertex *prev;      /* previous vertex (never NULL) */
-	TESShalfEdge *anEdge;    /* a half-edge with this origin */
+	TESShalfEdge anEdge;    /* a half-edge with this origin */
 
 	/* Internal data (keep hidden) */
+#ifndef TESS_2D_ONLY
 	TESSreal coords[3];  /* vertex location in 3D */
-	TESSreal s, t;       /* projection onto the sweep plane */
+#endif
+	TESSreal s, t;       /* projection onto the sweep plane, or the
+						 * vertex location itself with TESS_2D_ONLY */
 	int pqHandle;   /* to allow deletion from priority queue */
 	TESSindex n;			/* to allow identify unique vertices */
 	TESSindex idx;			/* to allow map result to original verts */
@@ -122,7 +133,7 @@ struct TESSvertex {
 struct TESSface {
 	TESSface *next;      /* next face (never NULL) */
 	TESSface *prev;      /* previous face (never NULL) */
-	TESShalfEdge *anEdge;    /* a half edge with this left face */
+	TESShalfEdge anEdge;    /* a half edge with this left face */
 
 	/* Internal data (keep hidden) */
 	TESSface *trail;     /* "stack" for conversion to strips */
@@ -131,40 +142,56 @@ struct TESSface {
 	char inside;     /* this face is in the polygon interior */
 };
 
-struct TESShalfEdge {
-	TESShalfEdge *next;      /* doubly-linked list (prev==Sym->next) */
-	TESShalfEdge *Sym;       /* same edge, opposite direction */
-	TESShalfEdge *Onext;     /* next edge CCW around origin */
-	TESShalfEdge *Lnext;     /* next edge CCW around left face */
-	TESSvertex *Org;       /* origin vertex (Overtex too long) */
-	TESSface *Lface;     /* left face */
+#define NULL_EDGE	0	/* no half-edge */
+#define EDGE_HEAD	2	/* dummy header for edge list, 3 is its Sym */
 
-	/* Internal data (keep hidden) */
-	ActiveRegion *activeRegion;  /* a region with this upper edge (sweep.c) */
-	int winding;    /* change in winding number when crossing
-						  from the right face to the left face */
-	int mark; /* Used by the Edge Flip algorithm */
-};
+#define Sym(e)	((e) ^ 1)	/* same edge, opposite direction */
+#define NextEdge(m,e)	((m)->eNext[e])	/* doubly-linked list (prev==Sym->next) */
+#define Onext(m,e)	((m)->eOnext[e])	/* next edge CCW around origin */
+#define Lnext(m,e)	((m)->eLnext[e])	/* next edge CCW around left face */
+#define Org(m,e)	((m)->eOrg[e])	/* origin vertex (Overtex too long) */
+#define Lface(m,e)	((m)->eLface[e])	/* left face */
+
+/* Internal data (keep hidden) */
+#define EdgeRegion(m,e)	((m)->eRegion[e])	/* a region with this upper edge (sweep.c) */
+#define Winding(m,e)	((m)->eWinding[e])	/* change in winding number when crossing
+										from the right face to the left face */
+#define EdgeMark(m,e)	((m)->eMark[e])	/* Used by the Edge Flip algorithm */
 
-#define Rface   Sym->Lface
-#define Dst Sym->Org
+#define Rface(m,e)	Lface(m,Sym(e))
+#define Dst(m,e)	Org(m,Sym(e))
 
-#define Oprev   Sym->Lnext
-#define Lprev   Onext->Sym
-#define Dprev   Lnext->Sym
-#define Rprev   Sym->Onext
-#define Dnext   Rprev->Sym  /* 3 pointers */
-#define Rnext   Oprev->Sym  /* 3 pointers */
+#define Oprev(m,e)	Lnext(m,Sym(e))
+#define Lprev(m,e)	Sym(Onext(m,e))
+#define Dprev(m,e)	Sym(Lnext(m,e))
+#define Rprev(m,e)	Onext(m,Sym(e))
+#define Dnext(m,e)	Sym(Rprev(m,e))	/* 2 lookups */
+#define Rnext(m,e)	Sym(Oprev(m,e))	/* 2 lookups */
 
 struct TESSmesh {
 	TESSvertex vHead;      /* dummy header for vertex list */
 	TESSface fHead;      /* dummy header for face list */
-	TESShalfEdge eHead;      /* dummy header for edge list */
-	TESShalfEdge eHeadSym;   /* and its symmetric counterpart */
 
-	struct BucketAlloc* edgeBucket;
+	/* The half-edge fields, indexed by TESShalfEdge (see above) */
+	TESShalfEdge *eNext;
+	TESShalfEdge *eOnext;
+	TESShalfEdge *eLnext;
+	TESSvertex **eOrg;
+	TESSface **eLface;
+	ActiveRegion **eRegion;
+	int *eWinding;
+	unsigned char *eMark;
+
+	TESShalfEdge edgeCount;	/* half-edges handed out so far, incl. 0 to 3 */
+	TESShalfEdge edgeCapacity;	/* length of the arrays above */
+	TESShalfEdge freeEdges;	/* freed pairs, linked by eNext, or NULL_EDGE */
+
+	TESSalloc *alloc;
 	struct BucketAlloc* vertexBucket;
 	struct BucketAlloc* faceBucket;
+
+	int relabelSmallerLoop;	/* when a loop is split or two loops are joined,
+							 * relabel only the smaller one (see below) */
 };
 
 /* The mesh operations below have three motivations: completeness,
@@ -181,6 +208,14 @@ struct TESSmesh {
 * Other internal data (v->data, v->activeRegion, f->data, f->marked,
 * f->trail, e->winding) is set to zero.
 *
+* Splitting or joining loops relabels the left face of every edge on one
+* of them, which makes these operations linear in the loop size.  While
+* mesh->relabelSmallerLoop is set, the smaller loop is relabeled instead,
+* by moving face records around: the face list keeps the same order and
+* contents, but a TESSface pointer held across an operation may end up
+* describing the other loop, or may have been freed.  Only set it while
+* no face pointers are held, as during the sweep.
+*
 * ********************** Basic Edge Operations **************************
 *
 * tessMeshMakeEdge( mesh ) creates one edge, two vertices, and a loop.
@@ -234,6 +269,9 @@ struct TESSmesh {
 *
 * tessMeshDeleteMesh( mesh ) will free all storage for any valid mesh.
 *
+* tessMeshResetMesh( mesh, maxItems ) empties a mesh, while keeping enough
+* of its storage for maxItems edges, vertices and faces for reuse.
+*
 * tessMeshZapFace( fZap ) destroys a face and removes it from the
 * global face list.  All edges of fZap will have a NULL pointer as their
 * left face.  Any edges which also have a NULL pointer as their right face
@@ -244,23 +282,25 @@ struct TESSmesh {
 * tessMeshCheckMesh( mesh ) checks a mesh for self-consistency.
 */
 
-TESShalfEdge *tessMeshMakeEdge( TESSmesh *mesh );
-int tessMeshSplice( TESSmesh *mesh, TESShalfEdge *eOrg, TESShalfEdge *eDst );
-int tessMeshDelete( TESSmesh *mesh, TESShalfEdge *eDel );
+TESShalfEdge tessMeshMakeEdge( TESSmesh *mesh );
+int tessMeshSplice( TESSmesh *mesh, TESShalfEdge eOrg, TESShalfEdge eDst );
+int tessMeshDelete( TESSmesh *mesh, TESShalfEdge eDel );
 
-TESShalfEdge *tessMeshAddEdgeVertex( TESSmesh *mesh, TESShalfEdge *eOrg );
-TESShalfEdge *tessMeshSplitEdge( TESSmesh *mesh, TESShalfEdge *eOrg );
-TESShalfEdge *tessMeshConnect( TESSmesh *mesh, TESShalfEdge *eOrg, TESShalfEdge *eDst );
+TESShalfEdge tessMeshAddEdgeVertex( TESSmesh *mesh, TESShalfEdge eOrg );
+TESShalfEdge tessMeshSplitEdge( TESSmesh *mesh, TESShalfEdge eOrg );
+TESShalfEdge tessMeshConnect( TESSmesh *mesh, TESShalfEdge eOrg, TESShalfEdge eDst );
 
 TESSmesh *tessMeshNewMesh( TESSalloc* alloc );
 TESSmesh *tessMeshUnion( TESSalloc* alloc, TESSmesh *mesh1, TESSmesh *mesh2 );
 int tessMeshMergeConvexFaces( TESSmesh *mesh, int maxVertsPerFace );
 void tessMeshDeleteMesh( TESSalloc* alloc, TESSmesh *mesh );
+void tessMeshResetMesh( TESSmesh *mesh, unsigned int maxItems );
 void tessMeshZapFace( TESSmesh *mesh, TESSface *fZap );
 
-void tessMeshFlipEdge( TESSmesh *mesh, TESShalfEdge *edge );
+void tessMeshFlipEdge( TESSmesh *mesh, TESShalfEdge edge );
 
 #ifdef NDEBUG
+#undef tessMeshCheckMesh	/* the TESS_NAME mapping from tessnames.h */
 #define tessMeshCheckMesh( mesh )
 #else
 void tessMeshCheckMesh( TESSmesh *mesh );
@@ -31,6 +31,7 @@
 
 //#include "tesos.h"
 #include <stddef.h>
+#include <string.h>
 #include <assert.h>
 #include "tesselator.h"
 #include "priorityq.h"
@@ -313,20 +314,83 @@ PriorityQ *pqNewPriorityQ( TESSalloc* alloc, int size, int (*leq)(PQkey key1, PQ
 		return NULL;
 	}
 
+	pq->order = NULL;
+	pq->radix = NULL;
+	pq->radixCapacity = 0;
 	pq->size = 0;
 	pq->max = size; //INIT_SIZE;
+	pq->keysCapacity = size;
+	pq->orderCapacity = 0;
 	pq->initialized = FALSE;
 	pq->leq = leq;
 	
 	return pq;
 }
 
+/* really tessPqSortReset */
+int pqReset( TESSalloc* alloc, PriorityQ *pq, int size )
+{
+	PriorityQHeap *heap = pq->heap;
+
+	if( pq->keysCapacity < size ) {
+		PQkey *keys = (PQkey *)alloc->memalloc( alloc->userData, size * sizeof(pq->keys[0]) );
+		if (keys == NULL) return 0;
+		alloc->memfree( alloc->userData, pq->keys );
+		pq->keys = keys;
+		pq->keysCapacity = size;
+	}
+
+	pq->size = 0;
+	pq->max = pq->keysCapacity;
+	pq->initialized = FALSE;
+
+	/* The heap normally only holds the vertices created at intersections,
+	* but it starts out as large as the sorted array, so that allocators
+	* without memrealloc() can still tesselate as many vertices as before.
+	*/
+	if( heap->max < size ) {
+		PQnode *nodes = (PQnode *)alloc->memalloc( alloc->userData, (size + 1) * sizeof(heap->nodes[0]) );
+		PQhandleElem *handles = (PQhandleElem *)alloc->memalloc( alloc->userData, (size + 1) * sizeof(heap->handles[0]) );
+		if (nodes == NULL || handles == NULL) {
+			if (nodes != NULL) alloc->memfree( alloc->userData, nodes );
+			if (handles != NULL) alloc->memfree( alloc->userData, handles );
+			return 0;
+		}
+		alloc->memfree( alloc->userData, heap->nodes );
+		alloc->memfree( alloc->userData, heap->handles );
+		heap->nodes = nodes;
+		heap->handles = handles;
+		heap->max = size;
+	}
+	heap->size = 0;
+	heap->freeList = 0;
+	heap->initialized = FALSE;
+	heap->nodes[1].handle = 1;	/* so that Minimum() returns NULL */
+	heap->handles[1].key = NULL;
+
+	return 1;
+}
+
+/* really tessPqSortCapacity */
+int pqCapacity( PriorityQ *pq )
+{
+	int capacity = pq->keysCapacity;
+	if (pq->orderCapacity > capacity)
+		capacity = pq->orderCapacity;
+	if (pq->radixCapacity > capacity)
+		capacity = pq->radixCapacity;
+	if (pq->heap->max > capacity)
+		capacity = pq->heap->max;
+	return capacity;
+}
+
 /* really tessPqSortDeletePriorityQ */
 void pqDeletePriorityQ( TESSalloc* alloc, PriorityQ *pq )
 {
 	assert(pq != NULL); 
 	if (pq->heap != NULL) pqHeapDeletePriorityQ( alloc, pq->heap );
 	if (pq->order != NULL) alloc->memfree( alloc->userData, pq->order );
+	if (pq->radix != NULL) alloc->memfree( alloc->userData, pq->radix );
 	if (pq->keys != NULL) alloc->memfree( alloc->userData, pq->keys );
 	alloc->memfree( alloc->userData, pq );
 }
@@ -336,28 +400,13 @@ void pqDeletePriorityQ( TESSalloc* alloc, PriorityQ *pq )
 #define GT(x,y)     (! LEQ(x,y))
 #define Swap(a,b)   if(1){PQkey *tmp = *a; *a = *b; *b = tmp;}else
 
-/* really tessPqSortInit */
-int pqInit( TESSalloc* alloc, PriorityQ *pq )
+/* Sorts pq->order in descending order, using randomized Quicksort. */
+static void QuickSortOrder( PriorityQ *pq )
 {
 	PQkey **p, **r, **i, **j, *piv;
 	struct { PQkey **p, **r; } Stack[50], *top = Stack;
 	unsigned int seed = 2016473283;
 
-	/* Create an array of indirect pointers to the keys, so that we
-	* the handles we have returned are still valid.
-	*/
-	/*
-	pq->order = (PQkey **)memAlloc( (size_t)
-	(pq->size * sizeof(pq->order[0])) );
-	*/
-	pq->order = (PQkey **)alloc->memalloc( alloc->userData,
-										  (size_t)((pq->size+1) * sizeof(pq->order[0])) );
-	/* the previous line is a patch to compensate for the fact that IBM */
-	/* machines return a null on a malloc of zero bytes (unlike SGI),   */
-	/* so we have to put in this defense to guard against a memory      */
-	/* fault four lines down. from fossum@austin.ibm.com.               */
-	if (pq->order == NULL) return 0;
-
 	p = pq->order;
 	r = p + pq->size - 1;
 	for( piv = pq->keys, i = p; i <= r; ++piv, ++i ) {
@@ -402,6 +451,154 @@ int pqInit( TESSalloc* alloc, PriorityQ *pq )
 			*j = piv;
 		}
 	}
+}
+
+#ifndef FOR_TRITE_TEST_PROGRAM
+
+/* Below this many keys the Quicksort is faster than the radix sort, whose
+* cost includes clearing and summing the digit histograms.
+*/
+#define RADIX_SORT_MIN_SIZE	64
+
+/* Maps a coordinate to an unsigned integer with the same ordering, by
+* flipping the sign bit of positive values and all bits of negative ones.
+*/
+#if defined(TESS_USE_DOUBLE) || defined(TESS_USE_FIXED)
+typedef unsigned long long PQrealBits;
+#else
+typedef unsigned int PQrealBits;
+#endif
+
+static PQrealBits SortableBits( TESSreal x )
+{
+	const PQrealBits signBit = (PQrealBits)1 << (8*sizeof(PQrealBits) - 1);
+	union { TESSreal f; PQrealBits u; } bits;
+
+	/* -0 and +0 compare equal, so they must map to the same value. */
+	bits.f = (x == 0) ? 0 : x;
+	return (bits.u & signBit) ? ~bits.u : (bits.u | signBit);
+}
+
+/* Stable LSD radix sort of the n items in "items" on their 64-bit keys,
+* using "tmp" as scratch space.  The histograms of all eight digits are
+* gathered in a single pass, and digits which are the same for all keys
+* are skipped.  Returns the buffer which holds the sorted items.
+*/
+static PQradixItem *RadixSortItems( PQradixItem *items, PQradixItem *tmp, int n )
+{
+	PQradixItem *swap;
+	int count[8][256];
+	int digit, i, sum, c;
+
+	memset( count, 0, sizeof(count) );
+	for( i = 0; i < n; ++i ) {
+		for( digit = 0; digit < 8; ++digit )
+			++count[digit][(items[i].key >> (8*digit)) & 0xff];
+	}
+
+	for( digit = 0; digit < 8; ++digit ) {
+		if( count[digit][(items[0].key >> (8*digit)) & 0xff] == n )
+			continue;
+
+		sum = 0;
+		for( i = 0; i < 256; ++i ) {
+			c = count[digit][i];
+			count[digit][i] = sum;
+			sum += c;
+		}
+		for( i = 0; i < n; ++i )
+			tmp[count[digit][(items[i].key >> (8*digit)) & 0xff]++] = items[i];
+
+		swap = items; items = tmp; tmp = swap;
+	}
+	return items;
+}
+
+/* Sorts pq->order in descending order with a radix sort on the (s, t) key
+* of each vertex, which orders vertices exactly like VertLeq.  With float
+* coordinates both fit in a single 64-bit key, with double coordinates the
+* vertices are sorted on t first, and then stably on s.
+*/
+static int RadixSortOrder( TESSalloc* alloc, PriorityQ *pq )
+{
+	int n = pq->size;
+	PQradixItem *items;
+	TESSvertex *v;
+	int i;
+
+	if( pq->radixCapacity < n ) {
+		if (pq->radix != NULL) alloc->memfree( alloc->userData, pq->radix );
+		pq->radixCapacity = 0;
+		pq->radix = (PQradixItem *)alloc->memalloc( alloc->userData, (size_t)(2 * n * sizeof(pq->radix[0])) );
+		if (pq->radix == NULL) return 0;
+		pq->radixCapacity = n;
+	}
+	items = pq->radix;
+
+	for( i = 0; i < n; ++i ) {
+		v = (TESSvertex *)pq->keys[i];
+#if defined(TESS_USE_DOUBLE) || defined(TESS_USE_FIXED)
+		items[i].key = SortableBits( v->t );
+#else
+		items[i].key = ((unsigned long long)SortableBits( v->s ) << 32) | SortableBits( v->t );
+#endif
+		items[i].index = i;
+	}
+	items = RadixSortItems( items, items == pq->radix ? pq->radix + n : pq->radix, n );
+
+#if defined(TESS_USE_DOUBLE) || defined(TESS_USE_FIXED)
+	for( i = 0; i < n; ++i ) {
+		v = (TESSvertex *)pq->keys[items[i].index];
+		items[i].key = SortableBits( v->s );
+	}
+	items = RadixSortItems( items, items == pq->radix ? pq->radix + n : pq->radix, n );
+#endif
+
+	/* The minimum goes at the end of the order array. */
+	for( i = 0; i < n; ++i )
+		pq->order[n-1-i] = &pq->keys[items[i].index];
+
+	return 1;
+}
+
+#endif
+
+/* really tessPqSortInit */
+int pqInit( TESSalloc* alloc, PriorityQ *pq )
+{
+#ifndef NDEBUG
+	PQkey **p, **r, **i;
+#endif
+
+	/* Create an array of indirect pointers to the keys, so that we
+	* the handles we have returned are still valid.
+	*/
+	/*
+	pq->order = (PQkey **)memAlloc( (size_t)
+	(pq->size * sizeof(pq->order[0])) );
+	*/
+	if( pq->orderCapacity < pq->size+1 ) {
+		if (pq->order != NULL) alloc->memfree( alloc->userData, pq->order );
+		pq->orderCapacity = 0;
+		pq->order = (PQkey **)alloc->memalloc( alloc->userData,
+											  (size_t)((pq->size+1) * sizeof(pq->order[0])) );
+		/* the previous line is a patch to compensate for the fact that IBM */
+		/* machines return a null on a malloc of zero bytes (unlike SGI),   */
+		/* so we have to put in this defense to guard against a memory      */
+		/* fault four lines down. from fossum@austin.ibm.com.               */
+		if (pq->order == NULL) return 0;
+		pq->orderCapacity = pq->size+1;
+	}
+
+#ifndef FOR_TRITE_TEST_PROGRAM
+	if( pq->size >= RADIX_SORT_MIN_SIZE ) {
+		if (!RadixSortOrder( alloc, pq )) return 0;
+	} else
+#endif
+	{
+		QuickSortOrder( pq );
+	}
+
 	pq->max = pq->size;
 	pq->initialized = TRUE;
 	pqHeapInit( pq->heap );  /* always succeeds */
@@ -443,6 +640,7 @@ PQhandle pqInsert( TESSalloc* alloc, PriorityQ *pq, PQkey keyNew )
 				pq->keys = saveKey;  // restore ptr to free upon return 
 				return INV_HANDLE;
 			}
+			pq->keysCapacity = pq->max;
 		}
 	}
 	assert(curr != INV_HANDLE); 
@@ -32,6 +32,8 @@
 #ifndef PRIORITYQ_H
 #define PRIORITYQ_H
 
+#include "tessnames.h"
+
 /* The basic operations are insertion of a new key (pqInsert),
 * and examination/extraction of a key whose value is minimum
 * (pqMinimum/pqExtractMin).  Deletion is also allowed (pqDelete);
@@ -79,12 +81,17 @@ struct PriorityQHeap {
 
 typedef struct PriorityQ PriorityQ;
 
+/* Sort key and position of a key in the sorted array, used by pqInit. */
+typedef struct { unsigned long long key; int index; } PQradixItem;
+
 struct PriorityQ {
 	PriorityQHeap *heap;
 
 	PQkey *keys;
 	PQkey **order;
+	PQradixItem *radix;	/* scratch space for sorting the keys */
 	PQhandle size, max;
+	int keysCapacity, orderCapacity, radixCapacity;
 	int initialized;
 
 	int (*leq)(PQkey key1, PQkey key2);
@@ -93,6 +100,14 @@ struct PriorityQ {
 PriorityQ *pqNewPriorityQ( TESSalloc* alloc, int size, int (*leq)(PQkey key1, PQkey key2) );
 void pqDeletePriorityQ( TESSalloc* alloc, PriorityQ *pq );
 
+/* pqReset empties the queue so that it can be filled again with pqInsert,
+* reusing its arrays.  Room for at least size keys is reserved.  Returns 0
+* if out of memory.  pqCapacity returns the largest number of keys any of
+* the arrays of the queue can currently hold.
+*/
+int pqReset( TESSalloc* alloc, PriorityQ *pq, int size );
+int pqCapacity( PriorityQ *pq );
+
 int pqInit( TESSalloc* alloc, PriorityQ *pq );
 PQhandle pqInsert( TESSalloc* alloc, PriorityQ *pq, PQkey key );
 PQkey pqExtractMin( PriorityQ *pq );
@@ -86,8 +86,8 @@ extern void DebugEvent( TESStesselator *tess );
 /* When we merge two edges into one, we need to compute the combined
 * winding of the new edge.
 */
-#define AddWinding(eDst,eSrc)	(eDst->winding += eSrc->winding, \
-	eDst->Sym->winding += eSrc->Sym->winding)
+#define AddWinding(m,eDst,eSrc)	(Winding( m, eDst ) += Winding( m, eSrc ), \
+	Winding( m, Sym(eDst) ) += Winding( m, Sym(eSrc) ))
 
 static void SweepEvent( TESStesselator *tess, TESSvertex *vEvent );
 static void WalkDirtyRegions( TESStesselator *tess, ActiveRegion *regUp );
@@ -106,101 +106,108 @@ static int EdgeLeq( TESStesselator *tess, ActiveRegion *reg1, ActiveRegion *reg2
 * we sort the edges by slope (they would otherwise compare equally).
 */
 {
+	TESSmesh *mesh = tess->mesh;
 	TESSvertex *event = tess->event;
-	TESShalfEdge *e1, *e2;
+	TESShalfEdge e1, e2;
 	TESSreal t1, t2;
 
+	tess->stats.edgeComparisons++;
+
 	e1 = reg1->eUp;
 	e2 = reg2->eUp;
 
-	if( e1->Dst == event ) {
-		if( e2->Dst == event ) {
+	if( Dst( mesh, e1 ) == event ) {
+		if( Dst( mesh, e2 ) == event ) {
 			/* Two edges right of the sweep line which meet at the sweep event.
 			* Sort them by slope.
 			*/
-			if( VertLeq( e1->Org, e2->Org )) {
-				return EdgeSign( e2->Dst, e1->Org, e2->Org ) <= 0;
+			if( VertLeq( Org( mesh, e1 ), Org( mesh, e2 ) )) {
+				return EdgeSign( Dst( mesh, e2 ), Org( mesh, e1 ), Org( mesh, e2 ) ) <= 0;
 			}
-			return EdgeSign( e1->Dst, e2->Org, e1->Org ) >= 0;
+			return EdgeSign( Dst( mesh, e1 ), Org( mesh, e2 ), Org( mesh, e1 ) ) >= 0;
 		}
-		return EdgeSign( e2->Dst, event, e2->Org ) <= 0;
+		return EdgeSign( Dst( mesh, e2 ), event, Org( mesh, e2 ) ) <= 0;
 	}
-	if( e2->Dst == event ) {
-		return EdgeSign( e1->Dst, event, e1->Org ) >= 0;
+	if( Dst( mesh, e2 ) == event ) {
+		return EdgeSign( Dst( mesh, e1 ), event, Org( mesh, e1 ) ) >= 0;
 	}
 
 	/* General case - compute signed distance *from* e1, e2 to event */
-	t1 = EdgeEval( e1->Dst, event, e1->Org );
-	t2 = EdgeEval( e2->Dst, event, e2->Org );
+	t1 = EdgeEval( Dst( mesh, e1 ), event, Org( mesh, e1 ) );
+	t2 = EdgeEval( Dst( mesh, e2 ), event, Org( mesh, e2 ) );
 	return (t1 >= t2);
 }
 
 
 static void DeleteRegion( TESStesselator *tess, ActiveRegion *reg )
 {
+	TESSmesh *mesh = tess->mesh;
 	if( reg->fixUpperEdge ) {
 		/* It was created with zero winding number, so it better be
 		* deleted with zero winding number (ie. it better not get merged
 		* with a real edge).
 		*/
-		assert( reg->eUp->winding == 0 );
+		assert( Winding( mesh, reg->eUp ) == 0 );
 	}
-	reg->eUp->activeRegion = NULL;
+	EdgeRegion( mesh, reg->eUp ) = NULL;
 	dictDelete( tess->dict, reg->nodeUp );
 	bucketFree( tess->regionPool, reg );
 }
 
 
-static int FixUpperEdge( TESStesselator *tess, ActiveRegion *reg, TESShalfEdge *newEdge )
+static int FixUpperEdge( TESStesselator *tess, ActiveRegion *reg, TESShalfEdge newEdge )
 /*
 * Replace an upper edge which needs fixing (see ConnectRightVertex).
 */
 {
+	TESSmesh *mesh = tess->mesh;
 	assert( reg->fixUpperEdge );
 	if ( !tessMeshDelete( tess->mesh, reg->eUp ) ) return 0;
 	reg->fixUpperEdge = FALSE;
 	reg->eUp = newEdge;
-	newEdge->activeRegion = reg;
+	EdgeRegion( mesh, newEdge ) = reg;
 
 	return 1; 
 }
 
 static ActiveRegion *TopLeftRegion( TESStesselator *tess, ActiveRegion *reg )
 {
-	TESSvertex *org = reg->eUp->Org;
-	TESShalfEdge *e;
+	TESSmesh *mesh = tess->mesh;
+	TESSvertex *org = Org( mesh, reg->eUp );
+	TESShalfEdge e;
 
 	/* Find the region above the uppermost edge with the same origin */
 	do {
 		reg = RegionAbove( reg );
-	} while( reg->eUp->Org == org );
+	} while( Org( mesh, reg->eUp ) == org );
 
 	/* If the edge above was a temporary edge introduced by ConnectRightVertex,
 	* now is the time to fix it.
 	*/
 	if( reg->fixUpperEdge ) {
-		e = tessMeshConnect( tess->mesh, RegionBelow(reg)->eUp->Sym, reg->eUp->Lnext );
-		if (e == NULL) return NULL;
+		e = tessMeshConnect( tess->mesh, Sym(RegionBelow(reg)->eUp), Lnext( mesh, reg->eUp ) );
+		if (e == NULL_EDGE) return NULL;
 		if ( !FixUpperEdge( tess, reg, e ) ) return NULL;
 		reg = RegionAbove( reg );
 	}
 	return reg;
 }
 
-static ActiveRegion *TopRightRegion( ActiveRegion *reg )
+static ActiveRegion *TopRightRegion( TESStesselator *tess, ActiveRegion *reg )
 {
-	TESSvertex *dst = reg->eUp->Dst;
+	TESSmesh *mesh = tess->mesh;
+	TESSvertex *dst = Dst( mesh, reg->eUp );
 
 	/* Find the region above the uppermost edge with the same destination */
 	do {
 		reg = RegionAbove( reg );
-	} while( reg->eUp->Dst == dst );
+	} while( Dst( mesh, reg->eUp ) == dst );
 	return reg;
 }
 
 static ActiveRegion *AddRegionBelow( TESStesselator *tess,
 									ActiveRegion *regAbove,
-									TESShalfEdge *eNewUp )
+									TESShalfEdge eNewUp )
 /*
 * Add a new active region to the sweep line, *somewhere* below "regAbove"
 * (according to where the new edge belongs in the sweep-line dictionary).
@@ -208,6 +215,7 @@ static ActiveRegion *AddRegionBelow( TESStesselator *tess,
 * Winding number and "inside" flag are not updated.
 */
 {
+	TESSmesh *mesh = tess->mesh;
 	ActiveRegion *regNew = (ActiveRegion *)bucketAlloc( tess->regionPool );
 	if (regNew == NULL) longjmp(tess->env,1);
 
@@ -218,7 +226,7 @@ static ActiveRegion *AddRegionBelow( TESStesselator *tess,
 	regNew->sentinel = FALSE;
 	regNew->dirty = FALSE;
 
-	eNewUp->activeRegion = regNew;
+	EdgeRegion( mesh, eNewUp ) = regNew;
 	return regNew;
 }
 
@@ -246,7 +254,8 @@ static int IsWindingInside( TESStesselator *tess, int n )
 
 static void ComputeWinding( TESStesselator *tess, ActiveRegion *reg )
 {
-	reg->windingNumber = RegionAbove(reg)->windingNumber + reg->eUp->winding;
+	TESSmesh *mesh = tess->mesh;
+	reg->windingNumber = RegionAbove(reg)->windingNumber + Winding( mesh, reg->eUp );
 	reg->inside = IsWindingInside( tess, reg->windingNumber );
 }
 
@@ -260,8 +269,9 @@ static void FinishRegion( TESStesselator *tess, ActiveRegion *reg )
 * changing, this face may not have even existed until now).
 */
 {
-	TESShalfEdge *e = reg->eUp;
-	TESSface *f = e->Lface;
+	TESSmesh *mesh = tess->mesh;
+	TESShalfEdge e = reg->eUp;
+	TESSface *f = Lface( mesh, e );
 
 	f->inside = reg->inside;
 	f->anEdge = e;   /* optimization for tessMeshTessellateMonoRegion() */
@@ -269,7 +279,7 @@ static void FinishRegion( TESStesselator *tess, ActiveRegion *reg )
 }
 
 
-static TESShalfEdge *FinishLeftRegions( TESStesselator *tess,
+static TESShalfEdge FinishLeftRegions( TESStesselator *tess,
 									  ActiveRegion *regFirst, ActiveRegion *regLast )
 /*
 * We are given a vertex with one or more left-going edges.  All affected
@@ -284,8 +294,9 @@ static TESShalfEdge *FinishLeftRegions( TESStesselator *tess,
 * same as in the dictionary.
 */
 {
+	TESSmesh *mesh = tess->mesh;
 	ActiveRegion *reg, *regPrev;
-	TESShalfEdge *e, *ePrev;
+	TESShalfEdge e, ePrev;
 
 	regPrev = regFirst;
 	ePrev = regFirst->eUp;
@@ -293,7 +304,7 @@ static TESShalfEdge *FinishLeftRegions( TESStesselator *tess,
 		regPrev->fixUpperEdge = FALSE;	/* placement was OK */
 		reg = RegionBelow( regPrev );
 		e = reg->eUp;
-		if( e->Org != ePrev->Org ) {
+		if( Org( mesh, e ) != Org( mesh, ePrev ) ) {
 			if( ! reg->fixUpperEdge ) {
 				/* Remove the last left-going edge.  Even though there are no further
 				* edges in the dictionary with this origin, there may be further
@@ -307,14 +318,14 @@ static TESShalfEdge *FinishLeftRegions( TESStesselator *tess,
 			/* If the edge below was a temporary edge introduced by
 			* ConnectRightVertex, now is the time to fix it.
 			*/
-			e = tessMeshConnect( tess->mesh, ePrev->Lprev, e->Sym );
-			if (e == NULL) longjmp(tess->env,1);
+			e = tessMeshConnect( tess->mesh, Lprev( mesh, ePrev ), Sym(e) );
+			if (e == NULL_EDGE) longjmp(tess->env,1);
 			if ( !FixUpperEdge( tess, reg, e ) ) longjmp(tess->env,1);
 		}
 
 		/* Relink edges so that ePrev->Onext == e */
-		if( ePrev->Onext != e ) {
-			if ( !tessMeshSplice( tess->mesh, e->Oprev, e ) ) longjmp(tess->env,1);
+		if( Onext( mesh, ePrev ) != e ) {
+			if ( !tessMeshSplice( tess->mesh, Oprev( mesh, e ), e ) ) longjmp(tess->env,1);
 			if ( !tessMeshSplice( tess->mesh, ePrev, e ) ) longjmp(tess->env,1);
 		}
 		FinishRegion( tess, regPrev );	/* may change reg->eUp */
@@ -326,7 +337,7 @@ static TESShalfEdge *FinishLeftRegions( TESStesselator *tess,
 
 
 static void AddRightEdges( TESStesselator *tess, ActiveRegion *regUp,
-						  TESShalfEdge *eFirst, TESShalfEdge *eLast, TESShalfEdge *eTopLeft,
+						  TESShalfEdge eFirst, TESShalfEdge eLast, TESShalfEdge eTopLeft,
 						  int cleanUp )
 /*
 * Purpose: insert right-going edges into the edge dictionary, and update
@@ -339,47 +350,48 @@ static void AddRightEdges( TESStesselator *tess, ActiveRegion *regUp,
 * should be NULL.
 */
 {
+	TESSmesh *mesh = tess->mesh;
 	ActiveRegion *reg, *regPrev;
-	TESShalfEdge *e, *ePrev;
+	TESShalfEdge e, ePrev;
 	int firstTime = TRUE;
 
 	/* Insert the new right-going edges in the dictionary */
 	e = eFirst;
 	do {
-		assert( VertLeq( e->Org, e->Dst ));
-		AddRegionBelow( tess, regUp, e->Sym );
-		e = e->Onext;
+		assert( VertLeq( Org( mesh, e ), Dst( mesh, e ) ));
+		AddRegionBelow( tess, regUp, Sym(e) );
+		e = Onext( mesh, e );
 	} while ( e != eLast );
 
 	/* Walk *all* right-going edges from e->Org, in the dictionary order,
 	* updating the winding numbers of each region, and re-linking the mesh
 	* edges to match the dictionary ordering (if necessary).
 	*/
-	if( eTopLeft == NULL ) {
-		eTopLeft = RegionBelow( regUp )->eUp->Rprev;
+	if( eTopLeft == NULL_EDGE ) {
+		eTopLeft = Rprev( mesh, RegionBelow( regUp )->eUp );
 	}
 	regPrev = regUp;
 	ePrev = eTopLeft;
 	for( ;; ) {
 		reg = RegionBelow( regPrev );
-		e = reg->eUp->Sym;
-		if( e->Org != ePrev->Org ) break;
+		e = Sym(reg->eUp);
+		if( Org( mesh, e ) != Org( mesh, ePrev ) ) break;
 
-		if( e->Onext != ePrev ) {
+		if( Onext( mesh, e ) != ePrev ) {
 			/* Unlink e from its current position, and relink below ePrev */
-			if ( !tessMeshSplice( tess->mesh, e->Oprev, e ) ) longjmp(tess->env,1);
-			if ( !tessMeshSplice( tess->mesh, ePrev->Oprev, e ) ) longjmp(tess->env,1);
+			if ( !tessMeshSplice( tess->mesh, Oprev( mesh, e ), e ) ) longjmp(tess->env,1);
+			if ( !tessMeshSplice( tess->mesh, Oprev( mesh, ePrev ), e ) ) longjmp(tess->env,1);
 		}
 		/* Compute the winding number and "inside" flag for the new regions */
-		reg->windingNumber = regPrev->windingNumber - e->winding;
+		reg->windingNumber = regPrev->windingNumber - Winding( mesh, e );
 		reg->inside = IsWindingInside( tess, reg->windingNumber );
 
 		/* Check for two outgoing edges with same slope -- process these
 		* before any intersection tests (see example in tessComputeInterior).
 		*/
 		regPrev->dirty = TRUE;
-		if( ! firstTime && CheckForRightSplice( tess, regPrev )) {
-			AddWinding( e, ePrev );
+		if( ! firstTime && ! tess->simplePolygon && CheckForRightSplice( tess, regPrev )) {
+			AddWinding( mesh, e, ePrev );
 			DeleteRegion( tess, regPrev );
 			if ( !tessMeshDelete( tess->mesh, ePrev ) ) longjmp(tess->env,1);
 		}
@@ -388,7 +400,7 @@ static void AddRightEdges( TESStesselator *tess, ActiveRegion *regUp,
 		ePrev = e;
 	}
 	regPrev->dirty = TRUE;
-	assert( regPrev->windingNumber - e->winding == reg->windingNumber );
+	assert( regPrev->windingNumber - Winding( mesh, e ) == reg->windingNumber );
 
 	if( cleanUp ) {
 		/* Check for intersections between newly adjacent edges. */
@@ -397,8 +409,8 @@ static void AddRightEdges( TESStesselator *tess, ActiveRegion *regUp,
 }
 
 
-static void SpliceMergeVertices( TESStesselator *tess, TESShalfEdge *e1,
-								TESShalfEdge *e2 )
+static void SpliceMergeVertices( TESStesselator *tess, TESShalfEdge e1,
+								TESShalfEdge e2 )
 /*
 * Two vertices with idential coordinates are combined into one.
 * e1->Org is kept, while e2->Org is discarded.
@@ -407,6 +419,8 @@ static void SpliceMergeVertices( TESStesselator *tess, TESShalfEdge *e1,
 	if ( !tessMeshSplice( tess->mesh, e1, e2 ) ) longjmp(tess->env,1); 
 }
 
+#ifndef TESS_2D_ONLY
+
 static void VertexWeights( TESSvertex *isect, TESSvertex *org, TESSvertex *dst,
 						  TESSreal *weights )
 /*
@@ -427,6 +441,7 @@ static void VertexWeights( TESSvertex *isect, TESSvertex *org, TESSvertex *dst,
 	isect->coords[2] += weights[0]*org->coords[2] + weights[1]*dst->coords[2];
 }
 
+#endif /* TESS_2D_ONLY */
 
 static void GetIntersectData( TESStesselator *tess, TESSvertex *isect,
 							 TESSvertex *orgUp, TESSvertex *dstUp,
@@ -437,6 +452,15 @@ static void GetIntersectData( TESStesselator *tess, TESSvertex *isect,
  * rendering callbacks.
  */
 {
+#ifdef TESS_2D_ONLY
+	/* The location of isect is (s,t), which the caller fills in */
+	TESS_NOTUSED( tess );
+	TESS_NOTUSED( orgUp );
+	TESS_NOTUSED( dstUp );
+	TESS_NOTUSED( orgLo );
+	TESS_NOTUSED( dstLo );
+	isect->idx = TESS_UNDEF;
+#else
 	TESSreal weights[4];
 	TESS_NOTUSED( tess );
 
@@ -444,6 +468,7 @@ static void GetIntersectData( TESStesselator *tess, TESSvertex *isect,
 	isect->idx = TESS_UNDEF;
 	VertexWeights( isect, orgUp, dstUp, &weights[0] );
 	VertexWeights( isect, orgLo, dstLo, &weights[2] );
+#endif
 }
 
 static int CheckForRightSplice( TESStesselator *tess, ActiveRegion *regUp )
@@ -473,32 +498,33 @@ static int CheckForRightSplice( TESStesselator *tess, ActiveRegion *regUp )
 * Basically this is a combinatorial solution to a numerical problem.
 */
 {
+	TESSmesh *mesh = tess->mesh;
 	ActiveRegion *regLo = RegionBelow(regUp);
-	TESShalfEdge *eUp = regUp->eUp;
-	TESShalfEdge *eLo = regLo->eUp;
+	TESShalfEdge eUp = regUp->eUp;
+	TESShalfEdge eLo = regLo->eUp;
 
-	if( VertLeq( eUp->Org, eLo->Org )) {
-		if( EdgeSign( eLo->Dst, eUp->Org, eLo->Org ) > 0 ) return FALSE;
+	if( VertLeq( Org( mesh, eUp ), Org( mesh, eLo ) )) {
+		if( EdgeSign( Dst( mesh, eLo ), Org( mesh, eUp ), Org( mesh, eLo ) ) > 0 ) return FALSE;
 
 		/* eUp->Org appears to be below eLo */
-		if( ! VertEq( eUp->Org, eLo->Org )) {
+		if( ! VertEq( Org( mesh, eUp ), Org( mesh, eLo ) )) {
 			/* Splice eUp->Org into eLo */
-			if ( tessMeshSplitEdge( tess->mesh, eLo->Sym ) == NULL) longjmp(tess->env,1);
-			if ( !tessMeshSplice( tess->mesh, eUp, eLo->Oprev ) ) longjmp(tess->env,1);
+			if ( tessMeshSplitEdge( tess->mesh, Sym(eLo) ) == NULL_EDGE) longjmp(tess->env,1);
+			if ( !tessMeshSplice( tess->mesh, eUp, Oprev( mesh, eLo ) ) ) longjmp(tess->env,1);
 			regUp->dirty = regLo->dirty = TRUE;
 
-		} else if( eUp->Org != eLo->Org ) {
+		} else if( Org( mesh, eUp ) != Org( mesh, eLo ) ) {
 			/* merge the two vertices, discarding eUp->Org */
-			pqDelete( tess->pq, eUp->Org->pqHandle );
-			SpliceMergeVertices( tess, eLo->Oprev, eUp );
+			pqDelete( tess->pq, Org( mesh, eUp )->pqHandle );
+			SpliceMergeVertices( tess, Oprev( mesh, eLo ), eUp );
 		}
 	} else {
-		if( EdgeSign( eUp->Dst, eLo->Org, eUp->Org ) <= 0 ) return FALSE;
+		if( EdgeSign( Dst( mesh, eUp ), Org( mesh, eLo ), Org( mesh, eUp ) ) <= 0 ) return FALSE;
 
 		/* eLo->Org appears to be above eUp, so splice eLo->Org into eUp */
 		RegionAbove(regUp)->dirty = regUp->dirty = TRUE;
-		if (tessMeshSplitEdge( tess->mesh, eUp->Sym ) == NULL) longjmp(tess->env,1);
-		if ( !tessMeshSplice( tess->mesh, eLo->Oprev, eUp ) ) longjmp(tess->env,1);
+		if (tessMeshSplitEdge( tess->mesh, Sym(eUp) ) == NULL_EDGE) longjmp(tess->env,1);
+		if ( !tessMeshSplice( tess->mesh, Oprev( mesh, eLo ), eUp ) ) longjmp(tess->env,1);
 	}
 	return TRUE;
 }
@@ -523,31 +549,32 @@ static int CheckForLeftSplice( TESStesselator *tess, ActiveRegion *regUp )
 * other edge.
 */
 {
+	TESSmesh *mesh = tess->mesh;
 	ActiveRegion *regLo = RegionBelow(regUp);
-	TESShalfEdge *eUp = regUp->eUp;
-	TESShalfEdge *eLo = regLo->eUp;
-	TESShalfEdge *e;
+	TESShalfEdge eUp = regUp->eUp;
+	TESShalfEdge eLo = regLo->eUp;
+	TESShalfEdge e;
 
-	assert( ! VertEq( eUp->Dst, eLo->Dst ));
+	assert( ! VertEq( Dst( mesh, eUp ), Dst( mesh, eLo ) ));
 
-	if( VertLeq( eUp->Dst, eLo->Dst )) {
-		if( EdgeSign( eUp->Dst, eLo->Dst, eUp->Org ) < 0 ) return FALSE;
+	if( VertLeq( Dst( mesh, eUp ), Dst( mesh, eLo ) )) {
+		if( EdgeSign( Dst( mesh, eUp ), Dst( mesh, eLo ), Org( mesh, eUp ) ) < 0 ) return FALSE;
 
 		/* eLo->Dst is above eUp, so splice eLo->Dst into eUp */
 		RegionAbove(regUp)->dirty = regUp->dirty = TRUE;
 		e = tessMeshSplitEdge( tess->mesh, eUp );
-		if (e == NULL) longjmp(tess->env,1);
-		if ( !tessMeshSplice( tess->mesh, eLo->Sym, e ) ) longjmp(tess->env,1);
-		e->Lface->inside = regUp->inside;
+		if (e == NULL_EDGE) longjmp(tess->env,1);
+		if ( !tessMeshSplice( tess->mesh, Sym(eLo), e ) ) longjmp(tess->env,1);
+		Lface( mesh, e )->inside = regUp->inside;
 	} else {
-		if( EdgeSign( eLo->Dst, eUp->Dst, eLo->Org ) > 0 ) return FALSE;
+		if( EdgeSign( Dst( mesh, eLo ), Dst( mesh, eUp ), Org( mesh, eLo ) ) > 0 ) return FALSE;
 
 		/* eUp->Dst is below eLo, so splice eUp->Dst into eLo */
 		regUp->dirty = regLo->dirty = TRUE;
 		e = tessMeshSplitEdge( tess->mesh, eLo );
-		if (e == NULL) longjmp(tess->env,1);    
-		if ( !tessMeshSplice( tess->mesh, eUp->Lnext, eLo->Sym ) ) longjmp(tess->env,1);
-		e->Rface->inside = regUp->inside;
+		if (e == NULL_EDGE) longjmp(tess->env,1);    
+		if ( !tessMeshSplice( tess->mesh, Lnext( mesh, eUp ), Sym(eLo) ) ) longjmp(tess->env,1);
+		Rface( mesh, e )->inside = regUp->inside;
 	}
 	return TRUE;
 }
@@ -564,16 +591,17 @@ static int CheckForIntersect( TESStesselator *tess, ActiveRegion *regUp )
 * checked for intersections, and possibly regUp has been deleted.
 */
 {
+	TESSmesh *mesh = tess->mesh;
 	ActiveRegion *regLo = RegionBelow(regUp);
-	TESShalfEdge *eUp = regUp->eUp;
-	TESShalfEdge *eLo = regLo->eUp;
-	TESSvertex *orgUp = eUp->Org;
-	TESSvertex *orgLo = eLo->Org;
-	TESSvertex *dstUp = eUp->Dst;
-	TESSvertex *dstLo = eLo->Dst;
+	TESShalfEdge eUp = regUp->eUp;
+	TESShalfEdge eLo = regLo->eUp;
+	TESSvertex *orgUp = Org( mesh, eUp );
+	TESSvertex *orgLo = Org( mesh, eLo );
+	TESSvertex *dstUp = Dst( mesh, eUp );
+	TESSvertex *dstLo = Dst( mesh, eLo );
 	TESSreal tMinUp, tMaxLo;
 	TESSvertex isect, *orgMin;
-	TESShalfEdge *e;
+	TESShalfEdge e;
 
 	assert( ! VertEq( dstLo, dstUp ));
 	assert( EdgeSign( dstUp, tess->event, orgUp ) <= 0 );
@@ -596,6 +624,7 @@ static int CheckForIntersect( TESStesselator *tess, ActiveRegion *regUp )
 	/* At this point the edges intersect, at least marginally */
 	DebugEvent( tess );
 
+	tess->stats.intersections++;
 	tesedgeIntersect( dstUp, orgUp, dstLo, orgLo, &isect );
 	/* The following properties are guaranteed: */
 	assert( MIN( orgUp->t, dstUp->t ) <= isect.t );
@@ -642,25 +671,25 @@ static int CheckForIntersect( TESStesselator *tess, ActiveRegion *regUp )
 		*/
 		if( dstLo == tess->event ) {
 			/* Splice dstLo into eUp, and process the new region(s) */
-			if (tessMeshSplitEdge( tess->mesh, eUp->Sym ) == NULL) longjmp(tess->env,1);
-			if ( !tessMeshSplice( tess->mesh, eLo->Sym, eUp ) ) longjmp(tess->env,1);
+			if (tessMeshSplitEdge( tess->mesh, Sym(eUp) ) == NULL_EDGE) longjmp(tess->env,1);
+			if ( !tessMeshSplice( tess->mesh, Sym(eLo), eUp ) ) longjmp(tess->env,1);
 			regUp = TopLeftRegion( tess, regUp );
 			if (regUp == NULL) longjmp(tess->env,1);
 			eUp = RegionBelow(regUp)->eUp;
 			FinishLeftRegions( tess, RegionBelow(regUp), regLo );
-			AddRightEdges( tess, regUp, eUp->Oprev, eUp, eUp, TRUE );
+			AddRightEdges( tess, regUp, Oprev( mesh, eUp ), eUp, eUp, TRUE );
 			return TRUE;
 		}
 		if( dstUp == tess->event ) {
 			/* Splice dstUp into eLo, and process the new region(s) */
-			if (tessMeshSplitEdge( tess->mesh, eLo->Sym ) == NULL) longjmp(tess->env,1);
-			if ( !tessMeshSplice( tess->mesh, eUp->Lnext, eLo->Oprev ) ) longjmp(tess->env,1); 
+			if (tessMeshSplitEdge( tess->mesh, Sym(eLo) ) == NULL_EDGE) longjmp(tess->env,1);
+			if ( !tessMeshSplice( tess->mesh, Lnext( mesh, eUp ), Oprev( mesh, eLo ) ) ) longjmp(tess->env,1); 
 			regLo = regUp;
-			regUp = TopRightRegion( regUp );
-			e = RegionBelow(regUp)->eUp->Rprev;
-			regLo->eUp = eLo->Oprev;
+			regUp = TopRightRegion( tess, regUp );
+			e = Rprev( mesh, RegionBelow(regUp)->eUp );
+			regLo->eUp = Oprev( mesh, eLo );
 			eLo = FinishLeftRegions( tess, regLo, NULL );
-			AddRightEdges( tess, regUp, eLo->Onext, eUp->Rprev, e, TRUE );
+			AddRightEdges( tess, regUp, Onext( mesh, eLo ), Rprev( mesh, eUp ), e, TRUE );
 			return TRUE;
 		}
 		/* Special case: called from ConnectRightVertex.  If either
@@ -669,15 +698,15 @@ static int CheckForIntersect( TESStesselator *tess, ActiveRegion *regUp )
 		*/
 		if( EdgeSign( dstUp, tess->event, &isect ) >= 0 ) {
 			RegionAbove(regUp)->dirty = regUp->dirty = TRUE;
-			if (tessMeshSplitEdge( tess->mesh, eUp->Sym ) == NULL) longjmp(tess->env,1);
-			eUp->Org->s = tess->event->s;
-			eUp->Org->t = tess->event->t;
+			if (tessMeshSplitEdge( tess->mesh, Sym(eUp) ) == NULL_EDGE) longjmp(tess->env,1);
+			Org( mesh, eUp )->s = tess->event->s;
+			Org( mesh, eUp )->t = tess->event->t;
 		}
 		if( EdgeSign( dstLo, tess->event, &isect ) <= 0 ) {
 			regUp->dirty = regLo->dirty = TRUE;
-			if (tessMeshSplitEdge( tess->mesh, eLo->Sym ) == NULL) longjmp(tess->env,1);
-			eLo->Org->s = tess->event->s;
-			eLo->Org->t = tess->event->t;
+			if (tessMeshSplitEdge( tess->mesh, Sym(eLo) ) == NULL_EDGE) longjmp(tess->env,1);
+			Org( mesh, eLo )->s = tess->event->s;
+			Org( mesh, eLo )->t = tess->event->t;
 		}
 		/* leave the rest for ConnectRightVertex */
 		return FALSE;
@@ -691,18 +720,18 @@ static int CheckForIntersect( TESStesselator *tess, ActiveRegion *regUp )
 	* the mesh (ie. eUp->Lface) to be smaller than the faces in the
 	* unprocessed original contours (which will be eLo->Oprev->Lface).
 	*/
-	if (tessMeshSplitEdge( tess->mesh, eUp->Sym ) == NULL) longjmp(tess->env,1);
-	if (tessMeshSplitEdge( tess->mesh, eLo->Sym ) == NULL) longjmp(tess->env,1);
-	if ( !tessMeshSplice( tess->mesh, eLo->Oprev, eUp ) ) longjmp(tess->env,1);
-	eUp->Org->s = isect.s;
-	eUp->Org->t = isect.t;
-	eUp->Org->pqHandle = pqInsert( &tess->alloc, tess->pq, eUp->Org );
-	if (eUp->Org->pqHandle == INV_HANDLE) {
+	if (tessMeshSplitEdge( tess->mesh, Sym(eUp) ) == NULL_EDGE) longjmp(tess->env,1);
+	if (tessMeshSplitEdge( tess->mesh, Sym(eLo) ) == NULL_EDGE) longjmp(tess->env,1);
+	if ( !tessMeshSplice( tess->mesh, Oprev( mesh, eLo ), eUp ) ) longjmp(tess->env,1);
+	Org( mesh, eUp )->s = isect.s;
+	Org( mesh, eUp )->t = isect.t;
+	Org( mesh, eUp )->pqHandle = pqInsert( &tess->alloc, tess->pq, Org( mesh, eUp ) );
+	if (Org( mesh, eUp )->pqHandle == INV_HANDLE) {
 		pqDeletePriorityQ( &tess->alloc, tess->pq );
 		tess->pq = NULL;
 		longjmp(tess->env,1);
 	}
-	GetIntersectData( tess, eUp->Org, orgUp, dstUp, orgLo, dstLo );
+	GetIntersectData( tess, Org( mesh, eUp ), orgUp, dstUp, orgLo, dstLo );
 	RegionAbove(regUp)->dirty = regUp->dirty = regLo->dirty = TRUE;
 	return FALSE;
 }
@@ -717,8 +746,9 @@ static void WalkDirtyRegions( TESStesselator *tess, ActiveRegion *regUp )
 * the invariants.
 */
 {
+	TESSmesh *mesh = tess->mesh;
 	ActiveRegion *regLo = RegionBelow(regUp);
-	TESShalfEdge *eUp, *eLo;
+	TESShalfEdge eUp, eLo;
 
 	for( ;; ) {
 		/* Find the lowest dirty region (we walk from the bottom up). */
@@ -738,7 +768,14 @@ static void WalkDirtyRegions( TESStesselator *tess, ActiveRegion *regUp )
 		eUp = regUp->eUp;
 		eLo = regLo->eUp;
 
-		if( eUp->Dst != eLo->Dst ) {
+		if( tess->simplePolygon ) {
+			/* The edges of a simple polygon never cross or touch, so the
+			* dictionary invariants can't be violated.
+			*/
+			continue;
+		}
+
+		if( Dst( mesh, eUp ) != Dst( mesh, eLo ) ) {
 			/* Check that the edge ordering is obeyed at the Dst vertices. */
 			if( CheckForLeftSplice( tess, regUp )) {
 
@@ -759,10 +796,10 @@ static void WalkDirtyRegions( TESStesselator *tess, ActiveRegion *regUp )
 				}
 			}
 		}
-		if( eUp->Org != eLo->Org ) {
-			if(    eUp->Dst != eLo->Dst
+		if( Org( mesh, eUp ) != Org( mesh, eLo ) ) {
+			if(    Dst( mesh, eUp ) != Dst( mesh, eLo )
 				&& ! regUp->fixUpperEdge && ! regLo->fixUpperEdge
-				&& (eUp->Dst == tess->event || eLo->Dst == tess->event) )
+				&& (Dst( mesh, eUp ) == tess->event || Dst( mesh, eLo ) == tess->event) )
 			{
 				/* When all else fails in CheckForIntersect(), it uses tess->event
 				* as the intersection location.  To make this possible, it requires
@@ -783,9 +820,9 @@ static void WalkDirtyRegions( TESStesselator *tess, ActiveRegion *regUp )
 				(void) CheckForRightSplice( tess, regUp );
 			}
 		}
-		if( eUp->Org == eLo->Org && eUp->Dst == eLo->Dst ) {
+		if( Org( mesh, eUp ) == Org( mesh, eLo ) && Dst( mesh, eUp ) == Dst( mesh, eLo ) ) {
 			/* A degenerate loop consisting of only two edges -- delete it. */
-			AddWinding( eLo, eUp );
+			AddWinding( mesh, eLo, eUp );
 			DeleteRegion( tess, regUp );
 			if ( !tessMeshDelete( tess->mesh, eUp ) ) longjmp(tess->env,1);
 			regUp = RegionAbove( regLo );
@@ -795,7 +832,7 @@ static void WalkDirtyRegions( TESStesselator *tess, ActiveRegion *regUp )
 
 
 static void ConnectRightVertex( TESStesselator *tess, ActiveRegion *regUp,
-							   TESShalfEdge *eBottomLeft )
+							   TESShalfEdge eBottomLeft )
 /*
 * Purpose: connect a "right" vertex vEvent (one where all edges go left)
 * to the unprocessed portion of the mesh.  Since there are no right-going
@@ -828,54 +865,55 @@ static void ConnectRightVertex( TESStesselator *tess, ActiveRegion *regUp,
 * closest one, in which case we won''t need to make any changes.
 */
 {
-	TESShalfEdge *eNew;
-	TESShalfEdge *eTopLeft = eBottomLeft->Onext;
+	TESSmesh *mesh = tess->mesh;
+	TESShalfEdge eNew;
+	TESShalfEdge eTopLeft = Onext( mesh, eBottomLeft );
 	ActiveRegion *regLo = RegionBelow(regUp);
-	TESShalfEdge *eUp = regUp->eUp;
-	TESShalfEdge *eLo = regLo->eUp;
+	TESShalfEdge eUp = regUp->eUp;
+	TESShalfEdge eLo = regLo->eUp;
 	int degenerate = FALSE;
 
-	if( eUp->Dst != eLo->Dst ) {
+	if( Dst( mesh, eUp ) != Dst( mesh, eLo ) && ! tess->simplePolygon ) {
 		(void) CheckForIntersect( tess, regUp );
 	}
 
 	/* Possible new degeneracies: upper or lower edge of regUp may pass
 	* through vEvent, or may coincide with new intersection vertex
 	*/
-	if( VertEq( eUp->Org, tess->event )) {
-		if ( !tessMeshSplice( tess->mesh, eTopLeft->Oprev, eUp ) ) longjmp(tess->env,1);
+	if( VertEq( Org( mesh, eUp ), tess->event )) {
+		if ( !tessMeshSplice( tess->mesh, Oprev( mesh, eTopLeft ), eUp ) ) longjmp(tess->env,1);
 		regUp = TopLeftRegion( tess, regUp );
 		if (regUp == NULL) longjmp(tess->env,1);
 		eTopLeft = RegionBelow( regUp )->eUp;
 		FinishLeftRegions( tess, RegionBelow(regUp), regLo );
 		degenerate = TRUE;
 	}
-	if( VertEq( eLo->Org, tess->event )) {
-		if ( !tessMeshSplice( tess->mesh, eBottomLeft, eLo->Oprev ) ) longjmp(tess->env,1);
+	if( VertEq( Org( mesh, eLo ), tess->event )) {
+		if ( !tessMeshSplice( tess->mesh, eBottomLeft, Oprev( mesh, eLo ) ) ) longjmp(tess->env,1);
 		eBottomLeft = FinishLeftRegions( tess, regLo, NULL );
 		degenerate = TRUE;
 	}
 	if( degenerate ) {
-		AddRightEdges( tess, regUp, eBottomLeft->Onext, eTopLeft, eTopLeft, TRUE );
+		AddRightEdges( tess, regUp, Onext( mesh, eBottomLeft ), eTopLeft, eTopLeft, TRUE );
 		return;
 	}
 
 	/* Non-degenerate situation -- need to add a temporary, fixable edge.
 	* Connect to the closer of eLo->Org, eUp->Org.
 	*/
-	if( VertLeq( eLo->Org, eUp->Org )) {
-		eNew = eLo->Oprev;
+	if( VertLeq( Org( mesh, eLo ), Org( mesh, eUp ) )) {
+		eNew = Oprev( mesh, eLo );
 	} else {
 		eNew = eUp;
 	}
-	eNew = tessMeshConnect( tess->mesh, eBottomLeft->Lprev, eNew );
-	if (eNew == NULL) longjmp(tess->env,1);
+	eNew = tessMeshConnect( tess->mesh, Lprev( mesh, eBottomLeft ), eNew );
+	if (eNew == NULL_EDGE) longjmp(tess->env,1);
 
 	/* Prevent cleanup, otherwise eNew might disappear before we've even
 	* had a chance to mark it as a temporary edge.
 	*/
-	AddRightEdges( tess, regUp, eNew, eNew->Onext, eNew->Onext, FALSE );
-	eNew->Sym->activeRegion->fixUpperEdge = TRUE;
+	AddRightEdges( tess, regUp, eNew, Onext( mesh, eNew ), Onext( mesh, eNew ), FALSE );
+	EdgeRegion( mesh, Sym(eNew) )->fixUpperEdge = TRUE;
 	WalkDirtyRegions( tess, regUp );
 }
 
@@ -896,11 +934,12 @@ static void ConnectLeftDegenerate( TESStesselator *tess,
 * part of the mesh.
 */
 {
-	TESShalfEdge *e, *eTopLeft, *eTopRight, *eLast;
+	TESSmesh *mesh = tess->mesh;
+	TESShalfEdge e, eTopLeft, eTopRight, eLast;
 	ActiveRegion *reg;
 
 	e = regUp->eUp;
-	if( VertEq( e->Org, vEvent )) {
+	if( VertEq( Org( mesh, e ), vEvent )) {
 		/* e->Org is an unprocessed vertex - just combine them, and wait
 		* for e->Org to be pulled from the queue
 		*/
@@ -909,12 +948,12 @@ static void ConnectLeftDegenerate( TESStesselator *tess,
 		return;
 	}
 
-	if( ! VertEq( e->Dst, vEvent )) {
+	if( ! VertEq( Dst( mesh, e ), vEvent )) {
 		/* General case -- splice vEvent into edge e which passes through it */
-		if (tessMeshSplitEdge( tess->mesh, e->Sym ) == NULL) longjmp(tess->env,1);
+		if (tessMeshSplitEdge( tess->mesh, Sym(e) ) == NULL_EDGE) longjmp(tess->env,1);
 		if( regUp->fixUpperEdge ) {
 			/* This edge was fixable -- delete unused portion of original edge */
-			if ( !tessMeshDelete( tess->mesh, e->Onext ) ) longjmp(tess->env,1);
+			if ( !tessMeshDelete( tess->mesh, Onext( mesh, e ) ) ) longjmp(tess->env,1);
 			regUp->fixUpperEdge = FALSE;
 		}
 		if ( !tessMeshSplice( tess->mesh, vEvent->anEdge, e ) ) longjmp(tess->env,1);
@@ -926,10 +965,10 @@ static void ConnectLeftDegenerate( TESStesselator *tess,
 	* Splice in the additional right-going edges.
 	*/
 	assert( TOLERANCE_NONZERO );
-	regUp = TopRightRegion( regUp );
+	regUp = TopRightRegion( tess, regUp );
 	reg = RegionBelow( regUp );
-	eTopRight = reg->eUp->Sym;
-	eTopLeft = eLast = eTopRight->Onext;
+	eTopRight = Sym(reg->eUp);
+	eTopLeft = eLast = Onext( mesh, eTopRight );
 	if( reg->fixUpperEdge ) {
 		/* Here e->Dst has only a single fixable edge going right.
 		* We can delete it since now we have some real right-going edges.
@@ -937,14 +976,14 @@ static void ConnectLeftDegenerate( TESStesselator *tess,
 		assert( eTopLeft != eTopRight );   /* there are some left edges too */
 		DeleteRegion( tess, reg );
 		if ( !tessMeshDelete( tess->mesh, eTopRight ) ) longjmp(tess->env,1);
-		eTopRight = eTopLeft->Oprev;
+		eTopRight = Oprev( mesh, eTopLeft );
 	}
 	if ( !tessMeshSplice( tess->mesh, vEvent->anEdge, eTopRight ) ) longjmp(tess->env,1);
-	if( ! EdgeGoesLeft( eTopLeft )) {
+	if( ! EdgeGoesLeft( mesh, eTopLeft )) {
 		/* e->Dst had no left-going edges -- indicate this to AddRightEdges() */
-		eTopLeft = NULL;
+		eTopLeft = NULL_EDGE;
 	}
-	AddRightEdges( tess, regUp, eTopRight->Onext, eLast, eTopLeft, TRUE );
+	AddRightEdges( tess, regUp, Onext( mesh, eTopRight ), eLast, eTopLeft, TRUE );
 }
 
 
@@ -965,14 +1004,15 @@ static void ConnectLeftVertex( TESStesselator *tess, TESSvertex *vEvent )
 *	- merging with an already-processed portion of U or L
 */
 {
+	TESSmesh *mesh = tess->mesh;
 	ActiveRegion *regUp, *regLo, *reg;
-	TESShalfEdge *eUp, *eLo, *eNew;
+	TESShalfEdge eUp, eLo, eNew;
 	ActiveRegion tmp;
 
 	/* assert( vEvent->anEdge->Onext->Onext == vEvent->anEdge ); */
 
 	/* Get a pointer to the active region containing vEvent */
-	tmp.eUp = vEvent->anEdge->Sym;
+	tmp.eUp = Sym(vEvent->anEdge);
 	/* __GL_DICTLISTKEY */ /* tessDictListSearch */
 	regUp = (ActiveRegion *)dictKey( dictSearch( tess->dict, &tmp ));
 	regLo = RegionBelow( regUp );
@@ -984,7 +1024,7 @@ static void ConnectLeftVertex( TESStesselator *tess, TESSvertex *vEvent )
 	eLo = regLo->eUp;
 
 	/* Try merging with U or L first */
-	if( EdgeSign( eUp->Dst, vEvent, eUp->Org ) == 0 ) {
+	if( EdgeSign( Dst( mesh, eUp ), vEvent, Org( mesh, eUp ) ) == 0 ) {
 		ConnectLeftDegenerate( tess, regUp, vEvent );
 		return;
 	}
@@ -992,17 +1032,17 @@ static void ConnectLeftVertex( TESStesselator *tess, TESSvertex *vEvent )
 	/* Connect vEvent to rightmost processed vertex of either chain.
 	* e->Dst is the vertex that we will connect to vEvent.
 	*/
-	reg = VertLeq( eLo->Dst, eUp->Dst ) ? regUp : regLo;
+	reg = VertLeq( Dst( mesh, eLo ), Dst( mesh, eUp ) ) ? regUp : regLo;
 
 	if( regUp->inside || reg->fixUpperEdge) {
 		if( reg == regUp ) {
-			eNew = tessMeshConnect( tess->mesh, vEvent->anEdge->Sym, eUp->Lnext );
-			if (eNew == NULL) longjmp(tess->env,1);
+			eNew = tessMeshConnect( tess->mesh, Sym(vEvent->anEdge), Lnext( mesh, eUp ) );
+			if (eNew == NULL_EDGE) longjmp(tess->env,1);
 		} else {
-			TESShalfEdge *tempHalfEdge= tessMeshConnect( tess->mesh, eLo->Dnext, vEvent->anEdge);
-			if (tempHalfEdge == NULL) longjmp(tess->env,1);
+			TESShalfEdge tempHalfEdge= tessMeshConnect( tess->mesh, Dnext( mesh, eLo ), vEvent->anEdge);
+			if (tempHalfEdge == NULL_EDGE) longjmp(tess->env,1);
 
-			eNew = tempHalfEdge->Sym;
+			eNew = Sym(tempHalfEdge);
 		}
 		if( reg->fixUpperEdge ) {
 			if ( !FixUpperEdge( tess, reg, eNew ) ) longjmp(tess->env,1);
@@ -1014,7 +1054,7 @@ static void ConnectLeftVertex( TESStesselator *tess, TESSvertex *vEvent )
 		/* The new vertex is in a region which does not belong to the polygon.
 		* We don''t need to connect this vertex to the rest of the mesh.
 		*/
-		AddRightEdges( tess, regUp, vEvent->anEdge, vEvent->anEdge, NULL, TRUE );
+		AddRightEdges( tess, regUp, vEvent->anEdge, vEvent->anEdge, NULL_EDGE, TRUE );
 	}
 }
 
@@ -1025,8 +1065,9 @@ static void SweepEvent( TESStesselator *tess, TESSvertex *vEvent )
 * Updates the mesh and the edge dictionary.
 */
 {
+	TESSmesh *mesh = tess->mesh;
 	ActiveRegion *regUp, *reg;
-	TESShalfEdge *e, *eTopLeft, *eBottomLeft;
+	TESShalfEdge e, eTopLeft, eBottomLeft;
 
 	tess->event = vEvent;		/* for access in EdgeLeq() */
 	DebugEvent( tess );
@@ -1036,8 +1077,8 @@ static void SweepEvent( TESStesselator *tess, TESSvertex *vEvent )
 	* time searching for the location to insert new edges.
 	*/
 	e = vEvent->anEdge;
-	while( e->activeRegion == NULL ) {
-		e = e->Onext;
+	while( EdgeRegion( mesh, e ) == NULL ) {
+		e = Onext( mesh, e );
 		if( e == vEvent->anEdge ) {
 			/* All edges go right -- not incident to any processed edges */
 			ConnectLeftVertex( tess, vEvent );
@@ -1052,7 +1093,7 @@ static void SweepEvent( TESStesselator *tess, TESSvertex *vEvent )
 	* to their winding number, and delete the edges from the dictionary.
 	* This takes care of all the left-going edges from vEvent.
 	*/
-	regUp = TopLeftRegion( tess, e->activeRegion );
+	regUp = TopLeftRegion( tess, EdgeRegion( mesh, e ) );
 	if (regUp == NULL) longjmp(tess->env,1);
 	reg = RegionBelow( regUp );
 	eTopLeft = reg->eUp;
@@ -1063,11 +1104,11 @@ static void SweepEvent( TESStesselator *tess, TESSvertex *vEvent )
 	* associated "active regions" which record information about the
 	* regions between adjacent dictionary edges.
 	*/
-	if( eBottomLeft->Onext == eTopLeft ) {
+	if( Onext( mesh, eBottomLeft ) == eTopLeft ) {
 		/* No right-going edges -- add a temporary "fixable" edge */
 		ConnectRightVertex( tess, regUp, eBottomLeft );
 	} else {
-		AddRightEdges( tess, regUp, eBottomLeft->Onext, eTopLeft, eTopLeft, TRUE );
+		AddRightEdges( tess, regUp, Onext( mesh, eBottomLeft ), eTopLeft, eTopLeft, TRUE );
 	}
 }
 
@@ -1082,18 +1123,19 @@ static void AddSentinel( TESStesselator *tess, TESSreal smin, TESSreal smax, TES
 * to avoid special cases at the top and bottom.
 */
 {
-	TESShalfEdge *e;
+	TESSmesh *mesh = tess->mesh;
+	TESShalfEdge e;
 	ActiveRegion *reg = (ActiveRegion *)bucketAlloc( tess->regionPool );
 	if (reg == NULL) longjmp(tess->env,1);
 
 	e = tessMeshMakeEdge( tess->mesh );
-	if (e == NULL) longjmp(tess->env,1);
+	if (e == NULL_EDGE) longjmp(tess->env,1);
 
-	e->Org->s = smax;
-	e->Org->t = t;
-	e->Dst->s = smin;
-	e->Dst->t = t;
-	tess->event = e->Dst;		/* initialize it */
+	Org( mesh, e )->s = smax;
+	Org( mesh, e )->t = t;
+	Dst( mesh, e )->s = smin;
+	Dst( mesh, e )->t = t;
+	tess->event = Dst( mesh, e );		/* initialize it */
 
 	reg->eUp = e;
 	reg->windingNumber = 0;
@@ -1115,12 +1157,23 @@ static void InitEdgeDict( TESStesselator *tess )
 	TESSreal w, h;
 	TESSreal smin, smax, tmin, tmax;
 
-	tess->dict = dictNewDict( &tess->alloc, tess, (int (*)(void *, DictKey, DictKey)) EdgeLeq );
-	if (tess->dict == NULL) longjmp(tess->env,1);
+	/* The dictionary is kept between tessellations, DoneEdgeDict() empties it. */
+	if (tess->dict == NULL) {
+		tess->dict = dictNewDict( &tess->alloc, tess, (int (*)(void *, DictKey, DictKey)) EdgeLeq );
+		if (tess->dict == NULL) longjmp(tess->env,1);
+	}
 
+#ifdef TESS_USE_FIXED
+	/* The sentinels must stay on the integer grid, and within the range for
+	* which the orientation tests are exact (see geom.c), so they are placed
+	* just outside the bbox.
+	*/
+	w = h = 1;
+#else
 	/* If the bbox is empty, ensure that sentinels are not coincident by slightly enlarging it. */
 	w = (tess->bmax[0] - tess->bmin[0]) + (TESSreal)0.01;
 	h = (tess->bmax[1] - tess->bmin[1]) + (TESSreal)0.01;
+#endif
 
 	smin = tess->bmin[0] - w;
     smax = tess->bmax[0] + w;
@@ -1151,7 +1204,7 @@ static void DoneEdgeDict( TESStesselator *tess )
 		DeleteRegion( tess, reg );
 		/*    tessMeshDelete( reg->eUp );*/
 	}
-	dictDeleteDict( &tess->alloc, tess->dict );
+	dictReset( tess->dict, (unsigned int)tess->maxRetainedItems );
 }
 
 
@@ -1160,30 +1213,31 @@ static void RemoveDegenerateEdges( TESStesselator *tess )
 * Remove zero-length edges, and contours with fewer than 3 vertices.
 */
 {
-	TESShalfEdge *e, *eNext, *eLnext;
-	TESShalfEdge *eHead = &tess->mesh->eHead;
+	TESSmesh *mesh = tess->mesh;
+	TESShalfEdge e, eNext, eLnext;
+	TESShalfEdge eHead = EDGE_HEAD;
 
 	/*LINTED*/
-	for( e = eHead->next; e != eHead; e = eNext ) {
-		eNext = e->next;
-		eLnext = e->Lnext;
+	for( e = NextEdge( mesh, eHead ); e != eHead; e = eNext ) {
+		eNext = NextEdge( mesh, e );
+		eLnext = Lnext( mesh, e );
 
-		if( VertEq( e->Org, e->Dst ) && e->Lnext->Lnext != e ) {
+		if( VertEq( Org( mesh, e ), Dst( mesh, e ) ) && Lnext( mesh, Lnext( mesh, e ) ) != e ) {
 			/* Zero-length edge, contour has at least 3 edges */
 
 			SpliceMergeVertices( tess, eLnext, e );	/* deletes e->Org */
 			if ( !tessMeshDelete( tess->mesh, e ) ) longjmp(tess->env,1); /* e is a self-loop */
 			e = eLnext;
-			eLnext = e->Lnext;
+			eLnext = Lnext( mesh, e );
 		}
-		if( eLnext->Lnext == e ) {
+		if( Lnext( mesh, eLnext ) == e ) {
 			/* Degenerate contour (one or two edges) */
 
 			if( eLnext != e ) {
-				if( eLnext == eNext || eLnext == eNext->Sym ) { eNext = eNext->next; }
+				if( eLnext == eNext || eLnext == Sym(eNext) ) { eNext = NextEdge( mesh, eNext ); }
 				if ( !tessMeshDelete( tess->mesh, eLnext ) ) longjmp(tess->env,1);
 			}
-			if( e == eNext || e == eNext->Sym ) { eNext = eNext->next; }
+			if( e == eNext || e == Sym(eNext) ) { eNext = NextEdge( mesh, eNext ); }
 			if ( !tessMeshDelete( tess->mesh, e ) ) longjmp(tess->env,1);
 		}
 	}
@@ -1206,8 +1260,16 @@ static int InitPriorityQ( TESStesselator *tess )
 	/* Make sure there is enough space for sentinels. */
 	vertexCount += MAX( 8, tess->alloc.extraVertices );
 	
-	pq = tess->pq = pqNewPriorityQ( &tess->alloc, vertexCount, (int (*)(PQkey, PQkey)) tesvertLeq );
-	if (pq == NULL) return 0;
+	/* The priority queue is kept between tessellations, unless it grew
+	* beyond the retention limit (see DonePriorityQ()).
+	*/
+	if (tess->pq == NULL) {
+		tess->pq = pqNewPriorityQ( &tess->alloc, vertexCount, (int (*)(PQkey, PQkey)) tesvertLeq );
+		if (tess->pq == NULL) return 0;
+	} else if (!pqReset( &tess->alloc, tess->pq, vertexCount )) {
+		return 0;
+	}
+	pq = tess->pq;
 
 	vHead = &tess->mesh->vHead;
 	for( v = vHead->next; v != vHead; v = v->next ) {
@@ -1227,7 +1289,10 @@ static int InitPriorityQ( TESStesselator *tess )
 
 static void DonePriorityQ( TESStesselator *tess )
 {
-	pqDeletePriorityQ( &tess->alloc, tess->pq );
+	if (pqCapacity( tess->pq ) > tess->maxRetainedItems) {
+		pqDeletePriorityQ( &tess->alloc, tess->pq );
+		tess->pq = NULL;
+	}
 }
 
 
@@ -1248,17 +1313,17 @@ static int RemoveDegenerateFaces( TESStesselator *tess, TESSmesh *mesh )
 */
 {
 	TESSface *f, *fNext;
-	TESShalfEdge *e;
+	TESShalfEdge e;
 
 	/*LINTED*/
 	for( f = mesh->fHead.next; f != &mesh->fHead; f = fNext ) {
 		fNext = f->next;
 		e = f->anEdge;
-		assert( e->Lnext != e );
+		assert( Lnext( mesh, e ) != e );
 
-		if( e->Lnext->Lnext == e ) {
+		if( Lnext( mesh, Lnext( mesh, e ) ) == e ) {
 			/* A face with only two edges */
-			AddWinding( e->Onext, e );
+			AddWinding( mesh, Onext( mesh, e ), e );
 			if ( !tessMeshDelete( tess->mesh, e ) ) return 0;
 		}
 	}
@@ -1274,6 +1339,7 @@ int tessComputeInterior( TESStesselator *tess )
 * Each interior region is guaranteed be monotone.
 */
 {
+	TESSmesh *mesh = tess->mesh;
 	TESSvertex *v, *vNext;
 
 	/* Each vertex defines an event for our sweep line.  Start by inserting
@@ -1282,10 +1348,23 @@ int tessComputeInterior( TESStesselator *tess )
 	*
 	*	e1 < e2  iff  e1.x < e2.x || (e1.x == e2.x && e1.y < e2.y)
 	*/
-	RemoveDegenerateEdges( tess );
+	if( ! tess->simplePolygon ) {
+		/* A simple polygon has no zero-length edges and no contours
+		* with fewer than 3 vertices.
+		*/
+		RemoveDegenerateEdges( tess );
+	}
 	if ( !InitPriorityQ( tess ) ) return 0; /* if error */
 	InitEdgeDict( tess );
 
+	/* The sweep holds no face pointers across mesh operations.  The only
+	* faces it touches are looked up through an edge right before use, in
+	* FinishRegion and CheckForRightSplice.  So it can let the mesh relabel
+	* whichever loop is smaller when one is split or two are joined, which
+	* keeps large unprocessed contours from being walked over and over.
+	*/
+	tess->mesh->relabelSmallerLoop = TRUE;
+
 	while( (v = (TESSvertex *)pqExtractMin( tess->pq )) != NULL ) {
 		for( ;; ) {
 			vNext = (TESSvertex *)pqMinimum( tess->pq );
@@ -1308,11 +1387,13 @@ int tessComputeInterior( TESStesselator *tess )
 			vNext = (TESSvertex *)pqExtractMin( tess->pq );
 			SpliceMergeVertices( tess, v->anEdge, vNext->anEdge );
 		}
+		tess->stats.events++;
 		SweepEvent( tess, v );
 	}
+	tess->mesh->relabelSmallerLoop = FALSE;
 
 	/* Set tess->event for debugging purposes */
-	tess->event = ((ActiveRegion *) dictKey( dictMin( tess->dict )))->eUp->Org;
+	tess->event = Org( mesh, ((ActiveRegion *) dictKey( dictMin( tess->dict )))->eUp );
 	DebugEvent( tess );
 	DoneEdgeDict( tess );
 	DonePriorityQ( tess );
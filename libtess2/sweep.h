@@ -54,7 +54,7 @@ int tessComputeInterior( TESStesselator *tess );
 */
 
 struct ActiveRegion {
-	TESShalfEdge *eUp;		/* upper edge, directed right to left */
+	TESShalfEdge eUp;		/* upper edge, directed right to left */
 	DictNode *nodeUp;	/* dictionary node corresponding to eUp */
 	int windingNumber;	/* used to determine which regions are
 							* inside the polygon */
@@ -40,10 +40,18 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
 
 #define TRUE 1
 #define FALSE 0
 
+#ifndef TESS_2D_ONLY
+
 #define Dot(u,v)	(u[0]*v[0] + u[1]*v[1] + u[2]*v[2])
 
 #if defined(FOR_TRITE_TEST_PROGRAM) || defined(TRUE_PROJECT)
@@ -52,7 +60,7 @@ static void Normalize( TESSreal v[3] )
 	TESSreal len = v[0]*v[0] + v[1]*v[1] + v[2]*v[2];
 
 	assert( len > 0 );
-	len = sqrtf( len );
+	len = (TESSreal)sqrt( len );
 	v[0] /= len;
 	v[1] /= len;
 	v[2] /= len;
@@ -149,13 +157,15 @@ static void ComputeNormal( TESStesselator *tess, TESSreal norm[3] )
 	}
 }
 
+#endif /* TESS_2D_ONLY */
 
 static void CheckOrientation( TESStesselator *tess )
 {
+	TESSmesh *mesh = tess->mesh;
 	TESSreal area;
 	TESSface *f, *fHead = &tess->mesh->fHead;
 	TESSvertex *v, *vHead = &tess->mesh->vHead;
-	TESShalfEdge *e;
+	TESShalfEdge e;
 
 	/* When we compute the normal automatically, we choose the orientation
 	* so that the the sum of the signed areas of all contours is non-negative.
@@ -163,10 +173,10 @@ static void CheckOrientation( TESStesselator *tess )
 	area = 0;
 	for( f = fHead->next; f != fHead; f = f->next ) {
 		e = f->anEdge;
-		if( e->winding <= 0 ) continue;
+		if( Winding( mesh, e ) <= 0 ) continue;
 		do {
-			area += (e->Org->s - e->Dst->s) * (e->Org->t + e->Dst->t);
-			e = e->Lnext;
+			area += (Org( mesh, e )->s - Dst( mesh, e )->s) * (Org( mesh, e )->t + Dst( mesh, e )->t);
+			e = Lnext( mesh, e );
 		} while( e != f->anEdge );
 	}
 	if( area < 0 ) {
@@ -180,6 +190,59 @@ static void CheckOrientation( TESStesselator *tess )
 	}
 }
 
+/* Compute ST bounds. */
+static void ComputeBounds( TESStesselator *tess )
+{
+	TESSvertex *v, *vHead = &tess->mesh->vHead;
+	int first = 1;
+
+	for( v = vHead->next; v != vHead; v = v->next )
+	{
+		if (first)
+		{
+			tess->bmin[0] = tess->bmax[0] = v->s;
+			tess->bmin[1] = tess->bmax[1] = v->t;
+			first = 0;
+		}
+		else
+		{
+			if (v->s < tess->bmin[0]) tess->bmin[0] = v->s;
+			if (v->s > tess->bmax[0]) tess->bmax[0] = v->s;
+			if (v->t < tess->bmin[1]) tess->bmin[1] = v->t;
+			if (v->t > tess->bmax[1]) tess->bmax[1] = v->t;
+		}
+	}
+}
+
+#ifdef TESS_2D_ONLY
+
+/* The vertices already hold their 2D coordinates in (s,t), so the sweep
+* plane is the xy plane.  We only make sure that the contours have the
+* orientation which the sweep expects: the t axis is flipped if the given
+* normal points down, or if no normal was given and the contours turn out
+* to be clockwise (see CheckOrientation).
+*/
+void tessProjectPolygon( TESStesselator *tess )
+{
+	TESSvertex *v, *vHead = &tess->mesh->vHead;
+
+	tess->sUnit[0] = 1; tess->sUnit[1] = 0; tess->sUnit[2] = 0;
+	tess->tUnit[0] = 0; tess->tUnit[1] = 1; tess->tUnit[2] = 0;
+
+	if( tess->normal[0] == 0 && tess->normal[1] == 0 && tess->normal[2] == 0 ) {
+		CheckOrientation( tess );
+	} else if( tess->normal[2] < 0 ) {
+		for( v = vHead->next; v != vHead; v = v->next ) {
+			v->t = - v->t;
+		}
+		tess->tUnit[1] = -1;
+	}
+
+	ComputeBounds( tess );
+}
+
+#else
+
 #ifdef FOR_TRITE_TEST_PROGRAM
 #include <stdlib.h>
 extern int RandomSweep;
@@ -212,7 +275,7 @@ void tessProjectPolygon( TESStesselator *tess )
 	TESSvertex *v, *vHead = &tess->mesh->vHead;
 	TESSreal norm[3];
 	TESSreal *sUnit, *tUnit;
-	int i, first, computedNormal = FALSE;
+	int i, computedNormal = FALSE;
 
 	norm[0] = tess->normal[0];
 	norm[1] = tess->normal[1];
@@ -268,28 +331,13 @@ void tessProjectPolygon( TESStesselator *tess )
 		CheckOrientation( tess );
 	}
 
-	/* Compute ST bounds. */
-	first = 1;
-	for( v = vHead->next; v != vHead; v = v->next )
-	{
-		if (first)
-		{
-			tess->bmin[0] = tess->bmax[0] = v->s;
-			tess->bmin[1] = tess->bmax[1] = v->t;
-			first = 0;
-		}
-		else
-		{
-			if (v->s < tess->bmin[0]) tess->bmin[0] = v->s;
-			if (v->s > tess->bmax[0]) tess->bmax[0] = v->s;
-			if (v->t < tess->bmin[1]) tess->bmin[1] = v->t;
-			if (v->t > tess->bmax[1]) tess->bmax[1] = v->t;
-		}
-	}
+	ComputeBounds( tess );
 }
 
-#define AddWinding(eDst,eSrc)	(eDst->winding += eSrc->winding, \
-	eDst->Sym->winding += eSrc->Sym->winding)
+#endif /* TESS_2D_ONLY */
+
+#define AddWinding(m,eDst,eSrc)	(Winding( m, eDst ) += Winding( m, eSrc ), \
+	Winding( m, Sym(eDst) ) += Winding( m, Sym(eSrc) ))
 
 /* tessMeshTessellateMonoRegion( face ) tessellates a monotone region
 * (what else would it do??)  The region must consist of a single
@@ -320,7 +368,7 @@ void tessProjectPolygon( TESStesselator *tess )
 */
 int tessMeshTessellateMonoRegion( TESSmesh *mesh, TESSface *face )
 {
-	TESShalfEdge *up, *lo;
+	TESShalfEdge up, lo;
 
 	/* All edges are oriented CCW around the boundary of the region.
 	* First, find the half-edge whose origin vertex is rightmost.
@@ -328,47 +376,47 @@ int tessMeshTessellateMonoRegion( TESSmesh *mesh, TESSface *face )
 	* be close to the edge we want.
 	*/
 	up = face->anEdge;
-	assert( up->Lnext != up && up->Lnext->Lnext != up );
+	assert( Lnext( mesh, up ) != up && Lnext( mesh, Lnext( mesh, up ) ) != up );
 
-	for( ; VertLeq( up->Dst, up->Org ); up = up->Lprev )
+	for( ; VertLeq( Dst( mesh, up ), Org( mesh, up ) ); up = Lprev( mesh, up ) )
 		;
-	for( ; VertLeq( up->Org, up->Dst ); up = up->Lnext )
+	for( ; VertLeq( Org( mesh, up ), Dst( mesh, up ) ); up = Lnext( mesh, up ) )
 		;
-	lo = up->Lprev;
+	lo = Lprev( mesh, up );
 
-	while( up->Lnext != lo ) {
-		if( VertLeq( up->Dst, lo->Org )) {
+	while( Lnext( mesh, up ) != lo ) {
+		if( VertLeq( Dst( mesh, up ), Org( mesh, lo ) )) {
 			/* up->Dst is on the left.  It is safe to form triangles from lo->Org.
 			* The EdgeGoesLeft test guarantees progress even when some triangles
 			* are CW, given that the upper and lower chains are truly monotone.
 			*/
-			while( lo->Lnext != up && (EdgeGoesLeft( lo->Lnext )
-				|| EdgeSign( lo->Org, lo->Dst, lo->Lnext->Dst ) <= 0 )) {
-					TESShalfEdge *tempHalfEdge= tessMeshConnect( mesh, lo->Lnext, lo );
-					if (tempHalfEdge == NULL) return 0;
-					lo = tempHalfEdge->Sym;
+			while( Lnext( mesh, lo ) != up && (EdgeGoesLeft( mesh, Lnext( mesh, lo ) )
+				|| EdgeSign( Org( mesh, lo ), Dst( mesh, lo ), Dst( mesh, Lnext( mesh, lo ) ) ) <= 0 )) {
+					TESShalfEdge tempHalfEdge= tessMeshConnect( mesh, Lnext( mesh, lo ), lo );
+					if (tempHalfEdge == NULL_EDGE) return 0;
+					lo = Sym(tempHalfEdge);
 			}
-			lo = lo->Lprev;
+			lo = Lprev( mesh, lo );
 		} else {
 			/* lo->Org is on the left.  We can make CCW triangles from up->Dst. */
-			while( lo->Lnext != up && (EdgeGoesRight( up->Lprev )
-				|| EdgeSign( up->Dst, up->Org, up->Lprev->Org ) >= 0 )) {
-					TESShalfEdge *tempHalfEdge= tessMeshConnect( mesh, up, up->Lprev );
-					if (tempHalfEdge == NULL) return 0;
-					up = tempHalfEdge->Sym;
+			while( Lnext( mesh, lo ) != up && (EdgeGoesRight( mesh, Lprev( mesh, up ) )
+				|| EdgeSign( Dst( mesh, up ), Org( mesh, up ), Org( mesh, Lprev( mesh, up ) ) ) >= 0 )) {
+					TESShalfEdge tempHalfEdge= tessMeshConnect( mesh, up, Lprev( mesh, up ) );
+					if (tempHalfEdge == NULL_EDGE) return 0;
+					up = Sym(tempHalfEdge);
 			}
-			up = up->Lnext;
+			up = Lnext( mesh, up );
 		}
 	}
 
 	/* Now lo->Org == up->Dst == the leftmost vertex.  The remaining region
 	* can be tessellated in a fan from this leftmost vertex.
 	*/
-	assert( lo->Lnext != up );
-	while( lo->Lnext->Lnext != up ) {
-		TESShalfEdge *tempHalfEdge= tessMeshConnect( mesh, lo->Lnext, lo );
-		if (tempHalfEdge == NULL) return 0;
-		lo = tempHalfEdge->Sym;
+	assert( Lnext( mesh, lo ) != up );
+	while( Lnext( mesh, Lnext( mesh, lo ) ) != up ) {
+		TESShalfEdge tempHalfEdge= tessMeshConnect( mesh, Lnext( mesh, lo ), lo );
+		if (tempHalfEdge == NULL_EDGE) return 0;
+		lo = Sym(tempHalfEdge);
 	}
 
 	return 1;
@@ -394,61 +442,26 @@ int tessMeshTessellateInterior( TESSmesh *mesh )
 }
 
 
-typedef struct EdgeStackNode EdgeStackNode;
-typedef struct EdgeStack EdgeStack;
-
-struct EdgeStackNode {
-	TESShalfEdge *edge;
-	EdgeStackNode *next;
-};
-
-struct EdgeStack {
-	EdgeStackNode *top;
-	struct BucketAlloc *nodeBucket;
-};
-
-int stackInit( EdgeStack *stack, TESSalloc *alloc )
-{
-	stack->top = NULL;
-	stack->nodeBucket = createBucketAlloc( alloc, "CDT nodes", sizeof(EdgeStackNode), 512 );
-	return stack->nodeBucket != NULL;
-}
-
-void stackDelete( EdgeStack *stack )
-{
-    deleteBucketAlloc( stack->nodeBucket );
-}
-
-int stackEmpty( EdgeStack *stack )
-{
-	return stack->top == NULL;
-}
-
-void stackPush( EdgeStack *stack, TESShalfEdge *e )
+/* Pushes e on the stack, growing it if needed.  Returns 0 if out of memory. */
+static int stackPush( EdgeStack *stack, TESSalloc *alloc, TESShalfEdge e )
 {
-	EdgeStackNode *node = (EdgeStackNode *)bucketAlloc( stack->nodeBucket );
-	if ( ! node ) return;
-	node->edge = e;
-	node->next = stack->top;
-	stack->top = node;
-}
-
-TESShalfEdge *stackPop( EdgeStack *stack )
-{
-	TESShalfEdge *e = NULL;
-	EdgeStackNode *node = stack->top;
-	if (node) {
-		stack->top = node->next;
-		e = node->edge;
-		bucketFree( stack->nodeBucket, node );
+	if ( stack->top == stack->capacity ) {
+		int capacity = stack->capacity < 256 ? 256 : stack->capacity * 2;
+		TESShalfEdge *edges = (TESShalfEdge *)alloc->memrealloc( alloc->userData, stack->edges,
+																 sizeof(TESShalfEdge) * (unsigned int)capacity );
+		if ( edges == NULL ) return 0;
+		stack->edges = edges;
+		stack->capacity = capacity;
 	}
-	return e;
+	stack->edges[stack->top++] = e;
+	return 1;
 }
 
-
 //	Starting with a valid triangulation, uses the Edge Flip algorithm to
 //	refine the triangulation into a Constrained Delaunay Triangulation.
-void tessMeshRefineDelaunay( TESSmesh *mesh, TESSalloc *alloc )
+//	The stack is empty on entry and on return, its array is kept for reuse.
+//	Returns the number of edges flipped, or -1 if out of memory.
+int tessMeshRefineDelaunay( TESSmesh *mesh, EdgeStack *stack, TESSalloc *alloc )
 {
 	// At this point, we have a valid, but not optimal, triangulation.
 	// We refine the triangulation using the Edge Flip algorithm
@@ -458,54 +471,58 @@ void tessMeshRefineDelaunay( TESSmesh *mesh, TESSalloc *alloc )
 	//	3) insert all dual edges into a queue
 
 	TESSface *f;
-	EdgeStack stack;
-	TESShalfEdge *e;
-	int maxFaces = 0, maxIter = 0, iter = 0;
-
-	stackInit(&stack, alloc);
+	TESShalfEdge e;
+	int maxFaces = 0, maxIter = 0, iter = 0, flips = 0;
 
 	for( f = mesh->fHead.next; f != &mesh->fHead; f = f->next ) {
 		if ( f->inside) {
 			e = f->anEdge;
 			do {
-				e->mark = EdgeIsInternal(e); // Mark internal edges
-				if (e->mark && !e->Sym->mark) stackPush(&stack, e); // Insert into queue
-				e = e->Lnext;
+				EdgeMark( mesh, e ) = EdgeIsInternal(mesh, e); // Mark internal edges
+				if (EdgeMark( mesh, e ) && !EdgeMark( mesh, Sym(e) ) && !stackPush(stack, alloc, e)) flips = -1; // Insert into queue
+				e = Lnext( mesh, e );
 			} while (e != f->anEdge);
 			maxFaces++;
 		}
 	}
 
-	// The algorithm should converge on O(n^2), since the predicate is not robust,
-	// we'll save guard against infinite loop.
+	// The algorithm converges in O(n^2) flips, since the predicate is exact and
+	// only strictly illegal edges are flipped. We still guard against an infinite loop.
 	maxIter = maxFaces * maxFaces;
 
 	// Pop stack until we find a reversed edge
 	// Flip the reversed edge, and insert any of the four opposite edges
 	// which are internal and not already in the stack (!marked)
-	while (!stackEmpty(&stack) && iter < maxIter) {
-		e = stackPop(&stack);
-		e->mark = e->Sym->mark = 0;
-		if (!tesedgeIsLocallyDelaunay(e)) {
-			TESShalfEdge *edges[4];
+	while (stack->top > 0 && iter < maxIter && flips >= 0) {
+		e = stack->edges[--stack->top];
+		EdgeMark( mesh, e ) = EdgeMark( mesh, Sym(e) ) = 0;
+		if (!tesedgeIsLocallyDelaunay(mesh, e)) {
+			TESShalfEdge edges[4];
 			int i;
 			tessMeshFlipEdge(mesh, e);
+			flips++;
 			// for each opposite edge
-			edges[0] = e->Lnext;
-			edges[1] = e->Lprev;
-			edges[2] = e->Sym->Lnext;
-			edges[3] = e->Sym->Lprev;
+			edges[0] = Lnext( mesh, e );
+			edges[1] = Lprev( mesh, e );
+			edges[2] = Lnext( mesh, Sym(e) );
+			edges[3] = Lprev( mesh, Sym(e) );
 			for (i = 0; i < 4; i++) {
-				if (!edges[i]->mark && EdgeIsInternal(edges[i])) {
-					edges[i]->mark = edges[i]->Sym->mark = 1;
-					stackPush(&stack, edges[i]);
+				if (!EdgeMark( mesh, edges[i] ) && EdgeIsInternal(mesh, edges[i])) {
+					EdgeMark( mesh, edges[i] ) = EdgeMark( mesh, Sym(edges[i]) ) = 1;
+					if (!stackPush(stack, alloc, edges[i])) flips = -1;
 				}
 			}
 		}
 		iter++;
 	}
 
-	stackDelete(&stack);
+	// Clear the marks of the edges left over when the iteration limit was hit.
+	while (stack->top > 0) {
+		e = stack->edges[--stack->top];
+		EdgeMark( mesh, e ) = EdgeMark( mesh, Sym(e) ) = 0;
+	}
+
+	return flips;
 }
 
 
@@ -539,19 +556,19 @@ void tessMeshDiscardExterior( TESSmesh *mesh )
 int tessMeshSetWindingNumber( TESSmesh *mesh, int value,
 							 int keepOnlyBoundary )
 {
-	TESShalfEdge *e, *eNext;
+	TESShalfEdge e, eNext;
 
-	for( e = mesh->eHead.next; e != &mesh->eHead; e = eNext ) {
-		eNext = e->next;
-		if( e->Rface->inside != e->Lface->inside ) {
+	for( e = NextEdge( mesh, EDGE_HEAD ); e != EDGE_HEAD; e = eNext ) {
+		eNext = NextEdge( mesh, e );
+		if( Rface( mesh, e )->inside != Lface( mesh, e )->inside ) {
 
 			/* This is a boundary edge (one side is interior, one is exterior). */
-			e->winding = (e->Lface->inside) ? value : -value;
+			Winding( mesh, e ) = (Lface( mesh, e )->inside) ? value : -value;
 		} else {
 
 			/* Both regions are interior, or both are exterior. */
 			if( ! keepOnlyBoundary ) {
-				e->winding = 0;
+				Winding( mesh, e ) = 0;
 			} else {
 				if ( !tessMeshDelete( mesh, e ) ) return 0;
 			}
@@ -592,6 +609,60 @@ static TESSalloc defaulAlloc =
 	0,
 };
 
+/* Empties a mesh and keeps it for reuse by the next tessAddContour(). */
+static void RecycleMesh( TESStesselator *tess, TESSmesh *mesh )
+{
+	if ( tess->spareMesh != NULL )
+		tessMeshDeleteMesh( &tess->alloc, tess->spareMesh );
+	tessMeshResetMesh( mesh, (unsigned int)tess->maxRetainedItems );
+	tess->spareMesh = mesh;
+}
+
+/* Makes sure an output array has room for count items, keeping the
+* current allocation if it is large enough.
+*/
+static void* ReserveOutput( TESStesselator *tess, void *buffer, int *capacity, int count, unsigned int itemSize )
+{
+	if ( buffer != NULL && *capacity >= count )
+		return buffer;
+
+	if ( buffer != NULL )
+		tess->alloc.memfree( tess->alloc.userData, buffer );
+	*capacity = 0;
+
+	if ( count < 1 )
+		count = 1;
+	buffer = tess->alloc.memalloc( tess->alloc.userData, itemSize * (unsigned int)count );
+	if ( buffer != NULL )
+		*capacity = count;
+	return buffer;
+}
+
+/* Releases the output arrays which grew beyond the retention limit. */
+static void TrimOutput( TESStesselator *tess )
+{
+	if ( tess->vertices != NULL && tess->verticesCapacity > tess->maxRetainedItems ) {
+		tess->alloc.memfree( tess->alloc.userData, tess->vertices );
+		tess->vertices = 0;
+		tess->verticesCapacity = 0;
+	}
+	if ( tess->vertexIndices != NULL && tess->vertexIndicesCapacity > tess->maxRetainedItems ) {
+		tess->alloc.memfree( tess->alloc.userData, tess->vertexIndices );
+		tess->vertexIndices = 0;
+		tess->vertexIndicesCapacity = 0;
+	}
+	if ( tess->elements != NULL && tess->elementsCapacity > tess->maxRetainedItems ) {
+		tess->alloc.memfree( tess->alloc.userData, tess->elements );
+		tess->elements = 0;
+		tess->elementsCapacity = 0;
+	}
+	if ( tess->edgeStack.edges != NULL && tess->edgeStack.capacity > tess->maxRetainedItems ) {
+		tess->alloc.memfree( tess->alloc.userData, tess->edgeStack.edges );
+		tess->edgeStack.edges = 0;
+		tess->edgeStack.capacity = 0;
+	}
+}
+
 TESStesselator* tessNewTess( TESSalloc* alloc )
 {
 	TESStesselator* tess;
@@ -630,6 +701,7 @@ TESStesselator* tessNewTess( TESSalloc* alloc )
 	tess->bmax[1] = 0;
 
 	tess->reverseContours = 0;
+	tess->simplePolygon = 0;
     
 	tess->windingRule = TESS_WINDING_ODD;
 	tess->processCDT = 0;
@@ -643,6 +715,23 @@ TESStesselator* tessNewTess( TESSalloc* alloc )
 
 	// Initialize to begin polygon.
 	tess->mesh = NULL;
+	tess->spareMesh = NULL;
+	tess->dict = NULL;
+	tess->pq = NULL;
+	tess->maxRetainedItems = 16384;
+
+	tess->edgeStack.edges = NULL;
+	tess->edgeStack.top = 0;
+	tess->edgeStack.capacity = 0;
+
+	tess->triangleBuffer = NULL;
+	tess->triangleCapacity = 0;
+	tess->triangleCallback = NULL;
+	tess->triangleUserData = NULL;
+
+	memset( &tess->stats, 0, sizeof(TESSstats) );
+	tess->statsOut = NULL;
+	tess->phaseStart = 0;
 
 	tess->outOfMemory = 0;
 	tess->vertexIndexCounter = 0;
@@ -652,6 +741,9 @@ TESStesselator* tessNewTess( TESSalloc* alloc )
 	tess->vertexCount = 0;
 	tess->elements = 0;
 	tess->elementCount = 0;
+	tess->verticesCapacity = 0;
+	tess->vertexIndicesCapacity = 0;
+	tess->elementsCapacity = 0;
 
 	return tess;
 }
@@ -667,6 +759,18 @@ void tessDeleteTess( TESStesselator *tess )
 		tessMeshDeleteMesh( &alloc, tess->mesh );
 		tess->mesh = NULL;
 	}
+	if( tess->spareMesh != NULL ) {
+		tessMeshDeleteMesh( &alloc, tess->spareMesh );
+		tess->spareMesh = NULL;
+	}
+	if( tess->dict != NULL ) {
+		dictDeleteDict( &alloc, tess->dict );
+		tess->dict = NULL;
+	}
+	if( tess->pq != NULL ) {
+		pqDeletePriorityQ( &alloc, tess->pq );
+		tess->pq = NULL;
+	}
 	if (tess->vertices != NULL) {
 		alloc.memfree( alloc.userData, tess->vertices );
 		tess->vertices = 0;
@@ -679,25 +783,49 @@ void tessDeleteTess( TESStesselator *tess )
 		alloc.memfree( alloc.userData, tess->elements );
 		tess->elements = 0;
 	}
+	if (tess->edgeStack.edges != NULL) {
+		alloc.memfree( alloc.userData, tess->edgeStack.edges );
+		tess->edgeStack.edges = 0;
+	}
 
 	alloc.memfree( alloc.userData, tess );
 }
 
 
-static TESSindex GetNeighbourFace(TESShalfEdge* edge)
+static TESSindex GetNeighbourFace(TESSmesh *mesh, TESShalfEdge edge)
 {
-	if (!edge->Rface)
+	if (!Rface( mesh, edge ))
 		return TESS_UNDEF;
-	if (!edge->Rface->inside)
+	if (!Rface( mesh, edge )->inside)
 		return TESS_UNDEF;
-	return edge->Rface->n;
+	return Rface( mesh, edge )->n;
+}
+
+/* StoreCoords( tess, v, vert, vertexSize ) writes the location of v to
+* vert, as vertexSize coordinates.
+*/
+static void StoreCoords( TESStesselator *tess, TESSvertex *v, TESSreal *vert, int vertexSize )
+{
+#ifdef TESS_2D_ONLY
+	/* Undo the flip of the t axis by tessProjectPolygon(), if any */
+	vert[0] = v->s;
+	vert[1] = tess->tUnit[1] < 0 ? - v->t : v->t;
+	if ( vertexSize > 2 )
+		vert[2] = 0;
+#else
+	TESS_NOTUSED( tess );
+	vert[0] = v->coords[0];
+	vert[1] = v->coords[1];
+	if ( vertexSize > 2 )
+		vert[2] = v->coords[2];
+#endif
 }
 
 void OutputPolymesh( TESStesselator *tess, TESSmesh *mesh, int elementType, int polySize, int vertexSize )
 {
 	TESSvertex* v = 0;
 	TESSface* f = 0;
-	TESShalfEdge* edge = 0;
+	TESShalfEdge edge = NULL_EDGE;
 	int maxFaceCount = 0;
 	int maxVertexCount = 0;
 	int faceVerts, i;
@@ -729,14 +857,14 @@ void OutputPolymesh( TESStesselator *tess, TESSmesh *mesh, int elementType, int
 		faceVerts = 0;
 		do
 		{
-			v = edge->Org;
+			v = Org( mesh, edge );
 			if ( v->n == TESS_UNDEF )
 			{
 				v->n = maxVertexCount;
 				maxVertexCount++;
 			}
 			faceVerts++;
-			edge = edge->Lnext;
+			edge = Lnext( mesh, edge );
 		}
 		while (edge != f->anEdge);
 
@@ -749,8 +877,8 @@ void OutputPolymesh( TESStesselator *tess, TESSmesh *mesh, int elementType, int
 	tess->elementCount = maxFaceCount;
 	if (elementType == TESS_CONNECTED_POLYGONS)
 		maxFaceCount *= 2;
-	tess->elements = (TESSindex*)tess->alloc.memalloc( tess->alloc.userData,
-													  sizeof(TESSindex) * maxFaceCount * polySize );
+	tess->elements = (TESSindex*)ReserveOutput( tess, tess->elements, &tess->elementsCapacity,
+											   maxFaceCount * polySize, sizeof(TESSindex) );
 	if (!tess->elements)
 	{
 		tess->outOfMemory = 1;
@@ -758,16 +886,16 @@ void OutputPolymesh( TESStesselator *tess, TESSmesh *mesh, int elementType, int
 	}
 
 	tess->vertexCount = maxVertexCount;
-	tess->vertices = (TESSreal*)tess->alloc.memalloc( tess->alloc.userData,
-													 sizeof(TESSreal) * tess->vertexCount * vertexSize );
+	tess->vertices = (TESSreal*)ReserveOutput( tess, tess->vertices, &tess->verticesCapacity,
+											  tess->vertexCount * vertexSize, sizeof(TESSreal) );
 	if (!tess->vertices)
 	{
 		tess->outOfMemory = 1;
 		return;
 	}
 
-	tess->vertexIndices = (TESSindex*)tess->alloc.memalloc( tess->alloc.userData,
-														    sizeof(TESSindex) * tess->vertexCount );
+	tess->vertexIndices = (TESSindex*)ReserveOutput( tess, tess->vertexIndices, &tess->vertexIndicesCapacity,
+													tess->vertexCount, sizeof(TESSindex) );
 	if (!tess->vertexIndices)
 	{
 		tess->outOfMemory = 1;
@@ -781,10 +909,7 @@ void OutputPolymesh( TESStesselator *tess, TESSmesh *mesh, int elementType, int
 		{
 			// Store coordinate
 			vert = &tess->vertices[v->n*vertexSize];
-			vert[0] = v->coords[0];
-			vert[1] = v->coords[1];
-			if ( vertexSize > 2 )
-				vert[2] = v->coords[2];
+			StoreCoords( tess, v, vert, vertexSize );
 			// Store vertex index.
 			tess->vertexIndices[v->n] = v->idx;
 		}
@@ -801,10 +926,10 @@ void OutputPolymesh( TESStesselator *tess, TESSmesh *mesh, int elementType, int
 		faceVerts = 0;
 		do
 		{
-			v = edge->Org;
+			v = Org( mesh, edge );
 			*elements++ = v->n;
 			faceVerts++;
-			edge = edge->Lnext;
+			edge = Lnext( mesh, edge );
 		}
 		while (edge != f->anEdge);
 		// Fill unused.
@@ -817,8 +942,8 @@ void OutputPolymesh( TESStesselator *tess, TESSmesh *mesh, int elementType, int
 			edge = f->anEdge;
 			do
 			{
-				*elements++ = GetNeighbourFace( edge );
-				edge = edge->Lnext;
+				*elements++ = GetNeighbourFace( mesh, edge );
+				edge = Lnext( mesh, edge );
 			}
 			while (edge != f->anEdge);
 			// Fill unused.
@@ -828,11 +953,76 @@ void OutputPolymesh( TESStesselator *tess, TESSmesh *mesh, int elementType, int
 	}
 }
 
+/* Number of triangles passed to the callback at a time, if the caller
+* didn't supply a buffer.
+*/
+#define TRIANGLE_BATCH_SIZE 64
+
+static int OutputTriangles( TESStesselator *tess, TESSmesh *mesh )
+{
+	TESSindex batch[TRIANGLE_BATCH_SIZE * 3];
+	TESSindex *start, *out, *end;
+	TESShalfEdge e;
+	TESSface *f;
+	int count = 0;
+
+	if ( tess->triangleBuffer != NULL ) {
+		start = tess->triangleBuffer;
+		end = start + tess->triangleCapacity * 3;
+	} else if ( tess->triangleCallback != NULL ) {
+		start = batch;
+		end = start + TRIANGLE_BATCH_SIZE * 3;
+	} else {
+		for ( f = mesh->fHead.next; f != &mesh->fHead; f = f->next ) {
+			if ( f->inside ) ++count;
+		}
+		tess->elements = (TESSindex*)ReserveOutput( tess, tess->elements, &tess->elementsCapacity,
+												   count * 3, sizeof(TESSindex) );
+		if ( !tess->elements ) {
+			tess->outOfMemory = 1;
+			return 0;
+		}
+		start = tess->elements;
+		end = start + count * 3;
+		count = 0;
+	}
+
+	out = start;
+	for ( f = mesh->fHead.next; f != &mesh->fHead; f = f->next )
+	{
+		if ( !f->inside ) continue;
+
+		if ( out == end ) {
+			if ( tess->triangleCallback == NULL ) {
+				/* The caller's buffer is full, just count the rest. */
+				++count;
+				continue;
+			}
+			tess->triangleCallback( tess->triangleUserData, start, (int)((out - start) / 3) );
+			out = start;
+		}
+
+		e = f->anEdge;
+		assert( Lnext( mesh, Lnext( mesh, Lnext( mesh, e ) ) ) == e );
+		out[0] = Org( mesh, e )->idx;
+		out[1] = Org( mesh, Lnext( mesh, e ) )->idx;
+		out[2] = Org( mesh, Lprev( mesh, e ) )->idx;
+		out += 3;
+		++count;
+	}
+
+	if ( tess->triangleCallback != NULL && out != start )
+		tess->triangleCallback( tess->triangleUserData, start, (int)((out - start) / 3) );
+
+	tess->elementCount = count;
+	return tess->triangleCallback != NULL || count <= (int)((end - start) / 3);
+}
+
 void OutputContours( TESStesselator *tess, TESSmesh *mesh, int vertexSize )
 {
 	TESSface *f = 0;
-	TESShalfEdge *edge = 0;
-	TESShalfEdge *start = 0;
+	TESShalfEdge edge = NULL_EDGE;
+	TESShalfEdge start = NULL_EDGE;
 	TESSreal *verts = 0;
 	TESSindex *elements = 0;
 	TESSindex *vertInds = 0;
@@ -850,31 +1040,31 @@ void OutputContours( TESStesselator *tess, TESSmesh *mesh, int vertexSize )
 		do
 		{
 			++tess->vertexCount;
-			edge = edge->Lnext;
+			edge = Lnext( mesh, edge );
 		}
 		while ( edge != start );
 
 		++tess->elementCount;
 	}
 
-	tess->elements = (TESSindex*)tess->alloc.memalloc( tess->alloc.userData,
-													  sizeof(TESSindex) * tess->elementCount * 2 );
+	tess->elements = (TESSindex*)ReserveOutput( tess, tess->elements, &tess->elementsCapacity,
+											   tess->elementCount * 2, sizeof(TESSindex) );
 	if (!tess->elements)
 	{
 		tess->outOfMemory = 1;
 		return;
 	}
 
-	tess->vertices = (TESSreal*)tess->alloc.memalloc( tess->alloc.userData,
-													  sizeof(TESSreal) * tess->vertexCount * vertexSize );
+	tess->vertices = (TESSreal*)ReserveOutput( tess, tess->vertices, &tess->verticesCapacity,
+											  tess->vertexCount * vertexSize, sizeof(TESSreal) );
 	if (!tess->vertices)
 	{
 		tess->outOfMemory = 1;
 		return;
 	}
 
-	tess->vertexIndices = (TESSindex*)tess->alloc.memalloc( tess->alloc.userData,
-														    sizeof(TESSindex) * tess->vertexCount );
+	tess->vertexIndices = (TESSindex*)ReserveOutput( tess, tess->vertexIndices, &tess->vertexIndicesCapacity,
+													tess->vertexCount, sizeof(TESSindex) );
 	if (!tess->vertexIndices)
 	{
 		tess->outOfMemory = 1;
@@ -895,13 +1085,11 @@ void OutputContours( TESStesselator *tess, TESSmesh *mesh, int vertexSize )
 		start = edge = f->anEdge;
 		do
 		{
-			*verts++ = edge->Org->coords[0];
-			*verts++ = edge->Org->coords[1];
-			if ( vertexSize > 2 )
-				*verts++ = edge->Org->coords[2];
-			*vertInds++ = edge->Org->idx;
+			StoreCoords( tess, Org( mesh, edge ), verts, vertexSize );
+			verts += vertexSize;
+			*vertInds++ = Org( mesh, edge )->idx;
 			++vertCount;
-			edge = edge->Lnext;
+			edge = Lnext( mesh, edge );
 		}
 		while ( edge != start );
 
@@ -917,36 +1105,45 @@ void tessAddContour( TESStesselator *tess, int size, const void* vertices,
 					int stride, int numVertices )
 {
 	const unsigned char *src = (const unsigned char*)vertices;
-	TESShalfEdge *e;
+	TESSmesh *mesh;
+	TESShalfEdge e;
 	int i;
 
-	if ( tess->mesh == NULL )
-	  	tess->mesh = tessMeshNewMesh( &tess->alloc );
+	if ( tess->mesh == NULL ) {
+		if ( tess->spareMesh != NULL ) {
+			tess->mesh = tess->spareMesh;
+			tess->spareMesh = NULL;
+		} else {
+			tess->mesh = tessMeshNewMesh( &tess->alloc );
+		}
+	}
  	if ( tess->mesh == NULL ) {
 		tess->outOfMemory = 1;
 		return;
 	}
 
+	mesh = tess->mesh;
+
 	if ( size < 2 )
 		size = 2;
 	if ( size > 3 )
 		size = 3;
 
-	e = NULL;
+	e = NULL_EDGE;
 
 	for( i = 0; i < numVertices; ++i )
 	{
 		const TESSreal* coords = (const TESSreal*)src;
 		src += stride;
 
-		if( e == NULL ) {
+		if( e == NULL_EDGE ) {
 			/* Make a self-loop (one vertex, one edge). */
 			e = tessMeshMakeEdge( tess->mesh );
-			if ( e == NULL ) {
+			if ( e == NULL_EDGE ) {
 				tess->outOfMemory = 1;
 				return;
 			}
-			if ( !tessMeshSplice( tess->mesh, e, e->Sym ) ) {
+			if ( !tessMeshSplice( tess->mesh, e, Sym(e) ) ) {
 				tess->outOfMemory = 1;
 				return;
 			}
@@ -954,30 +1151,35 @@ void tessAddContour( TESStesselator *tess, int size, const void* vertices,
 			/* Create a new vertex and edge which immediately follow e
 			* in the ordering around the left face.
 			*/
-			if ( tessMeshSplitEdge( tess->mesh, e ) == NULL ) {
+			if ( tessMeshSplitEdge( tess->mesh, e ) == NULL_EDGE ) {
 				tess->outOfMemory = 1;
 				return;
 			}
-			e = e->Lnext;
+			e = Lnext( mesh, e );
 		}
 
 		/* The new vertex is now e->Org. */
-		e->Org->coords[0] = coords[0];
-		e->Org->coords[1] = coords[1];
+#ifdef TESS_2D_ONLY
+		Org( mesh, e )->s = SnapToGrid( coords[0] );
+		Org( mesh, e )->t = SnapToGrid( coords[1] );
+#else
+		Org( mesh, e )->coords[0] = SnapToGrid( coords[0] );
+		Org( mesh, e )->coords[1] = SnapToGrid( coords[1] );
 		if ( size > 2 )
-			e->Org->coords[2] = coords[2];
+			Org( mesh, e )->coords[2] = SnapToGrid( coords[2] );
 		else
-			e->Org->coords[2] = 0;
+			Org( mesh, e )->coords[2] = 0;
+#endif
 		/* Store the insertion number so that the vertex can be later recognized. */
-		e->Org->idx = tess->vertexIndexCounter++;
+		Org( mesh, e )->idx = tess->vertexIndexCounter++;
 
 		/* The winding of an edge says how the winding number changes as we
 		* cross from the edge''s right face to its left face.  We add the
 		* vertices in such an order that a CCW contour will add +1 to
 		* the winding number of the region inside the contour.
 		*/
-        e->winding = tess->reverseContours ? -1 : 1;
-        e->Sym->winding = tess->reverseContours ? 1 : -1;
+        Winding( mesh, e ) = tess->reverseContours ? -1 : 1;
+        Winding( mesh, Sym(e) ) = tess->reverseContours ? 1 : -1;
 	}
 }
 
@@ -991,9 +1193,75 @@ void tessSetOption( TESStesselator *tess, int option, int value )
 	case TESS_REVERSE_CONTOURS:
 		tess->reverseContours = value > 0 ? 1 : 0;
 		break;
+	case TESS_MAX_RETAINED_ITEMS:
+		tess->maxRetainedItems = value > 0 ? value : 0;
+		break;
+	case TESS_SIMPLE_POLYGON:
+		tess->simplePolygon = value > 0 ? 1 : 0;
+		break;
 	}
 }
 
+void tessSetTriangleOutput( TESStesselator *tess, TESSindex *buffer, int capacity,
+						   TESStriangleFn callback, void *userData )
+{
+	tess->triangleBuffer = capacity > 0 ? buffer : NULL;
+	tess->triangleCapacity = capacity > 0 ? capacity : 0;
+	tess->triangleCallback = callback;
+	tess->triangleUserData = userData;
+}
+
+void tessSetStats( TESStesselator *tess, TESSstats *stats )
+{
+	tess->statsOut = stats;
+}
+
+void tessReset( TESStesselator *tess )
+{
+	if ( tess->mesh != NULL ) {
+		RecycleMesh( tess, tess->mesh );
+		tess->mesh = NULL;
+	}
+	tess->vertexIndexCounter = 0;
+	tess->outOfMemory = 0;
+}
+
+
+/* TimeNow() returns a monotonic clock reading in seconds, for TESSstats. */
+static double TimeNow( void )
+{
+#if defined(_WIN32)
+	LARGE_INTEGER count, frequency;
+	QueryPerformanceCounter( &count );
+	QueryPerformanceFrequency( &frequency );
+	return (double)count.QuadPart / (double)frequency.QuadPart;
+#else
+	struct timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+/* EndPhase( tess, phase ) adds the time since tess->phaseStart to *phase and
+* restarts the clock, if statistics were asked for with tessSetStats().
+*/
+static void EndPhase( TESStesselator *tess, double *phase )
+{
+	double now;
+
+	if( tess->statsOut == NULL ) return;
+	now = TimeNow();
+	*phase += now - tess->phaseStart;
+	tess->phaseStart = now;
+}
+
+/* ReturnStats( tess, rc ) hands the statistics of this call to the user. */
+static int ReturnStats( TESStesselator *tess, int rc )
+{
+	if( tess->statsOut != NULL )
+		*tess->statsOut = tess->stats;
+	return rc;
+}
 
 int tessTesselate( TESStesselator *tess, int windingRule, int elementType,
 				  int polySize, int vertexSize, const TESSreal* normal )
@@ -1001,18 +1269,16 @@ int tessTesselate( TESStesselator *tess, int windingRule, int elementType,
 	TESSmesh *mesh;
 	int rc = 1;
 
-	if (tess->vertices != NULL) {
-		tess->alloc.memfree( tess->alloc.userData, tess->vertices );
-		tess->vertices = 0;
-	}
-	if (tess->elements != NULL) {
-		tess->alloc.memfree( tess->alloc.userData, tess->elements );
-		tess->elements = 0;
-	}
-	if (tess->vertexIndices != NULL) {
-		tess->alloc.memfree( tess->alloc.userData, tess->vertexIndices );
-		tess->vertexIndices = 0;
-	}
+	memset( &tess->stats, 0, sizeof(TESSstats) );
+	if( tess->statsOut != NULL )
+		tess->phaseStart = TimeNow();
+
+	/* The output arrays of the previous tesselation are reused, unless they
+	* grew beyond the retention limit.
+	*/
+	TrimOutput( tess );
+	tess->vertexCount = 0;
+	tess->elementCount = 0;
 
 	tess->vertexIndexCounter = 0;
 
@@ -1032,18 +1298,31 @@ int tessTesselate( TESStesselator *tess, int windingRule, int elementType,
 
 	if (setjmp(tess->env) != 0) {
 		/* come back here if out of memory */
-		return 0;
+		/* Leave the tesselator in a state in which it can be reused. */
+		if ( tess->dict != NULL )
+			dictReset( tess->dict, (unsigned int)tess->maxRetainedItems );
+		if ( tess->pq != NULL ) {
+			pqDeletePriorityQ( &tess->alloc, tess->pq );
+			tess->pq = NULL;
+		}
+		bucketReset( tess->regionPool, (unsigned int)tess->maxRetainedItems );
+		if ( tess->mesh != NULL ) {
+			RecycleMesh( tess, tess->mesh );
+			tess->mesh = NULL;
+		}
+		return ReturnStats( tess, 0 );
 	}
 
 	if (!tess->mesh)
 	{
-		return 0;
+		return ReturnStats( tess, 0 );
 	}
 
 	/* Determine the polygon normal and project vertices onto the plane
 	* of the polygon.
 	*/
 	tessProjectPolygon( tess );
+	EndPhase( tess, &tess->stats.projectTime );
 
 	/* tessComputeInterior( tess ) computes the planar arrangement specified
 	* by the given contours, and further subdivides this arrangement
@@ -1054,6 +1333,7 @@ int tessTesselate( TESStesselator *tess, int windingRule, int elementType,
 	if ( !tessComputeInterior( tess ) ) {
 		longjmp(tess->env,1);  /* could've used a label */
 	}
+	EndPhase( tess, &tess->stats.sweepTime );
 
 	mesh = tess->mesh;
 
@@ -1063,10 +1343,18 @@ int tessTesselate( TESStesselator *tess, int windingRule, int elementType,
 	*/
 	if (elementType == TESS_BOUNDARY_CONTOURS) {
 		rc = tessMeshSetWindingNumber( mesh, 1, TRUE );
+		EndPhase( tess, &tess->stats.tessellateTime );
 	} else {
 		rc = tessMeshTessellateInterior( mesh );
-		if (rc != 0 && tess->processCDT != 0)
-			tessMeshRefineDelaunay( mesh, &tess->alloc );
+		EndPhase( tess, &tess->stats.tessellateTime );
+		if (rc != 0 && tess->processCDT != 0) {
+			tess->stats.delaunayFlips = tessMeshRefineDelaunay( mesh, &tess->edgeStack, &tess->alloc );
+			if ( tess->stats.delaunayFlips < 0 ) {
+				tess->stats.delaunayFlips = 0;
+				longjmp(tess->env,1);
+			}
+			EndPhase( tess, &tess->stats.refineTime );
+		}
 	}
 	if (rc == 0) longjmp(tess->env,1);  /* could've used a label */
 
@@ -1075,17 +1363,22 @@ int tessTesselate( TESStesselator *tess, int windingRule, int elementType,
 	if (elementType == TESS_BOUNDARY_CONTOURS) {
 		OutputContours( tess, mesh, vertexSize );     /* output contours */
 	}
+	else if (elementType == TESS_TRIANGLE_INDICES)
+	{
+		rc = OutputTriangles( tess, mesh );     /* output triangles, without a vertex array */
+	}
 	else
 	{
 		OutputPolymesh( tess, mesh, elementType, polySize, vertexSize );     /* output polygons */
 	}
 
-	tessMeshDeleteMesh( &tess->alloc, mesh );
+	RecycleMesh( tess, mesh );
 	tess->mesh = NULL;
+	EndPhase( tess, &tess->stats.outputTime );
 
-	if (tess->outOfMemory)
-		return 0;
-	return 1;
+	if (tess->outOfMemory || rc == 0)
+		return ReturnStats( tess, 0 );
+	return ReturnStats( tess, 1 );
 }
 
 int tessGetVertexCount( TESStesselator *tess )
@@ -45,13 +45,24 @@ extern "C" {
 
 //typedef struct TESStesselator TESStesselator;
 
+/* Stack of edges to be checked by tessMeshRefineDelaunay(). */
+typedef struct EdgeStack {
+	TESShalfEdge *edges;
+	int top;
+	int capacity;
+} EdgeStack;
+
 struct TESStesselator {
 
 	/*** state needed for collecting the input data ***/
 	TESSmesh	*mesh;		/* stores the input contours, and eventually
 						the tessellation itself */
+	TESSmesh	*spareMesh;	/* emptied mesh, reused by the next tessAddContour() */
 	int outOfMemory;
 
+	/*** state needed for reusing memory between tessellations ***/
+	int maxRetainedItems;	/* structures which grow larger than this are trimmed after use */
+
 	/*** state needed for projecting onto the sweep plane ***/
 
 	TESSreal normal[3];	/* user-specified normal (if provided) */
@@ -63,6 +74,7 @@ struct TESStesselator {
 
 	int processCDT;	/* option to run Constrained Delayney pass. */
 	int reverseContours; /* tessAddContour() will treat CCW contours as CW and vice versa */
+	int simplePolygon;	/* input is a single simple contour, skip intersection handling */
     
 	/*** state needed for the line sweep ***/
 	int	windingRule;	/* rule for determining polygon interior */
@@ -81,6 +93,26 @@ struct TESStesselator {
 	TESSindex *elements;
 	int elementCount;
 
+	/* allocated sizes of the output arrays, in items */
+	int verticesCapacity;
+	int vertexIndicesCapacity;
+	int elementsCapacity;
+
+	/*** state needed for TESS_TRIANGLE_INDICES output (see tessSetTriangleOutput()) ***/
+	TESSindex *triangleBuffer;
+	int triangleCapacity;
+	TESStriangleFn triangleCallback;
+	void *triangleUserData;
+
+	/*** state needed for the Delaunay refinement ***/
+	EdgeStack edgeStack;	/* kept between calls, trimmed like the output arrays */
+
+	/*** statistics of the current tessTesselate() call (see tessSetStats()) ***/
+	TESSstats stats;
+	TESSstats *statsOut;	/* where to copy them when the call returns, or NULL */
+	double phaseStart;	/* clock reading at the start of the current phase; kept
+						here rather than in a local, which setjmp() could clobber */
+
 	TESSalloc alloc;
 
 	jmp_buf env;			/* place to jump to when memAllocs fail */
@@ -106,12 +106,27 @@ enum TessWindingRule
 //         }
 //         glEnd();
 //     }
+//
+// TESS_TRIANGLE_INDICES
+//   Each element is a triangle defined as 3 indices of the input vertices, numbered in the order in
+//   which they were passed to tessAddContour(), so no output vertex array is built and no remapping
+//   through tessGetVertexIndices() is needed. Vertices created at intersections have index TESS_UNDEF.
+//   'polySize' is ignored. The triangles are written to the buffer or callback set with
+//   tessSetTriangleOutput(), or to the element array if neither was set. tessGetVertexCount() returns 0.
+//   Example, streaming triangles to a rasterizer:
+//     void drawTriangles(void* userData, const TESSindex* tris, int count) {
+//         for (int i = 0; i < count; i++)
+//             rasterize(&verts[tris[i*3]*2], &verts[tris[i*3+1]*2], &verts[tris[i*3+2]*2]);
+//     }
+//     tessSetTriangleOutput(tess, NULL, 0, drawTriangles, NULL);
+//     tessTesselate(tess, TESS_WINDING_ODD, TESS_TRIANGLE_INDICES, 3, 2, NULL);
 
 enum TessElementType
 {
 	TESS_POLYGONS,
 	TESS_CONNECTED_POLYGONS,
 	TESS_BOUNDARY_CONTOURS,
+	TESS_TRIANGLE_INDICES,
 };
 
 
@@ -122,14 +137,94 @@ enum TessElementType
 // TESS_REVERSE_CONTOURS
 //   If enabled, tessAddContour() will treat CW contours as CCW and vice versa
 //   Disabled by default.
+//
+// TESS_MAX_RETAINED_ITEMS
+//   The tesselator keeps its mesh, sweep line dictionary, priority queue and output buffers
+//   between calls to tessTesselate(), so that tesselating many polygons with the same tesselator
+//   doesn't allocate memory once it has warmed up. Storage for at most this many items (vertices,
+//   edges, faces, dictionary nodes or output indices) is kept per structure, anything beyond that
+//   is released when the tesselation that needed it is done.
+//   16384 by default.
+//
+// TESS_SIMPLE_POLYGON
+//   If enabled, the caller guarantees that the input is a single simple contour: no two vertices
+//   coincide, no edges intersect or touch except at their shared vertex, and this still holds after
+//   the coordinates are converted to TESSreal. The sweep then skips the handling of intersections,
+//   splices and degenerate edges, and produces the same triangles. Input which breaks the guarantee
+//   results in undefined behavior.
+//   Disabled by default.
 
 enum TessOption
 {
 	TESS_CONSTRAINED_DELAUNAY_TRIANGULATION,
-	TESS_REVERSE_CONTOURS
+	TESS_REVERSE_CONTOURS,
+	TESS_MAX_RETAINED_ITEMS,
+	TESS_SIMPLE_POLYGON
 };
 
+// The coordinate type is chosen when libtess2 is built:
+//
+// default
+//   float coordinates.
+//
+// TESS_USE_DOUBLE
+//   double coordinates.
+//
+// TESS_USE_FIXED
+//   Fixed point coordinates: the input coordinates are rounded to the nearest integer, and must be
+//   at most TESS_FIXED_MAX in magnitude. They're stored as doubles, which represent these integers
+//   exactly, and the orientation tests of the sweep are evaluated exactly in 64 bit integer
+//   arithmetic. Intersection vertices are rounded to the integer grid as well.
+//
+// Independently of the coordinate type, libtess2 can be built for 2D input only:
+//
+// TESS_2D_ONLY
+//   The vertices store just their 2D coordinates, which the sweep uses directly, so there's no normal
+//   to compute and no projection onto the sweep plane. The z coordinate of 3D input is ignored, and
+//   a normal passed to tessTesselate() only matters through the sign of its z component. Output
+//   vertices have z = 0, and vertices created at intersections are output where the sweep found
+//   them, rather than as a weighted average of the endpoints of the intersecting edges.
+//
+// The double and fixed point builds give every exported function a _double or _fixed suffix, and the
+// 2D only build adds a _2d suffix, so that all variants can be linked into the same program. The
+// macros below map the names used in this header to the suffixed ones, so a program which includes
+// this header with the same definition as the library was built with uses it as usual.
+#if defined(TESS_USE_DOUBLE) && defined(TESS_USE_FIXED)
+#error "TESS_USE_DOUBLE and TESS_USE_FIXED can't both be defined"
+#endif
+
+#if defined(TESS_2D_ONLY)
+#define TESS_NAME_2D(name) name##_2d
+#else
+#define TESS_NAME_2D(name) name
+#endif
+
+#if defined(TESS_USE_DOUBLE)
+typedef double TESSreal;
+#define TESS_NAME(name) TESS_NAME_2D(name##_double)
+#elif defined(TESS_USE_FIXED)
+typedef double TESSreal;
+#define TESS_NAME(name) TESS_NAME_2D(name##_fixed)
+#define TESS_FIXED_MAX 1073741824
+#else
 typedef float TESSreal;
+#define TESS_NAME(name) TESS_NAME_2D(name)
+#endif
+
+#define tessNewTess				TESS_NAME(tessNewTess)
+#define tessDeleteTess			TESS_NAME(tessDeleteTess)
+#define tessReset				TESS_NAME(tessReset)
+#define tessAddContour			TESS_NAME(tessAddContour)
+#define tessSetOption			TESS_NAME(tessSetOption)
+#define tessSetTriangleOutput	TESS_NAME(tessSetTriangleOutput)
+#define tessSetStats			TESS_NAME(tessSetStats)
+#define tessTesselate			TESS_NAME(tessTesselate)
+#define tessGetVertexCount		TESS_NAME(tessGetVertexCount)
+#define tessGetVertices			TESS_NAME(tessGetVertices)
+#define tessGetVertexIndices	TESS_NAME(tessGetVertexIndices)
+#define tessGetElementCount		TESS_NAME(tessGetElementCount)
+#define tessGetElements			TESS_NAME(tessGetElements)
+
 typedef int TESSindex;
 typedef struct TESStesselator TESStesselator;
 typedef struct TESSalloc TESSalloc;
@@ -139,9 +234,11 @@ typedef struct TESSalloc TESSalloc;
 #define TESS_NOTUSED(v) do { (void)(1 ? (void)0 : ( (void)(v) ) ); } while(0)
 
 // Custom memory allocator interface.
-// The internal memory allocator allocates mesh edges, vertices and faces
+// The internal memory allocator allocates mesh vertices and faces
 // as well as dictionary nodes and active regions in buckets and uses simple
-// freelist to speed up the allocation. The bucket size should roughly match your
+// freelist to speed up the allocation. Mesh edges are stored in arrays instead, which
+// start with room for meshEdgeBucketSize edges and grow by half when they are full.
+// The bucket size should roughly match your
 // expected input data. For example if you process only hundreds of vertices,
 // a bucket size of 128 might be ok, where as when processing thousands of vertices
 // bucket size of 1024 might be approproate. The bucket size is a compromise between
@@ -154,6 +251,7 @@ typedef struct TESSalloc TESSalloc;
 // has found intersecting segments and needs to add new vertex. This defency can be cured by
 // allocating some extra vertices beforehand. The 'extraVertices' variable allows to specify
 // number of expected extra vertices.
+// The edge arrays are grown with memalloc, memcpy and memfree when memrealloc is null.
 struct TESSalloc
 {
 	void *(*memalloc)( void *userData, unsigned int size );
@@ -189,6 +287,14 @@ TESStesselator* tessNewTess( TESSalloc* alloc );
 //   tess - pointer to tesselator object to be deleted.
 void tessDeleteTess( TESStesselator *tess );
 
+// tessReset() - Discards the contours added since the last call to tessTesselate(), so that the
+// tesselator can be reused for another polygon. As with tessTesselate(), the memory used for the
+// discarded contours is kept for reuse, up to the TESS_MAX_RETAINED_ITEMS limit.
+// The results of the last call to tessTesselate() remain available.
+// Parameters:
+//   tess - pointer to tesselator object.
+void tessReset( TESStesselator *tess );
+
 // tessAddContour() - Adds a contour to be tesselated.
 // The type of the vertex coordinates is assumed to be TESSreal.
 // Parameters:
@@ -205,6 +311,46 @@ void tessAddContour( TESStesselator *tess, int size, const void* pointer, int st
 //  value - 1 if enabled, 0 if disabled.
 void tessSetOption( TESStesselator *tess, int option, int value );
 
+// Receives triangles written with TESS_TRIANGLE_INDICES, 'count' triangles of 3 indices each.
+typedef void (*TESStriangleFn)( void *userData, const TESSindex *triangles, int count );
+
+// tessSetTriangleOutput() - Sets where tessTesselate() writes the triangles when the element type
+// is TESS_TRIANGLE_INDICES.
+// Parameters:
+//   tess - pointer to tesselator object.
+//   buffer - room for 'capacity' triangles, or NULL.
+//   capacity - number of triangles which fit in buffer.
+//   callback - function which receives the triangles, or NULL.
+//   userData - passed to callback.
+// If only a buffer is given, the triangles are written to it, and if it's too small tessTesselate()
+// fails, and tessGetElementCount() returns the number of triangles it needs to hold. If a callback
+// is given, it receives the triangles in batches, through the buffer if there is one, or through a
+// small batch on the stack otherwise. If neither is given, the triangles go to the element array.
+void tessSetTriangleOutput( TESStesselator *tess, TESSindex *buffer, int capacity,
+						   TESStriangleFn callback, void *userData );
+
+// Statistics of one call to tessTesselate(), see tessSetStats(). Times are in seconds.
+typedef struct TESSstats TESSstats;
+struct TESSstats
+{
+	double projectTime;		// Finding the normal and projecting the vertices onto the sweep plane.
+	double sweepTime;		// The sweep, which splits the polygon into monotone regions.
+	double tessellateTime;	// Triangulating the monotone regions, or extracting the boundary contours.
+	double refineTime;		// The TESS_CONSTRAINED_DELAUNAY_TRIANGULATION pass, if enabled.
+	double outputTime;		// Writing the output arrays, buffer or callback.
+	int events;				// Sweep events processed, each one or more coincident vertices.
+	int edgeComparisons;	// Comparisons between edges in the sweep line dictionary.
+	int intersections;		// Edge intersections computed by the sweep.
+	int delaunayFlips;		// Edges flipped by the TESS_CONSTRAINED_DELAUNAY_TRIANGULATION pass.
+};
+
+// tessSetStats() - Makes tessTesselate() fill in the given struct on every call, also when it fails.
+// Timing the phases costs a few clock reads per call, which is why it has to be asked for.
+// Parameters:
+//   tess - pointer to tesselator object.
+//   stats - struct to fill in, or NULL to stop collecting statistics.
+void tessSetStats( TESStesselator *tess, TESSstats *stats );
+
 // tessTesselate() - tesselate contours.
 // Parameters:
 //   tess - pointer to tesselator object.
@@ -0,0 +1,108 @@
+/*
+** SGI FREE SOFTWARE LICENSE B (Version 2.0, Sept. 18, 2008)
+** Copyright (C) [dates of first publication] Silicon Graphics, Inc.
+** All Rights Reserved.
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+** of the Software, and to permit persons to whom the Software is furnished to do so,
+** subject to the following conditions:
+**
+** The above copyright notice including the dates of first publication and either this
+** permission notice or a reference to http://oss.sgi.com/projects/FreeB/ shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+** INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+** PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL SILICON GRAPHICS, INC.
+** BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+** TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+** OR OTHER DEALINGS IN THE SOFTWARE.
+**
+** Except as contained in this notice, the name of Silicon Graphics, Inc. shall not
+** be used in advertising or otherwise to promote the sale, use or other dealings in
+** this Software without prior written authorization from Silicon Graphics, Inc.
+*/
+
+#ifndef TESSNAMES_H
+#define TESSNAMES_H
+
+#include "tesselator.h"
+
+/* Gives the functions which are shared between the source files of
+* libtess2 the same suffix as the public functions (see TESS_NAME in
+* tesselator.h), so that all builds can be linked into the same program
+* without clashing.
+*/
+
+#define bucketAlloc					TESS_NAME(bucketAlloc)
+#define bucketFree					TESS_NAME(bucketFree)
+#define bucketReset					TESS_NAME(bucketReset)
+#define createBucketAlloc			TESS_NAME(createBucketAlloc)
+#define deleteBucketAlloc			TESS_NAME(deleteBucketAlloc)
+
+#define dictDelete					TESS_NAME(dictDelete)
+#define dictDeleteDict				TESS_NAME(dictDeleteDict)
+#define dictInsertBefore			TESS_NAME(dictInsertBefore)
+#define dictNewDict					TESS_NAME(dictNewDict)
+#define dictReset					TESS_NAME(dictReset)
+#define dictSearch					TESS_NAME(dictSearch)
+
+#define tesvertLeq					TESS_NAME(tesvertLeq)
+#define tesedgeEval					TESS_NAME(tesedgeEval)
+#define tesedgeSign					TESS_NAME(tesedgeSign)
+#define testransEval				TESS_NAME(testransEval)
+#define testransSign				TESS_NAME(testransSign)
+#define tesvertCCW					TESS_NAME(tesvertCCW)
+#define tesedgeIntersect			TESS_NAME(tesedgeIntersect)
+#define tesedgeIsLocallyDelaunay	TESS_NAME(tesedgeIsLocallyDelaunay)
+#define inCircle					TESS_NAME(inCircle)
+
+#define tessMeshMakeEdge			TESS_NAME(tessMeshMakeEdge)
+#define tessMeshSplice				TESS_NAME(tessMeshSplice)
+#define tessMeshDelete				TESS_NAME(tessMeshDelete)
+#define tessMeshAddEdgeVertex		TESS_NAME(tessMeshAddEdgeVertex)
+#define tessMeshSplitEdge			TESS_NAME(tessMeshSplitEdge)
+#define tessMeshConnect				TESS_NAME(tessMeshConnect)
+#define tessMeshZapFace				TESS_NAME(tessMeshZapFace)
+#define tessMeshNewMesh				TESS_NAME(tessMeshNewMesh)
+#define tessMeshUnion				TESS_NAME(tessMeshUnion)
+#define tessMeshMergeConvexFaces	TESS_NAME(tessMeshMergeConvexFaces)
+#define tessMeshFlipEdge			TESS_NAME(tessMeshFlipEdge)
+#define tessMeshDeleteMesh			TESS_NAME(tessMeshDeleteMesh)
+#define tessMeshResetMesh			TESS_NAME(tessMeshResetMesh)
+#define tessMeshCheckMesh			TESS_NAME(tessMeshCheckMesh)
+
+#define pqNewPriorityQ				TESS_NAME(pqNewPriorityQ)
+#define pqDeletePriorityQ			TESS_NAME(pqDeletePriorityQ)
+#define pqReset						TESS_NAME(pqReset)
+#define pqCapacity					TESS_NAME(pqCapacity)
+#define pqInit						TESS_NAME(pqInit)
+#define pqInsert					TESS_NAME(pqInsert)
+#define pqExtractMin				TESS_NAME(pqExtractMin)
+#define pqDelete					TESS_NAME(pqDelete)
+#define pqMinimum					TESS_NAME(pqMinimum)
+#define pqIsEmpty					TESS_NAME(pqIsEmpty)
+#define pqHeapNewPriorityQ			TESS_NAME(pqHeapNewPriorityQ)
+#define pqHeapDeletePriorityQ		TESS_NAME(pqHeapDeletePriorityQ)
+#define pqHeapInit					TESS_NAME(pqHeapInit)
+#define pqHeapInsert				TESS_NAME(pqHeapInsert)
+#define pqHeapExtractMin			TESS_NAME(pqHeapExtractMin)
+#define pqHeapDelete				TESS_NAME(pqHeapDelete)
+
+#define tessComputeInterior			TESS_NAME(tessComputeInterior)
+#define tessProjectPolygon			TESS_NAME(tessProjectPolygon)
+#define tessMeshTessellateMonoRegion	TESS_NAME(tessMeshTessellateMonoRegion)
+#define tessMeshTessellateInterior	TESS_NAME(tessMeshTessellateInterior)
+#define tessMeshRefineDelaunay		TESS_NAME(tessMeshRefineDelaunay)
+#define tessMeshDiscardExterior		TESS_NAME(tessMeshDiscardExterior)
+#define tessMeshSetWindingNumber	TESS_NAME(tessMeshSetWindingNumber)
+#define heapAlloc					TESS_NAME(heapAlloc)
+#define heapRealloc					TESS_NAME(heapRealloc)
+#define heapFree					TESS_NAME(heapFree)
+#define OutputPolymesh				TESS_NAME(OutputPolymesh)
+#define OutputContours				TESS_NAME(OutputContours)
+
+#endif
@@ -0,0 +1,99 @@
+// This file is compiled once for every build of libtess2, see libtess2_variant.hpp.
+
+#include "libtess2_variant.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "libtess2/tesselator.h"
+
+#if defined(TESS_2D_ONLY)
+#define TRIANGULATE_LIBTESS2_VARIANT triangulate_libtess2_2d
+#elif defined(TESS_USE_DOUBLE)
+#define TRIANGULATE_LIBTESS2_VARIANT triangulate_libtess2_double
+#elif defined(TESS_USE_FIXED)
+#define TRIANGULATE_LIBTESS2_VARIANT triangulate_libtess2_fixed
+#else
+#define TRIANGULATE_LIBTESS2_VARIANT triangulate_libtess2_float
+#endif
+
+namespace
+{
+
+/// Returns the coordinates of the vertices of @c polygon, interleaved, in the coordinate type of this build.
+std::vector<TESSreal> tess_vertices(PolygonView2 polygon)
+{
+  std::vector<TESSreal> vertices(2 * polygon.size());
+
+#ifdef TESS_USE_FIXED
+  std::array<int64_t, 2> min{polygon[0].x().numerator(), polygon[0].y().numerator()};
+  std::array<int64_t, 2> max = min;
+  for (Point2 vertex : polygon)
+  {
+    min[0] = std::min<int64_t>(min[0], vertex.x().numerator());
+    min[1] = std::min<int64_t>(min[1], vertex.y().numerator());
+    max[0] = std::max<int64_t>(max[0], vertex.x().numerator());
+    max[1] = std::max<int64_t>(max[1], vertex.y().numerator());
+  }
+
+  std::array<int64_t, 2> center{(min[0] + max[0]) / 2, (min[1] + max[1]) / 2};
+  int64_t half_extent = std::max({center[0] - min[0], max[0] - center[0], center[1] - min[1], max[1] - center[1]});
+  int shift = 0;
+  while ((half_extent >> shift) > TESS_FIXED_MAX)
+  {
+    shift++;
+  }
+
+  for (size_t i = 0; i < polygon.size(); i++)
+  {
+    vertices[2 * i] = static_cast<TESSreal>((polygon[i].x().numerator() - center[0]) >> shift);
+    vertices[2 * i + 1] = static_cast<TESSreal>((polygon[i].y().numerator() - center[1]) >> shift);
+  }
+#else
+  for (size_t i = 0; i < polygon.size(); i++)
+  {
+    vertices[2 * i] = static_cast<TESSreal>(static_cast<double>(polygon[i].x()));
+    vertices[2 * i + 1] = static_cast<TESSreal>(static_cast<double>(polygon[i].y()));
+  }
+#endif
+
+  return vertices;
+}
+
+} // namespace
+
+bool TRIANGULATE_LIBTESS2_VARIANT(PolygonView2 polygon, std::vector<std::array<int, 3>>& triangles)
+{
+  std::vector<TESSreal> vertices = tess_vertices(polygon);
+
+  TESStesselator* tessellator = tessNewTess(nullptr);
+  tessAddContour(tessellator, 2, vertices.data(), 2 * sizeof(TESSreal), static_cast<int>(polygon.size()));
+  if (!tessTesselate(tessellator, TESS_WINDING_ODD, TESS_POLYGONS, 3, 2, nullptr))
+  {
+    tessDeleteTess(tessellator);
+    return false;
+  }
+
+  int num_triangles = tessGetElementCount(tessellator);
+  const TESSindex* elements = tessGetElements(tessellator);
+  const TESSindex* vertex_indices = tessGetVertexIndices(tessellator);
+
+  triangles.clear();
+  triangles.reserve(num_triangles);
+  for (int i = 0; i < num_triangles; i++)
+  {
+    std::array<int, 3> triangle;
+    for (int j = 0; j < 3; j++)
+    {
+      triangle[j] = vertex_indices[elements[3 * i + j]];
+    }
+
+    if (triangle[0] != TESS_UNDEF && triangle[1] != TESS_UNDEF && triangle[2] != TESS_UNDEF)
+    {
+      triangles.push_back(triangle);
+    }
+  }
+
+  tessDeleteTess(tessellator);
+  return true;
+}
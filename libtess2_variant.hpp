@@ -0,0 +1,24 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "dida/polygon2.hpp"
+
+using namespace dida;
+
+/// Triangulates @c polygon with the float, double or fixed point build of libtess2, or with its float build for 2D
+/// input only (see libtess2/tesselator.h).
+///
+/// Each function converts the vertices of @c polygon to the coordinate type of its build: the float, double and 2D only
+/// builds receive the rounded values of the coordinates, the fixed point build receives their exact numerators,
+/// relative to the center of the bounding box of @c polygon. Only if that doesn't fit in @c TESS_FIXED_MAX, the
+/// numerators are shifted right until it does, which loses their lowest bits.
+///
+/// The vertex indices of the triangles are written to @c triangles. Triangles with a vertex which was created by
+/// libtess2 itself, which only happens if the converted polygon isn't simple, are left out. Returns false if libtess2
+/// failed.
+bool triangulate_libtess2_float(PolygonView2 polygon, std::vector<std::array<int, 3>>& triangles);
+bool triangulate_libtess2_double(PolygonView2 polygon, std::vector<std::array<int, 3>>& triangles);
+bool triangulate_libtess2_fixed(PolygonView2 polygon, std::vector<std::array<int, 3>>& triangles);
+bool triangulate_libtess2_2d(PolygonView2 polygon, std::vector<std::array<int, 3>>& triangles);
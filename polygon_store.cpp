@@ -0,0 +1,170 @@
+#include "polygon_store.hpp"
+
+PolygonView2 PolygonStore::PolygonWithHolesView::outer_boundary() const
+{
+  return ring(rings_.offset);
+}
+
+size_t PolygonStore::PolygonWithHolesView::num_holes() const
+{
+  return rings_.size - 1;
+}
+
+PolygonView2 PolygonStore::PolygonWithHolesView::hole(size_t index) const
+{
+  DIDA_ASSERT(index < num_holes());
+  return ring(rings_.offset + 1 + static_cast<uint32_t>(index));
+}
+
+size_t PolygonStore::PolygonWithHolesView::num_vertices() const
+{
+  size_t result = 0;
+  for (uint32_t i = 0; i < rings_.size; i++)
+  {
+    result += store_->rings_[rings_.offset + i].size;
+  }
+
+  return result;
+}
+
+PolygonStore::PolygonWithHolesView::PolygonWithHolesView(const PolygonStore& store, Range rings)
+    : store_(&store), rings_(rings)
+{
+}
+
+PolygonView2 PolygonStore::PolygonWithHolesView::ring(uint32_t ring_index) const
+{
+  // All rings were validated when they were added to the store as part of a Polygon2, so there's no need to validate
+  // them again.
+  Range ring = store_->rings_[ring_index];
+  return PolygonView2::unsafe_from_vertices(ArrayView<const Point2>(store_->vertices_.data() + ring.offset, ring.size));
+}
+
+PolygonStore PolygonStore::from_countries(const CountriesGeoJson& countries)
+{
+  std::vector<std::string> country_names = countries.country_names();
+
+  size_t num_vertices = 0;
+  size_t num_rings = 0;
+  size_t num_polygons = 0;
+  for (const std::string& country_name : country_names)
+  {
+    for (const PolygonWithHoles2& part : countries.parts_for_country(country_name))
+    {
+      num_vertices += part.num_vertices();
+      num_rings += 1 + part.holes.size();
+      num_polygons++;
+    }
+  }
+
+  PolygonStore result;
+  result.reserve(num_vertices, num_rings, num_polygons);
+  for (const std::string& country_name : country_names)
+  {
+    result.add(country_name, countries.parts_for_country(country_name));
+  }
+
+  return result;
+}
+
+void PolygonStore::reserve(size_t num_vertices, size_t num_rings, size_t num_polygons)
+{
+  vertices_.reserve(num_vertices);
+  rings_.reserve(num_rings);
+  polygons_.reserve(num_polygons);
+}
+
+PolygonStore::NameId PolygonStore::add(std::string_view name, const std::vector<PolygonWithHoles2>& polygons)
+{
+  Range polygons_range{static_cast<uint32_t>(polygons_.size()), static_cast<uint32_t>(polygons.size())};
+
+  for (const PolygonWithHoles2& polygon : polygons)
+  {
+    Range rings_range{static_cast<uint32_t>(rings_.size()), static_cast<uint32_t>(1 + polygon.holes.size())};
+
+    rings_.push_back(
+        Range{static_cast<uint32_t>(vertices_.size()), static_cast<uint32_t>(polygon.outer_boundary.size())});
+    vertices_.insert(vertices_.end(), polygon.outer_boundary.begin(), polygon.outer_boundary.end());
+
+    for (const Polygon2& hole : polygon.holes)
+    {
+      rings_.push_back(Range{static_cast<uint32_t>(vertices_.size()), static_cast<uint32_t>(hole.size())});
+      vertices_.insert(vertices_.end(), hole.begin(), hole.end());
+    }
+
+    polygons_.push_back(rings_range);
+  }
+
+  std::pair<std::unordered_map<std::string, NameId>::iterator, bool> insert_result =
+      name_ids_.emplace(std::string(name), static_cast<NameId>(names_.size()));
+  if (insert_result.second)
+  {
+    names_.push_back(&insert_result.first->first);
+    name_polygons_.push_back(polygons_range);
+  }
+  else
+  {
+    name_polygons_[insert_result.first->second] = polygons_range;
+  }
+
+  return insert_result.first->second;
+}
+
+std::optional<PolygonStore::NameId> PolygonStore::find_name(std::string_view name) const
+{
+  std::unordered_map<std::string, NameId>::const_iterator it = name_ids_.find(std::string(name));
+  if (it == name_ids_.end())
+  {
+    return std::nullopt;
+  }
+
+  return it->second;
+}
+
+const std::string& PolygonStore::name(NameId name_id) const
+{
+  return *names_[name_id];
+}
+
+size_t PolygonStore::num_names() const
+{
+  return names_.size();
+}
+
+PolygonStore::Range PolygonStore::polygons_for_name(NameId name_id) const
+{
+  return name_polygons_[name_id];
+}
+
+size_t PolygonStore::num_polygons() const
+{
+  return polygons_.size();
+}
+
+PolygonStore::PolygonWithHolesView PolygonStore::polygon(size_t index) const
+{
+  return PolygonWithHolesView(*this, polygons_[index]);
+}
+
+ArrayView<const Point2> PolygonStore::vertices() const
+{
+  return ArrayView<const Point2>(vertices_.data(), vertices_.size());
+}
+
+size_t PolygonStore::memory_usage() const
+{
+  size_t result = geometry_memory_usage() + names_.capacity() * sizeof(const std::string*) +
+                  name_polygons_.capacity() * sizeof(Range);
+  for (const std::pair<const std::string, NameId>& name_id : name_ids_)
+  {
+    result += name_id.first.capacity() + sizeof(name_id);
+  }
+
+  return result;
+}
+
+size_t PolygonStore::geometry_memory_usage() const
+{
+  return vertices_.capacity() * sizeof(Point2) + rings_.capacity() * sizeof(Range) +
+         polygons_.capacity() * sizeof(Range);
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "countries_geojson.hpp"
+
+/// Stores a collection of named polygons with holes, with the vertices of all polygons in a single contiguous buffer.
+///
+/// Rings, polygons and names refer to their contents through compact (offset, size) ranges rather than through separate
+/// heap allocations, which makes sweeps over the whole collection prefetch friendly, and tearing down the store a
+/// matter of freeing a handful of buffers. Names are interned, so each name is stored once, and polygons refer to it
+/// by id.
+class PolygonStore
+{
+public:
+  PolygonStore() = default;
+
+  /// A store can't be copied, since @c names_ points into the keys of @c name_ids_, which would still point into the
+  /// source after a copy. Moving keeps the keys in place, so a store can be moved.
+  PolygonStore(const PolygonStore&) = delete;
+  PolygonStore& operator=(const PolygonStore&) = delete;
+  PolygonStore(PolygonStore&&) = default;
+  PolygonStore& operator=(PolygonStore&&) = default;
+
+  /// Creates a store containing all parts of all countries of @c countries, in alphabetical order of country name.
+  static PolygonStore from_countries(const CountriesGeoJson& countries);
+
+  /// The id of an interned name.
+  using NameId = uint32_t;
+
+  /// A range of elements in one of the buffers of the store.
+  struct Range
+  {
+    uint32_t offset;
+    uint32_t size;
+  };
+
+  /// A view of a polygon with holes in a @c PolygonStore. The view remains valid until the store is modified.
+  class PolygonWithHolesView
+  {
+  public:
+    /// Returns the outer boundary of this polygon.
+    PolygonView2 outer_boundary() const;
+
+    /// Returns the number of holes of this polygon.
+    size_t num_holes() const;
+
+    /// Returns the hole with the given index.
+    PolygonView2 hole(size_t index) const;
+
+    /// Returns the total number of vertices of the outer boundary and all holes.
+    size_t num_vertices() const;
+
+  private:
+    friend class PolygonStore;
+
+    PolygonWithHolesView(const PolygonStore& store, Range rings);
+
+    PolygonView2 ring(uint32_t ring_index) const;
+
+    const PolygonStore* store_;
+    Range rings_;
+  };
+
+  /// Reserves space for the given number of vertices, rings and polygons, so that adding them doesn't reallocate.
+  void reserve(size_t num_vertices, size_t num_rings, size_t num_polygons);
+
+  /// Adds @c polygons to the store under the given name, and returns the id of the interned name. If the name was
+  /// already used, the new polygons replace the range associated with it.
+  NameId add(std::string_view name, const std::vector<PolygonWithHoles2>& polygons);
+
+  /// Returns the id of @c name, or @c std::nullopt if no polygons were added under that name.
+  std::optional<NameId> find_name(std::string_view name) const;
+
+  /// Returns the name with the given id.
+  const std::string& name(NameId name_id) const;
+
+  /// Returns the number of distinct names in the store.
+  size_t num_names() const;
+
+  /// Returns the range of polygon indices which were added under the given name.
+  Range polygons_for_name(NameId name_id) const;
+
+  /// Returns the total number of polygons in the store.
+  size_t num_polygons() const;
+
+  /// Returns the polygon with the given index.
+  PolygonWithHolesView polygon(size_t index) const;
+
+  /// Returns the vertices of all rings of all polygons, in the order in which they were added.
+  ArrayView<const Point2> vertices() const;
+
+  /// Returns the number of bytes used by the buffers of the store.
+  size_t memory_usage() const;
+
+  /// Returns the number of bytes used by the vertices, rings and polygons of the store, leaving out the names. This is
+  /// the part of the store which a @c CompressedPolygonStore replaces.
+  size_t geometry_memory_usage() const;
+
+private:
+  std::vector<Point2> vertices_;
+
+  /// Each ring is a range in @c vertices_.
+  std::vector<Range> rings_;
+
+  /// Each polygon is a range in @c rings_. The first ring is the outer boundary, the remaining ones are holes.
+  std::vector<Range> polygons_;
+
+  /// Maps a name to its id. Doubles as the storage of the interned names, @c names_ points into its keys.
+  std::unordered_map<std::string, NameId> name_ids_;
+
+  /// The interned names, indexed by id.
+  std::vector<const std::string*> names_;
+
+  /// The range of polygons of each name, indexed by id.
+  std::vector<Range> name_polygons_;
+};
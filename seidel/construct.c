@@ -3,49 +3,49 @@
 #include <string.h>
 
 
-node_t qs[QSIZE];		/* Query structure */
-trap_t tr[TRSIZE];		/* Trapezoid structure */
-segment_t seg[SEGSIZE];		/* Segment table */
-
-static int q_idx;
-static int tr_idx;
-
 /* Return a new node to be added into the query tree */
-static int newnode()
+static int newnode(ctx)
+     seidel_context_t *ctx;
 {
-  if (q_idx < QSIZE)
-    return q_idx++;
-  else
-    {
-      fprintf(stderr, "newnode: Query-table overflow\n");
-      return -1;
-    }
+  if (ctx->q_idx >= ctx->q_size)
+    ctx->qs = (node_t *) grow_table(ctx, ctx->qs, &ctx->q_size,
+				    (size_t) ctx->q_idx + 1, sizeof(node_t));
+
+  memset((void *)&ctx->qs[ctx->q_idx], 0, sizeof(node_t));
+  return ctx->q_idx++;
 }
 
 /* Return a free trapezoid */
-static int newtrap()
+static int newtrap(ctx)
+     seidel_context_t *ctx;
 {
-  if (tr_idx < TRSIZE)
-    {
-      tr[tr_idx].lseg = -1;
-      tr[tr_idx].rseg = -1;
-      tr[tr_idx].state = ST_VALID;
-      return tr_idx++;
-    }
-  else
-    {
-      fprintf(stderr, "newtrap: Trapezoid-table overflow\n");
-      return -1;
-    }
+  if (ctx->tr_idx >= ctx->tr_size)
+    ctx->tr = (trap_t *) grow_table(ctx, ctx->tr, &ctx->tr_size,
+				    (size_t) ctx->tr_idx + 1, sizeof(trap_t));
+
+  memset((void *)&ctx->tr[ctx->tr_idx], 0, sizeof(trap_t));
+  ctx->tr[ctx->tr_idx].lseg = -1;
+  ctx->tr[ctx->tr_idx].rseg = -1;
+  ctx->tr[ctx->tr_idx].state = ST_VALID;
+  return ctx->tr_idx++;
 }
 
 
+/* Points are ordered by y, and points with the same y by x, as if */
+/* the plane were rotated by an infinitesimal angle, so that no two */
+/* distinct points have the same height. The comparisons are exact: */
+/* a tolerance would make distinct input points equal as soon as */
+/* they are spaced closer than it, and would not be transitive. */
+/* The tolerance build (SEIDEL_TOLERANCE) keeps the original */
+/* comparisons, which treat heights within C_EPS as equal. */
+
 /* Return the maximum of the two points into the yval structure */
 static int _max(yval, v0, v1)
      point_t *yval;
      point_t *v0;
      point_t *v1;
 {
+#ifdef SEIDEL_TOLERANCE
   if (v0->y > v1->y + C_EPS)
     *yval = *v0;
   else if (FP_EQUAL(v0->y, v1->y))
@@ -57,6 +57,12 @@ static int _max(yval, v0, v1)
     }
   else
     *yval = *v1;
+#else
+  if (_greater_than(v0, v1))
+    *yval = *v0;
+  else
+    *yval = *v1;
+#endif
   
   return 0;
 }
@@ -68,15 +74,8 @@ static int _min(yval, v0, v1)
      point_t *v0;
      point_t *v1;
 {
-  if (v0->y < v1->y - C_EPS)
+  if (_less_than(v0, v1))
     *yval = *v0;
-  else if (FP_EQUAL(v0->y, v1->y))
-    {
-      if (v0->x < v1->x)
-	*yval = *v0;
-      else
-	*yval = *v1;
-    }
   else
     *yval = *v1;
   
@@ -88,10 +87,15 @@ int _greater_than(v0, v1)
      point_t *v0;
      point_t *v1;
 {
+#ifdef SEIDEL_TOLERANCE
   if (v0->y > v1->y + C_EPS)
     return TRUE;
   else if (v0->y < v1->y - C_EPS)
     return FALSE;
+#else
+  if (v0->y != v1->y)
+    return (v0->y > v1->y);
+#endif
   else
     return (v0->x > v1->x);
 }
@@ -108,10 +112,15 @@ int _greater_than_equal_to(v0, v1)
      point_t *v0;
      point_t *v1;
 {
+#ifdef SEIDEL_TOLERANCE
   if (v0->y > v1->y + C_EPS)
     return TRUE;
   else if (v0->y < v1->y - C_EPS)
     return FALSE;
+#else
+  if (v0->y != v1->y)
+    return (v0->y > v1->y);
+#endif
   else
     return (v0->x >= v1->x);
 }
@@ -120,10 +129,15 @@ int _less_than(v0, v1)
      point_t *v0;
      point_t *v1;
 {
+#ifdef SEIDEL_TOLERANCE
   if (v0->y < v1->y - C_EPS)
     return TRUE;
   else if (v0->y > v1->y + C_EPS)
     return FALSE;
+#else
+  if (v0->y != v1->y)
+    return (v0->y < v1->y);
+#endif
   else
     return (v0->x < v1->x);
 }
@@ -142,138 +156,312 @@ int _less_than(v0, v1)
  *                3
  */
 
-static int init_query_structure(segnum)
+static int init_query_structure(ctx, segnum)
+     seidel_context_t *ctx;
      int segnum;
 {
   int i1, i2, i3, i4, i5, i6, i7, root;
   int t1, t2, t3, t4;
-  segment_t *s = &seg[segnum];
-
-  q_idx = tr_idx = 1;
-  memset((void *)tr, 0, sizeof(tr));
-  memset((void *)qs, 0, sizeof(qs));
-
-  i1 = newnode();
-  qs[i1].nodetype = T_Y;
-  _max(&qs[i1].yval, &s->v0, &s->v1); /* root */
+  segment_t *s = &ctx->seg[segnum];
+
+  /* Only the entries in use are cleared, each as it is handed out */
+  /* by newnode() and newtrap(), so that the setup cost is */
+  /* proportional to the input rather than to the table sizes. */
+  /* Entry 0 is never handed out. */
+  ctx->q_idx = ctx->tr_idx = 1;
+  memset((void *)&ctx->tr[0], 0, sizeof(trap_t));
+  memset((void *)&ctx->qs[0], 0, sizeof(node_t));
+
+  i1 = newnode(ctx);
+  ctx->qs[i1].nodetype = T_Y;
+  _max(&ctx->qs[i1].yval, &s->v0, &s->v1); /* root */
   root = i1;
 
-  qs[i1].right = i2 = newnode();
-  qs[i2].nodetype = T_SINK;
-  qs[i2].parent = i1;
+  i2 = newnode(ctx);
+  ctx->qs[i1].right = i2;
+  ctx->qs[i2].nodetype = T_SINK;
+  ctx->qs[i2].parent = i1;
 
-  qs[i1].left = i3 = newnode();
-  qs[i3].nodetype = T_Y;
-  _min(&qs[i3].yval, &s->v0, &s->v1); /* root */
-  qs[i3].parent = i1;
+  i3 = newnode(ctx);
+  ctx->qs[i1].left = i3;
+  ctx->qs[i3].nodetype = T_Y;
+  _min(&ctx->qs[i3].yval, &s->v0, &s->v1); /* root */
+  ctx->qs[i3].parent = i1;
   
-  qs[i3].left = i4 = newnode();
-  qs[i4].nodetype = T_SINK;
-  qs[i4].parent = i3;
+  i4 = newnode(ctx);
+  ctx->qs[i3].left = i4;
+  ctx->qs[i4].nodetype = T_SINK;
+  ctx->qs[i4].parent = i3;
   
-  qs[i3].right = i5 = newnode();
-  qs[i5].nodetype = T_X;
-  qs[i5].segnum = segnum;
-  qs[i5].parent = i3;
+  i5 = newnode(ctx);
+  ctx->qs[i3].right = i5;
+  ctx->qs[i5].nodetype = T_X;
+  ctx->qs[i5].segnum = segnum;
+  ctx->qs[i5].parent = i3;
   
-  qs[i5].left = i6 = newnode();
-  qs[i6].nodetype = T_SINK;
-  qs[i6].parent = i5;
-
-  qs[i5].right = i7 = newnode();
-  qs[i7].nodetype = T_SINK;
-  qs[i7].parent = i5;
-
-  t1 = newtrap();		/* middle left */
-  t2 = newtrap();		/* middle right */
-  t3 = newtrap();		/* bottom-most */
-  t4 = newtrap();		/* topmost */
-
-  tr[t1].hi = tr[t2].hi = tr[t4].lo = qs[i1].yval;
-  tr[t1].lo = tr[t2].lo = tr[t3].hi = qs[i3].yval;
-  tr[t4].hi.y = (double) (INFINITY);
-  tr[t4].hi.x = (double) (INFINITY);
-  tr[t3].lo.y = (double) -1* (INFINITY);
-  tr[t3].lo.x = (double) -1* (INFINITY);
-  tr[t1].rseg = tr[t2].lseg = segnum;
-  tr[t1].u0 = tr[t2].u0 = t4;
-  tr[t1].d0 = tr[t2].d0 = t3;
-  tr[t4].d0 = tr[t3].u0 = t1;
-  tr[t4].d1 = tr[t3].u1 = t2;
+  i6 = newnode(ctx);
+  ctx->qs[i5].left = i6;
+  ctx->qs[i6].nodetype = T_SINK;
+  ctx->qs[i6].parent = i5;
+
+  i7 = newnode(ctx);
+  ctx->qs[i5].right = i7;
+  ctx->qs[i7].nodetype = T_SINK;
+  ctx->qs[i7].parent = i5;
+
+  t1 = newtrap(ctx);		/* middle left */
+  t2 = newtrap(ctx);		/* middle right */
+  t3 = newtrap(ctx);		/* bottom-most */
+  t4 = newtrap(ctx);		/* topmost */
+
+  ctx->tr[t1].hi = ctx->tr[t2].hi = ctx->tr[t4].lo = ctx->qs[i1].yval;
+  ctx->tr[t1].lo = ctx->tr[t2].lo = ctx->tr[t3].hi = ctx->qs[i3].yval;
+  ctx->tr[t4].hi.y = (double) (INFINITY);
+  ctx->tr[t4].hi.x = (double) (INFINITY);
+  ctx->tr[t3].lo.y = (double) -1* (INFINITY);
+  ctx->tr[t3].lo.x = (double) -1* (INFINITY);
+  ctx->tr[t1].rseg = ctx->tr[t2].lseg = segnum;
+  ctx->tr[t1].u0 = ctx->tr[t2].u0 = t4;
+  ctx->tr[t1].d0 = ctx->tr[t2].d0 = t3;
+  ctx->tr[t4].d0 = ctx->tr[t3].u0 = t1;
+  ctx->tr[t4].d1 = ctx->tr[t3].u1 = t2;
   
-  tr[t1].sink = i6;
-  tr[t2].sink = i7;
-  tr[t3].sink = i4;
-  tr[t4].sink = i2;
+  ctx->tr[t1].sink = i6;
+  ctx->tr[t2].sink = i7;
+  ctx->tr[t3].sink = i4;
+  ctx->tr[t4].sink = i2;
 
-  tr[t1].state = tr[t2].state = ST_VALID;
-  tr[t3].state = tr[t4].state = ST_VALID;
+  ctx->tr[t1].state = ctx->tr[t2].state = ST_VALID;
+  ctx->tr[t3].state = ctx->tr[t4].state = ST_VALID;
 
-  qs[i2].trnum = t4;
-  qs[i4].trnum = t3;
-  qs[i6].trnum = t1;
-  qs[i7].trnum = t2;
+  ctx->qs[i2].trnum = t4;
+  ctx->qs[i4].trnum = t3;
+  ctx->qs[i6].trnum = t1;
+  ctx->qs[i7].trnum = t2;
 
   s->is_inserted = TRUE;
   return root;
 }
 
 
-/* Retun TRUE if the vertex v is to the left of line segment no.
- * segnum. Takes care of the degenerate cases when both the vertices
- * have the same y--cood, etc.
- */
+/* Exact arithmetic for orientation(), after Shewchuk, "Adaptive */
+/* Precision Floating-Point Arithmetic and Fast Robust Geometric */
+/* Predicates". A sum is kept as an expansion: an array of doubles */
+/* of increasing magnitude whose exact sum is the value, and whose */
+/* sign is the sign of its largest nonzero component. */
 
-static int is_left_of(segnum, v)
-     int segnum;
+#define EXACT_SPLITTER 134217729.0 /* 2^27 + 1 */
+#define EXACT_EPSILON 1.1102230246251565e-16 /* 2^-53 */
+#define ORIENT_ERRBOUND ((3.0 + 16.0 * EXACT_EPSILON) * EXACT_EPSILON)
+
+
+/* x + y = a + b exactly, where x is the rounded sum */
+static void two_sum(a, b, x, y)
+     double a, b;
+     double *x, *y;
+{
+  double bvirt, avirt;
+
+  *x = a + b;
+  bvirt = *x - a;
+  avirt = *x - bvirt;
+  *y = (a - avirt) + (b - bvirt);
+}
+
+
+/* x + y = a * b exactly, where x is the rounded product */
+static void two_product(a, b, x, y)
+     double a, b;
+     double *x, *y;
+{
+  double c, ahi, alo, bhi, blo;
+
+  c = EXACT_SPLITTER * a;
+  ahi = c - (c - a);
+  alo = a - ahi;
+  c = EXACT_SPLITTER * b;
+  bhi = c - (c - b);
+  blo = b - bhi;
+
+  *x = a * b;
+  *y = alo * blo - (((*x - ahi * bhi) - alo * bhi) - ahi * blo);
+}
+
+
+/* Add b to the expansion e of elen components, in place. Returns */
+/* the new number of components. */
+static int grow_expansion(elen, e, b)
+     int elen;
+     double *e;
+     double b;
+{
+  int i;
+
+  for (i = 0; i < elen; i++)
+    two_sum(b, e[i], &b, &e[i]);
+  e[elen] = b;
+
+  return elen + 1;
+}
+
+
+/* Sign of CROSS(v0, v1, v2), evaluated exactly. The determinant */
+/* is the sum of six products, v0 x v1 + v1 x v2 + v2 x v0, each */
+/* of which two_product() splits into two doubles. */
+static int orientation_exact(v0, v1, v2)
+     point_t *v0;
+     point_t *v1;
+     point_t *v2;
+{
+  double e[12], hi, lo;
+  int i, elen = 0;
+
+  two_product(v0->x, v1->y, &hi, &lo);
+  elen = grow_expansion(grow_expansion(elen, e, lo), e, hi);
+  two_product(-v0->y, v1->x, &hi, &lo);
+  elen = grow_expansion(grow_expansion(elen, e, lo), e, hi);
+  two_product(v1->x, v2->y, &hi, &lo);
+  elen = grow_expansion(grow_expansion(elen, e, lo), e, hi);
+  two_product(-v1->y, v2->x, &hi, &lo);
+  elen = grow_expansion(grow_expansion(elen, e, lo), e, hi);
+  two_product(v2->x, v0->y, &hi, &lo);
+  elen = grow_expansion(grow_expansion(elen, e, lo), e, hi);
+  two_product(-v2->y, v0->x, &hi, &lo);
+  elen = grow_expansion(grow_expansion(elen, e, lo), e, hi);
+
+  for (i = elen - 1; i >= 0; i--)
+    if (e[i] != 0.0)
+      return (e[i] > 0.0) ? 1 : -1;
+
+  return 0;
+}
+
+
+/* Return 1 if v2 is to the left of the line from v0 to v1, -1 if */
+/* it is to the right, and 0 if the three points are collinear. */
+/* The determinant is evaluated in floating point first, and only */
+/* recomputed exactly when it lies within its rounding error of */
+/* zero. */
+
+int orientation(v0, v1, v2)
+     point_t *v0;
+     point_t *v1;
+     point_t *v2;
+{
+  double detleft, detright, det, errbound;
+
+  detleft = (v1->x - v0->x) * (v2->y - v0->y);
+  detright = (v1->y - v0->y) * (v2->x - v0->x);
+  det = detleft - detright;
+  errbound = ORIENT_ERRBOUND * (fabs(detleft) + fabs(detright));
+
+  if (fabs(det) > errbound)
+    return (det > 0.0) - (det < 0.0);
+
+  return orientation_exact(v0, v1, v2);
+}
+
+
+/* Retun TRUE if the vertex v is to the left of the line segment */
+/* from v0 to v1. Takes care of the degenerate cases when both the */
+/* vertices have the same y--cood, etc. */
+
+int _left_of(v0, v1, v)
+     point_t *v0;
+     point_t *v1;
      point_t *v;
 {
-  segment_t *s = &seg[segnum];
+#ifdef SEIDEL_TOLERANCE
   double area;
-  
-  if (_greater_than(&s->v1, &s->v0)) /* seg. going upwards */
+
+  if (_greater_than(v1, v0)) /* seg. going upwards */
     {
-      if (FP_EQUAL(s->v1.y, v->y))
+      if (FP_EQUAL(v1->y, v->y))
 	{
-	  if (v->x < s->v1.x)
+	  if (v->x < v1->x)
 	    area = 1.0;
 	  else
 	    area = -1.0;
 	}
-      else if (FP_EQUAL(s->v0.y, v->y))
+      else if (FP_EQUAL(v0->y, v->y))
 	{
-	  if (v->x < s->v0.x)
+	  if (v->x < v0->x)
 	    area = 1.0;
 	  else
 	    area = -1.0;
 	}
       else
-	area = CROSS(s->v0, s->v1, (*v));
+	area = CROSS((*v0), (*v1), (*v));
     }
   else				/* v0 > v1 */
     {
-      if (FP_EQUAL(s->v1.y, v->y))
+      if (FP_EQUAL(v1->y, v->y))
 	{
-	  if (v->x < s->v1.x)
+	  if (v->x < v1->x)
 	    area = 1.0;
 	  else
 	    area = -1.0;
 	}
-      else if (FP_EQUAL(s->v0.y, v->y))
+      else if (FP_EQUAL(v0->y, v->y))
 	{
-	  if (v->x < s->v0.x)
+	  if (v->x < v0->x)
 	    area = 1.0;
 	  else
 	    area = -1.0;
 	}
       else
-	area = CROSS(s->v1, s->v0, (*v));
+	area = CROSS((*v1), (*v0), (*v));
     }
   
   if (area > 0.0)
     return TRUE;
   else 
     return FALSE;
+#else
+  point_t *lo, *hi;
+  double detleft, detright, area;
+
+  if (v->y == v1->y)
+    return (v->x < v1->x);
+  else if (v->y == v0->y)
+    return (v->x < v0->x);
+
+  if (_greater_than(v1, v0)) /* seg. going upwards */
+    {
+      lo = v0;
+      hi = v1;
+    }
+  else				/* v0 > v1 */
+    {
+      lo = v1;
+      hi = v0;
+    }
+
+  /* The filter of orientation(), repeated here so that it's */
+  /* inlined into the point location */
+  detleft = (hi->x - lo->x) * (v->y - lo->y);
+  detright = (hi->y - lo->y) * (v->x - lo->x);
+  area = detleft - detright;
+  if (fabs(area) <= ORIENT_ERRBOUND * (fabs(detleft) + fabs(detright)))
+    return (orientation_exact(lo, hi, v) > 0);
+
+  return (area > 0.0);
+#endif
+}
+
+
+/* Retun TRUE if the vertex v is to the left of line segment no.
+ * segnum.
+ */
+
+static int is_left_of(ctx, segnum, v)
+     seidel_context_t *ctx;
+     int segnum;
+     point_t *v;
+{
+  segment_t *s = &ctx->seg[segnum];
+
+  return _left_of(&s->v0, &s->v1, v);
 }
 
 
@@ -282,26 +470,28 @@ static int is_left_of(segnum, v)
 /* already inserted into the segment tree. Use the simple test of */
 /* whether the segment which shares this endpoint is already inserted */
 
-static int inserted(segnum, whichpt)
+static int inserted(ctx, segnum, whichpt)
+     seidel_context_t *ctx;
      int segnum;
      int whichpt;
 {
   if (whichpt == FIRSTPT)
-    return seg[seg[segnum].prev].is_inserted;
+    return ctx->seg[ctx->seg[segnum].prev].is_inserted;
   else
-    return seg[seg[segnum].next].is_inserted;
+    return ctx->seg[ctx->seg[segnum].next].is_inserted;
 }
 
 /* This is query routine which determines which trapezoid does the 
  * point v lie in. The return value is the trapezoid number. 
  */
 
-int locate_endpoint(v, vo, r)
+int locate_endpoint(ctx, v, vo, r)
+     seidel_context_t *ctx;
      point_t *v;
      point_t *vo;
      int r;
 {
-  node_t *rptr = &qs[r];
+  node_t *rptr = &ctx->qs[r];
   
   switch (rptr->nodetype)
     {
@@ -310,38 +500,38 @@ int locate_endpoint(v, vo, r)
       
     case T_Y:
       if (_greater_than(v, &rptr->yval)) /* above */
-	return locate_endpoint(v, vo, rptr->right);
+	return locate_endpoint(ctx, v, vo, rptr->right);
       else if (_equal_to(v, &rptr->yval)) /* the point is already */
 	{			          /* inserted. */
 	  if (_greater_than(vo, &rptr->yval)) /* above */
-	    return locate_endpoint(v, vo, rptr->right);
+	    return locate_endpoint(ctx, v, vo, rptr->right);
 	  else 
-	    return locate_endpoint(v, vo, rptr->left); /* below */	    
+	    return locate_endpoint(ctx, v, vo, rptr->left); /* below */	    
 	}
       else
-	return locate_endpoint(v, vo, rptr->left); /* below */
+	return locate_endpoint(ctx, v, vo, rptr->left); /* below */
 
     case T_X:
-      if (_equal_to(v, &seg[rptr->segnum].v0) || 
-	       _equal_to(v, &seg[rptr->segnum].v1))
+      if (_equal_to(v, &ctx->seg[rptr->segnum].v0) || 
+	       _equal_to(v, &ctx->seg[rptr->segnum].v1))
 	{
 	  if (FP_EQUAL(v->y, vo->y)) /* horizontal segment */
 	    {
 	      if (vo->x < v->x)
-		return locate_endpoint(v, vo, rptr->left); /* left */
+		return locate_endpoint(ctx, v, vo, rptr->left); /* left */
 	      else
-		return locate_endpoint(v, vo, rptr->right); /* right */
+		return locate_endpoint(ctx, v, vo, rptr->right); /* right */
 	    }
 
-	  else if (is_left_of(rptr->segnum, vo))
-	    return locate_endpoint(v, vo, rptr->left); /* left */
+	  else if (is_left_of(ctx, rptr->segnum, vo))
+	    return locate_endpoint(ctx, v, vo, rptr->left); /* left */
 	  else
-	    return locate_endpoint(v, vo, rptr->right); /* right */
+	    return locate_endpoint(ctx, v, vo, rptr->right); /* right */
 	}
-      else if (is_left_of(rptr->segnum, v))
-	return locate_endpoint(v, vo, rptr->left); /* left */
+      else if (is_left_of(ctx, rptr->segnum, v))
+	return locate_endpoint(ctx, v, vo, rptr->left); /* left */
       else
-	return locate_endpoint(v, vo, rptr->right); /* right */	
+	return locate_endpoint(ctx, v, vo, rptr->right); /* right */	
 
     default:
       fprintf(stderr, "Haggu !!!!!\n");
@@ -357,7 +547,8 @@ int locate_endpoint(v, vo, r)
  * divided because of its insertion
  */
 
-static int merge_trapezoids(segnum, tfirst, tlast, side)
+static int merge_trapezoids(ctx, segnum, tfirst, tlast, side)
+     seidel_context_t *ctx;
      int segnum;
      int tfirst;
      int tlast;
@@ -368,46 +559,46 @@ static int merge_trapezoids(segnum, tfirst, tlast, side)
 
   /* First merge polys on the LHS */
   t = tfirst;
-  while ((t > 0) && _greater_than_equal_to(&tr[t].lo, &tr[tlast].lo))
+  while ((t > 0) && _greater_than_equal_to(&ctx->tr[t].lo, &ctx->tr[tlast].lo))
     {
       if (side == S_LEFT)
-	cond = ((((tnext = tr[t].d0) > 0) && (tr[tnext].rseg == segnum)) ||
-		(((tnext = tr[t].d1) > 0) && (tr[tnext].rseg == segnum)));
+	cond = ((((tnext = ctx->tr[t].d0) > 0) && (ctx->tr[tnext].rseg == segnum)) ||
+		(((tnext = ctx->tr[t].d1) > 0) && (ctx->tr[tnext].rseg == segnum)));
       else
-	cond = ((((tnext = tr[t].d0) > 0) && (tr[tnext].lseg == segnum)) ||
-		(((tnext = tr[t].d1) > 0) && (tr[tnext].lseg == segnum)));
+	cond = ((((tnext = ctx->tr[t].d0) > 0) && (ctx->tr[tnext].lseg == segnum)) ||
+		(((tnext = ctx->tr[t].d1) > 0) && (ctx->tr[tnext].lseg == segnum)));
       
       if (cond)
 	{
-	  if ((tr[t].lseg == tr[tnext].lseg) &&
-	      (tr[t].rseg == tr[tnext].rseg)) /* good neighbours */
+	  if ((ctx->tr[t].lseg == ctx->tr[tnext].lseg) &&
+	      (ctx->tr[t].rseg == ctx->tr[tnext].rseg)) /* good neighbours */
 	    {			              /* merge them */
 	      /* Use the upper node as the new node i.e. t */
 	      
-	      ptnext = qs[tr[tnext].sink].parent;
+	      ptnext = ctx->qs[ctx->tr[tnext].sink].parent;
 	      
-	      if (qs[ptnext].left == tr[tnext].sink)
-		qs[ptnext].left = tr[t].sink;
+	      if (ctx->qs[ptnext].left == ctx->tr[tnext].sink)
+		ctx->qs[ptnext].left = ctx->tr[t].sink;
 	      else
-		qs[ptnext].right = tr[t].sink;	/* redirect parent */
+		ctx->qs[ptnext].right = ctx->tr[t].sink;	/* redirect parent */
 	      
 	      
 	      /* Change the upper neighbours of the lower trapezoids */
 	      
-	      if ((tr[t].d0 = tr[tnext].d0) > 0)
-		if (tr[tr[t].d0].u0 == tnext)
-		  tr[tr[t].d0].u0 = t;
-		else if (tr[tr[t].d0].u1 == tnext)
-		  tr[tr[t].d0].u1 = t;
+	      if ((ctx->tr[t].d0 = ctx->tr[tnext].d0) > 0)
+		if (ctx->tr[ctx->tr[t].d0].u0 == tnext)
+		  ctx->tr[ctx->tr[t].d0].u0 = t;
+		else if (ctx->tr[ctx->tr[t].d0].u1 == tnext)
+		  ctx->tr[ctx->tr[t].d0].u1 = t;
 	      
-	      if ((tr[t].d1 = tr[tnext].d1) > 0)
-		if (tr[tr[t].d1].u0 == tnext)
-		  tr[tr[t].d1].u0 = t;
-		else if (tr[tr[t].d1].u1 == tnext)
-		  tr[tr[t].d1].u1 = t;
+	      if ((ctx->tr[t].d1 = ctx->tr[tnext].d1) > 0)
+		if (ctx->tr[ctx->tr[t].d1].u0 == tnext)
+		  ctx->tr[ctx->tr[t].d1].u0 = t;
+		else if (ctx->tr[ctx->tr[t].d1].u1 == tnext)
+		  ctx->tr[ctx->tr[t].d1].u1 = t;
 	      
-	      tr[t].lo = tr[tnext].lo;
-	      tr[tnext].state = ST_INVALID; /* invalidate the lower */
+	      ctx->tr[t].lo = ctx->tr[tnext].lo;
+	      ctx->tr[tnext].state = ST_INVALID; /* invalidate the lower */
 				            /* trapezium */
 	    }
 	  else		    /* not good neighbours */
@@ -428,11 +619,12 @@ static int merge_trapezoids(segnum, tfirst, tlast, side)
  * the  lower trapezoid dividing all the trapezoids in between .
  */
 
-static int add_segment(segnum)
+static int add_segment(ctx, segnum)
+     seidel_context_t *ctx;
      int segnum;
 {
   segment_t s;
-  segment_t *so = &seg[segnum];
+  segment_t *so = &ctx->seg[segnum];
   int tu, tl, sk, tfirst, tlast, tnext;
   int tfirstr, tlastr, tfirstl, tlastl;
   int i1, i2, t, t1, t2, tn;
@@ -440,7 +632,7 @@ static int add_segment(segnum)
   int tritop = 0, tribot = 0, is_swapped = 0;
   int tmptriseg;
 
-  s = seg[segnum];
+  s = ctx->seg[segnum];
   if (_greater_than(&s.v1, &s.v0)) /* Get higher vertex in v0 */
     {
       int tmp;
@@ -453,119 +645,119 @@ static int add_segment(segnum)
       is_swapped = TRUE;
     }
 
-  if ((is_swapped) ? !inserted(segnum, LASTPT) :
-       !inserted(segnum, FIRSTPT))     /* insert v0 in the tree */
+  if ((is_swapped) ? !inserted(ctx, segnum, LASTPT) :
+       !inserted(ctx, segnum, FIRSTPT))     /* insert v0 in the tree */
     {
       int tmp_d;
 
-      tu = locate_endpoint(&s.v0, &s.v1, s.root0);
-      tl = newtrap();		/* tl is the new lower trapezoid */
-      tr[tl].state = ST_VALID;
-      tr[tl] = tr[tu];
-      tr[tu].lo.y = tr[tl].hi.y = s.v0.y;
-      tr[tu].lo.x = tr[tl].hi.x = s.v0.x;
-      tr[tu].d0 = tl;      
-      tr[tu].d1 = 0;
-      tr[tl].u0 = tu;
-      tr[tl].u1 = 0;
-
-      if (((tmp_d = tr[tl].d0) > 0) && (tr[tmp_d].u0 == tu))
-	tr[tmp_d].u0 = tl;
-      if (((tmp_d = tr[tl].d0) > 0) && (tr[tmp_d].u1 == tu))
-	tr[tmp_d].u1 = tl;
-
-      if (((tmp_d = tr[tl].d1) > 0) && (tr[tmp_d].u0 == tu))
-	tr[tmp_d].u0 = tl;
-      if (((tmp_d = tr[tl].d1) > 0) && (tr[tmp_d].u1 == tu))
-	tr[tmp_d].u1 = tl;
+      tu = locate_endpoint(ctx, &s.v0, &s.v1, s.root0);
+      tl = newtrap(ctx);		/* tl is the new lower trapezoid */
+      ctx->tr[tl].state = ST_VALID;
+      ctx->tr[tl] = ctx->tr[tu];
+      ctx->tr[tu].lo.y = ctx->tr[tl].hi.y = s.v0.y;
+      ctx->tr[tu].lo.x = ctx->tr[tl].hi.x = s.v0.x;
+      ctx->tr[tu].d0 = tl;      
+      ctx->tr[tu].d1 = 0;
+      ctx->tr[tl].u0 = tu;
+      ctx->tr[tl].u1 = 0;
+
+      if (((tmp_d = ctx->tr[tl].d0) > 0) && (ctx->tr[tmp_d].u0 == tu))
+	ctx->tr[tmp_d].u0 = tl;
+      if (((tmp_d = ctx->tr[tl].d0) > 0) && (ctx->tr[tmp_d].u1 == tu))
+	ctx->tr[tmp_d].u1 = tl;
+
+      if (((tmp_d = ctx->tr[tl].d1) > 0) && (ctx->tr[tmp_d].u0 == tu))
+	ctx->tr[tmp_d].u0 = tl;
+      if (((tmp_d = ctx->tr[tl].d1) > 0) && (ctx->tr[tmp_d].u1 == tu))
+	ctx->tr[tmp_d].u1 = tl;
 
       /* Now update the query structure and obtain the sinks for the */
       /* two trapezoids */ 
       
-      i1 = newnode();		/* Upper trapezoid sink */
-      i2 = newnode();		/* Lower trapezoid sink */
-      sk = tr[tu].sink;
+      i1 = newnode(ctx);		/* Upper trapezoid sink */
+      i2 = newnode(ctx);		/* Lower trapezoid sink */
+      sk = ctx->tr[tu].sink;
       
-      qs[sk].nodetype = T_Y;
-      qs[sk].yval = s.v0;
-      qs[sk].segnum = segnum;	/* not really reqd ... maybe later */
-      qs[sk].left = i2;
-      qs[sk].right = i1;
-
-      qs[i1].nodetype = T_SINK;
-      qs[i1].trnum = tu;
-      qs[i1].parent = sk;
-
-      qs[i2].nodetype = T_SINK;
-      qs[i2].trnum = tl;
-      qs[i2].parent = sk;
-
-      tr[tu].sink = i1;
-      tr[tl].sink = i2;
+      ctx->qs[sk].nodetype = T_Y;
+      ctx->qs[sk].yval = s.v0;
+      ctx->qs[sk].segnum = segnum;	/* not really reqd ... maybe later */
+      ctx->qs[sk].left = i2;
+      ctx->qs[sk].right = i1;
+
+      ctx->qs[i1].nodetype = T_SINK;
+      ctx->qs[i1].trnum = tu;
+      ctx->qs[i1].parent = sk;
+
+      ctx->qs[i2].nodetype = T_SINK;
+      ctx->qs[i2].trnum = tl;
+      ctx->qs[i2].parent = sk;
+
+      ctx->tr[tu].sink = i1;
+      ctx->tr[tl].sink = i2;
       tfirst = tl;
     }
   else				/* v0 already present */
     {       /* Get the topmost intersecting trapezoid */
-      tfirst = locate_endpoint(&s.v0, &s.v1, s.root0);
+      tfirst = locate_endpoint(ctx, &s.v0, &s.v1, s.root0);
       tritop = 1;
     }
 
 
-  if ((is_swapped) ? !inserted(segnum, FIRSTPT) :
-       !inserted(segnum, LASTPT))     /* insert v1 in the tree */
+  if ((is_swapped) ? !inserted(ctx, segnum, FIRSTPT) :
+       !inserted(ctx, segnum, LASTPT))     /* insert v1 in the tree */
     {
       int tmp_d;
 
-      tu = locate_endpoint(&s.v1, &s.v0, s.root1);
-
-      tl = newtrap();		/* tl is the new lower trapezoid */
-      tr[tl].state = ST_VALID;
-      tr[tl] = tr[tu];
-      tr[tu].lo.y = tr[tl].hi.y = s.v1.y;
-      tr[tu].lo.x = tr[tl].hi.x = s.v1.x;
-      tr[tu].d0 = tl;      
-      tr[tu].d1 = 0;
-      tr[tl].u0 = tu;
-      tr[tl].u1 = 0;
-
-      if (((tmp_d = tr[tl].d0) > 0) && (tr[tmp_d].u0 == tu))
-	tr[tmp_d].u0 = tl;
-      if (((tmp_d = tr[tl].d0) > 0) && (tr[tmp_d].u1 == tu))
-	tr[tmp_d].u1 = tl;
-
-      if (((tmp_d = tr[tl].d1) > 0) && (tr[tmp_d].u0 == tu))
-	tr[tmp_d].u0 = tl;
-      if (((tmp_d = tr[tl].d1) > 0) && (tr[tmp_d].u1 == tu))
-	tr[tmp_d].u1 = tl;
+      tu = locate_endpoint(ctx, &s.v1, &s.v0, s.root1);
+
+      tl = newtrap(ctx);		/* tl is the new lower trapezoid */
+      ctx->tr[tl].state = ST_VALID;
+      ctx->tr[tl] = ctx->tr[tu];
+      ctx->tr[tu].lo.y = ctx->tr[tl].hi.y = s.v1.y;
+      ctx->tr[tu].lo.x = ctx->tr[tl].hi.x = s.v1.x;
+      ctx->tr[tu].d0 = tl;      
+      ctx->tr[tu].d1 = 0;
+      ctx->tr[tl].u0 = tu;
+      ctx->tr[tl].u1 = 0;
+
+      if (((tmp_d = ctx->tr[tl].d0) > 0) && (ctx->tr[tmp_d].u0 == tu))
+	ctx->tr[tmp_d].u0 = tl;
+      if (((tmp_d = ctx->tr[tl].d0) > 0) && (ctx->tr[tmp_d].u1 == tu))
+	ctx->tr[tmp_d].u1 = tl;
+
+      if (((tmp_d = ctx->tr[tl].d1) > 0) && (ctx->tr[tmp_d].u0 == tu))
+	ctx->tr[tmp_d].u0 = tl;
+      if (((tmp_d = ctx->tr[tl].d1) > 0) && (ctx->tr[tmp_d].u1 == tu))
+	ctx->tr[tmp_d].u1 = tl;
       
       /* Now update the query structure and obtain the sinks for the */
       /* two trapezoids */ 
       
-      i1 = newnode();		/* Upper trapezoid sink */
-      i2 = newnode();		/* Lower trapezoid sink */
-      sk = tr[tu].sink;
+      i1 = newnode(ctx);		/* Upper trapezoid sink */
+      i2 = newnode(ctx);		/* Lower trapezoid sink */
+      sk = ctx->tr[tu].sink;
       
-      qs[sk].nodetype = T_Y;
-      qs[sk].yval = s.v1;
-      qs[sk].segnum = segnum;	/* not really reqd ... maybe later */
-      qs[sk].left = i2;
-      qs[sk].right = i1;
-
-      qs[i1].nodetype = T_SINK;
-      qs[i1].trnum = tu;
-      qs[i1].parent = sk;
-
-      qs[i2].nodetype = T_SINK;
-      qs[i2].trnum = tl;
-      qs[i2].parent = sk;
-
-      tr[tu].sink = i1;
-      tr[tl].sink = i2;
+      ctx->qs[sk].nodetype = T_Y;
+      ctx->qs[sk].yval = s.v1;
+      ctx->qs[sk].segnum = segnum;	/* not really reqd ... maybe later */
+      ctx->qs[sk].left = i2;
+      ctx->qs[sk].right = i1;
+
+      ctx->qs[i1].nodetype = T_SINK;
+      ctx->qs[i1].trnum = tu;
+      ctx->qs[i1].parent = sk;
+
+      ctx->qs[i2].nodetype = T_SINK;
+      ctx->qs[i2].trnum = tl;
+      ctx->qs[i2].parent = sk;
+
+      ctx->tr[tu].sink = i1;
+      ctx->tr[tl].sink = i2;
       tlast = tu;
     }
   else				/* v1 already present */
     {       /* Get the lowermost intersecting trapezoid */
-      tlast = locate_endpoint(&s.v1, &s.v0, s.root1);
+      tlast = locate_endpoint(ctx, &s.v1, &s.v0, s.root1);
       tribot = 1;
     }
   
@@ -576,42 +768,42 @@ static int add_segment(segnum)
   t = tfirst;			/* topmost trapezoid */
   
   while ((t > 0) && 
-	 _greater_than_equal_to(&tr[t].lo, &tr[tlast].lo))
+	 _greater_than_equal_to(&ctx->tr[t].lo, &ctx->tr[tlast].lo))
 				/* traverse from top to bot */
     {
       int t_sav, tn_sav;
-      sk = tr[t].sink;
-      i1 = newnode();		/* left trapezoid sink */
-      i2 = newnode();		/* right trapezoid sink */
+      sk = ctx->tr[t].sink;
+      i1 = newnode(ctx);		/* left trapezoid sink */
+      i2 = newnode(ctx);		/* right trapezoid sink */
       
-      qs[sk].nodetype = T_X;
-      qs[sk].segnum = segnum;
-      qs[sk].left = i1;
-      qs[sk].right = i2;
+      ctx->qs[sk].nodetype = T_X;
+      ctx->qs[sk].segnum = segnum;
+      ctx->qs[sk].left = i1;
+      ctx->qs[sk].right = i2;
 
-      qs[i1].nodetype = T_SINK;	/* left trapezoid (use existing one) */
-      qs[i1].trnum = t;
-      qs[i1].parent = sk;
+      ctx->qs[i1].nodetype = T_SINK;	/* left trapezoid (use existing one) */
+      ctx->qs[i1].trnum = t;
+      ctx->qs[i1].parent = sk;
 
-      qs[i2].nodetype = T_SINK;	/* right trapezoid (allocate new) */
-      qs[i2].trnum = tn = newtrap();
-      tr[tn].state = ST_VALID;
-      qs[i2].parent = sk;
+      ctx->qs[i2].nodetype = T_SINK;	/* right trapezoid (allocate new) */
+      ctx->qs[i2].trnum = tn = newtrap(ctx);
+      ctx->tr[tn].state = ST_VALID;
+      ctx->qs[i2].parent = sk;
 
       if (t == tfirst)
 	tfirstr = tn;
-      if (_equal_to(&tr[t].lo, &tr[tlast].lo))
+      if (_equal_to(&ctx->tr[t].lo, &ctx->tr[tlast].lo))
 	tlastr = tn;
 
-      tr[tn] = tr[t];
-      tr[t].sink = i1;
-      tr[tn].sink = i2;
+      ctx->tr[tn] = ctx->tr[t];
+      ctx->tr[t].sink = i1;
+      ctx->tr[tn].sink = i2;
       t_sav = t;
       tn_sav = tn;
 
       /* error */
 
-      if ((tr[t].d0 <= 0) && (tr[t].d1 <= 0)) /* case cannot arise */
+      if ((ctx->tr[t].d0 <= 0) && (ctx->tr[t].d1 <= 0)) /* case cannot arise */
 	{
 	  fprintf(stderr, "add_segment: error\n");
 	  break;
@@ -621,220 +813,218 @@ static int add_segment(segnum)
       /* two resulting trapezoids t and tn as the upper neighbours of */
       /* the sole lower trapezoid */
       
-      else if ((tr[t].d0 > 0) && (tr[t].d1 <= 0))
+      else if ((ctx->tr[t].d0 > 0) && (ctx->tr[t].d1 <= 0))
 	{			/* Only one trapezoid below */
-	  if ((tr[t].u0 > 0) && (tr[t].u1 > 0))
+	  if ((ctx->tr[t].u0 > 0) && (ctx->tr[t].u1 > 0))
 	    {			/* continuation of a chain from abv. */
-	      if (tr[t].usave > 0) /* three upper neighbours */
+	      if (ctx->tr[t].usave > 0) /* three upper neighbours */
 		{
-		  if (tr[t].uside == S_LEFT)
+		  if (ctx->tr[t].uside == S_LEFT)
 		    {
-		      tr[tn].u0 = tr[t].u1;
-		      tr[t].u1 = -1;
-		      tr[tn].u1 = tr[t].usave;
+		      ctx->tr[tn].u0 = ctx->tr[t].u1;
+		      ctx->tr[t].u1 = -1;
+		      ctx->tr[tn].u1 = ctx->tr[t].usave;
 		      
-		      tr[tr[t].u0].d0 = t;
-		      tr[tr[tn].u0].d0 = tn;
-		      tr[tr[tn].u1].d0 = tn;
+		      ctx->tr[ctx->tr[t].u0].d0 = t;
+		      ctx->tr[ctx->tr[tn].u0].d0 = tn;
+		      ctx->tr[ctx->tr[tn].u1].d0 = tn;
 		    }
 		  else		/* intersects in the right */
 		    {
-		      tr[tn].u1 = -1;
-		      tr[tn].u0 = tr[t].u1;
-		      tr[t].u1 = tr[t].u0;
-		      tr[t].u0 = tr[t].usave;
-
-		      tr[tr[t].u0].d0 = t;
-		      tr[tr[t].u1].d0 = t;
-		      tr[tr[tn].u0].d0 = tn;		      
+		      ctx->tr[tn].u1 = -1;
+		      ctx->tr[tn].u0 = ctx->tr[t].u1;
+		      ctx->tr[t].u1 = ctx->tr[t].u0;
+		      ctx->tr[t].u0 = ctx->tr[t].usave;
+
+		      ctx->tr[ctx->tr[t].u0].d0 = t;
+		      ctx->tr[ctx->tr[t].u1].d0 = t;
+		      ctx->tr[ctx->tr[tn].u0].d0 = tn;		      
 		    }
 		  
-		  tr[t].usave = tr[tn].usave = 0;
+		  ctx->tr[t].usave = ctx->tr[tn].usave = 0;
 		}
 	      else		/* No usave.... simple case */
 		{
-		  tr[tn].u0 = tr[t].u1;
-		  tr[t].u1 = tr[tn].u1 = -1;
-		  tr[tr[tn].u0].d0 = tn;
+		  ctx->tr[tn].u0 = ctx->tr[t].u1;
+		  ctx->tr[t].u1 = ctx->tr[tn].u1 = -1;
+		  ctx->tr[ctx->tr[tn].u0].d0 = tn;
 		}
 	    }
 	  else 
 	    {			/* fresh seg. or upward cusp */
-	      int tmp_u = tr[t].u0;
+	      int tmp_u = ctx->tr[t].u0;
 	      int td0, td1;
-	      if (((td0 = tr[tmp_u].d0) > 0) && 
-		  ((td1 = tr[tmp_u].d1) > 0))
+	      if (((td0 = ctx->tr[tmp_u].d0) > 0) && 
+		  ((td1 = ctx->tr[tmp_u].d1) > 0))
 		{		/* upward cusp */
-		  if ((tr[td0].rseg > 0) &&
-		      !is_left_of(tr[td0].rseg, &s.v1))
+		  if ((ctx->tr[td0].rseg > 0) &&
+		      !is_left_of(ctx, ctx->tr[td0].rseg, &s.v1))
 		    {
-		      tr[t].u0 = tr[t].u1 = tr[tn].u1 = -1;
-		      tr[tr[tn].u0].d1 = tn;
+		      ctx->tr[t].u0 = ctx->tr[t].u1 = ctx->tr[tn].u1 = -1;
+		      ctx->tr[ctx->tr[tn].u0].d1 = tn;
 		    }
 		  else		/* cusp going leftwards */
 		    { 
-		      tr[tn].u0 = tr[tn].u1 = tr[t].u1 = -1;
-		      tr[tr[t].u0].d0 = t;
+		      ctx->tr[tn].u0 = ctx->tr[tn].u1 = ctx->tr[t].u1 = -1;
+		      ctx->tr[ctx->tr[t].u0].d0 = t;
 		    }
 		}
 	      else		/* fresh segment */
 		{
-		  tr[tr[t].u0].d0 = t;
-		  tr[tr[t].u0].d1 = tn;
+		  ctx->tr[ctx->tr[t].u0].d0 = t;
+		  ctx->tr[ctx->tr[t].u0].d1 = tn;
 		}	      
 	    }
 	  
-	  if (FP_EQUAL(tr[t].lo.y, tr[tlast].lo.y) && 
-	      FP_EQUAL(tr[t].lo.x, tr[tlast].lo.x) && tribot)
+	  if (_equal_to(&ctx->tr[t].lo, &ctx->tr[tlast].lo) && tribot)
 	    {		/* bottom forms a triangle */
 
 	      if (is_swapped)	
-		tmptriseg = seg[segnum].prev;
+		tmptriseg = ctx->seg[segnum].prev;
 	      else
-		tmptriseg = seg[segnum].next;
+		tmptriseg = ctx->seg[segnum].next;
 	      
-	      if ((tmptriseg > 0) && is_left_of(tmptriseg, &s.v0))
+	      if ((tmptriseg > 0) && is_left_of(ctx, tmptriseg, &s.v0))
 		{
 				/* L-R downward cusp */
-		  tr[tr[t].d0].u0 = t;
-		  tr[tn].d0 = tr[tn].d1 = -1;
+		  ctx->tr[ctx->tr[t].d0].u0 = t;
+		  ctx->tr[tn].d0 = ctx->tr[tn].d1 = -1;
 		}
 	      else
 		{
 				/* R-L downward cusp */
-		  tr[tr[tn].d0].u1 = tn;
-		  tr[t].d0 = tr[t].d1 = -1;
+		  ctx->tr[ctx->tr[tn].d0].u1 = tn;
+		  ctx->tr[t].d0 = ctx->tr[t].d1 = -1;
 		}
 	    }
 	  else
 	    {
-	      if ((tr[tr[t].d0].u0 > 0) && (tr[tr[t].d0].u1 > 0))
+	      if ((ctx->tr[ctx->tr[t].d0].u0 > 0) && (ctx->tr[ctx->tr[t].d0].u1 > 0))
 		{
-		  if (tr[tr[t].d0].u0 == t) /* passes thru LHS */
+		  if (ctx->tr[ctx->tr[t].d0].u0 == t) /* passes thru LHS */
 		    {
-		      tr[tr[t].d0].usave = tr[tr[t].d0].u1;
-		      tr[tr[t].d0].uside = S_LEFT;
+		      ctx->tr[ctx->tr[t].d0].usave = ctx->tr[ctx->tr[t].d0].u1;
+		      ctx->tr[ctx->tr[t].d0].uside = S_LEFT;
 		    }
 		  else
 		    {
-		      tr[tr[t].d0].usave = tr[tr[t].d0].u0;
-		      tr[tr[t].d0].uside = S_RIGHT;
+		      ctx->tr[ctx->tr[t].d0].usave = ctx->tr[ctx->tr[t].d0].u0;
+		      ctx->tr[ctx->tr[t].d0].uside = S_RIGHT;
 		    }		    
 		}
-	      tr[tr[t].d0].u0 = t;
-	      tr[tr[t].d0].u1 = tn;
+	      ctx->tr[ctx->tr[t].d0].u0 = t;
+	      ctx->tr[ctx->tr[t].d0].u1 = tn;
 	    }
 	  
-	  t = tr[t].d0;
+	  t = ctx->tr[t].d0;
 	}
 
 
-      else if ((tr[t].d0 <= 0) && (tr[t].d1 > 0))
+      else if ((ctx->tr[t].d0 <= 0) && (ctx->tr[t].d1 > 0))
 	{			/* Only one trapezoid below */
-	  if ((tr[t].u0 > 0) && (tr[t].u1 > 0))
+	  if ((ctx->tr[t].u0 > 0) && (ctx->tr[t].u1 > 0))
 	    {			/* continuation of a chain from abv. */
-	      if (tr[t].usave > 0) /* three upper neighbours */
+	      if (ctx->tr[t].usave > 0) /* three upper neighbours */
 		{
-		  if (tr[t].uside == S_LEFT)
+		  if (ctx->tr[t].uside == S_LEFT)
 		    {
-		      tr[tn].u0 = tr[t].u1;
-		      tr[t].u1 = -1;
-		      tr[tn].u1 = tr[t].usave;
+		      ctx->tr[tn].u0 = ctx->tr[t].u1;
+		      ctx->tr[t].u1 = -1;
+		      ctx->tr[tn].u1 = ctx->tr[t].usave;
 		      
-		      tr[tr[t].u0].d0 = t;
-		      tr[tr[tn].u0].d0 = tn;
-		      tr[tr[tn].u1].d0 = tn;
+		      ctx->tr[ctx->tr[t].u0].d0 = t;
+		      ctx->tr[ctx->tr[tn].u0].d0 = tn;
+		      ctx->tr[ctx->tr[tn].u1].d0 = tn;
 		    }
 		  else		/* intersects in the right */
 		    {
-		      tr[tn].u1 = -1;
-		      tr[tn].u0 = tr[t].u1;
-		      tr[t].u1 = tr[t].u0;
-		      tr[t].u0 = tr[t].usave;
-
-		      tr[tr[t].u0].d0 = t;
-		      tr[tr[t].u1].d0 = t;
-		      tr[tr[tn].u0].d0 = tn;		      
+		      ctx->tr[tn].u1 = -1;
+		      ctx->tr[tn].u0 = ctx->tr[t].u1;
+		      ctx->tr[t].u1 = ctx->tr[t].u0;
+		      ctx->tr[t].u0 = ctx->tr[t].usave;
+
+		      ctx->tr[ctx->tr[t].u0].d0 = t;
+		      ctx->tr[ctx->tr[t].u1].d0 = t;
+		      ctx->tr[ctx->tr[tn].u0].d0 = tn;		      
 		    }
 		  
-		  tr[t].usave = tr[tn].usave = 0;
+		  ctx->tr[t].usave = ctx->tr[tn].usave = 0;
 		}
 	      else		/* No usave.... simple case */
 		{
-		  tr[tn].u0 = tr[t].u1;
-		  tr[t].u1 = tr[tn].u1 = -1;
-		  tr[tr[tn].u0].d0 = tn;
+		  ctx->tr[tn].u0 = ctx->tr[t].u1;
+		  ctx->tr[t].u1 = ctx->tr[tn].u1 = -1;
+		  ctx->tr[ctx->tr[tn].u0].d0 = tn;
 		}
 	    }
 	  else 
 	    {			/* fresh seg. or upward cusp */
-	      int tmp_u = tr[t].u0;
+	      int tmp_u = ctx->tr[t].u0;
 	      int td0, td1;
-	      if (((td0 = tr[tmp_u].d0) > 0) && 
-		  ((td1 = tr[tmp_u].d1) > 0))
+	      if (((td0 = ctx->tr[tmp_u].d0) > 0) && 
+		  ((td1 = ctx->tr[tmp_u].d1) > 0))
 		{		/* upward cusp */
-		  if ((tr[td0].rseg > 0) &&
-		      !is_left_of(tr[td0].rseg, &s.v1))
+		  if ((ctx->tr[td0].rseg > 0) &&
+		      !is_left_of(ctx, ctx->tr[td0].rseg, &s.v1))
 		    {
-		      tr[t].u0 = tr[t].u1 = tr[tn].u1 = -1;
-		      tr[tr[tn].u0].d1 = tn;
+		      ctx->tr[t].u0 = ctx->tr[t].u1 = ctx->tr[tn].u1 = -1;
+		      ctx->tr[ctx->tr[tn].u0].d1 = tn;
 		    }
 		  else 
 		    {
-		      tr[tn].u0 = tr[tn].u1 = tr[t].u1 = -1;
-		      tr[tr[t].u0].d0 = t;
+		      ctx->tr[tn].u0 = ctx->tr[tn].u1 = ctx->tr[t].u1 = -1;
+		      ctx->tr[ctx->tr[t].u0].d0 = t;
 		    }
 		}
 	      else		/* fresh segment */
 		{
-		  tr[tr[t].u0].d0 = t;
-		  tr[tr[t].u0].d1 = tn;
+		  ctx->tr[ctx->tr[t].u0].d0 = t;
+		  ctx->tr[ctx->tr[t].u0].d1 = tn;
 		}
 	    }
 	  
-	  if (FP_EQUAL(tr[t].lo.y, tr[tlast].lo.y) && 
-	      FP_EQUAL(tr[t].lo.x, tr[tlast].lo.x) && tribot)
+	  if (_equal_to(&ctx->tr[t].lo, &ctx->tr[tlast].lo) && tribot)
 	    {		/* bottom forms a triangle */
 	      int tmpseg;
 
 	      if (is_swapped)	
-		tmptriseg = seg[segnum].prev;
+		tmptriseg = ctx->seg[segnum].prev;
 	      else
-		tmptriseg = seg[segnum].next;
+		tmptriseg = ctx->seg[segnum].next;
 
-	      if ((tmpseg > 0) && is_left_of(tmpseg, &s.v0))
+	      if ((tmpseg > 0) && is_left_of(ctx, tmpseg, &s.v0))
 		{
 		  /* L-R downward cusp */
-		  tr[tr[t].d1].u0 = t;
-		  tr[tn].d0 = tr[tn].d1 = -1;
+		  ctx->tr[ctx->tr[t].d1].u0 = t;
+		  ctx->tr[tn].d0 = ctx->tr[tn].d1 = -1;
 		}
 	      else
 		{
 		  /* R-L downward cusp */
-		  tr[tr[tn].d1].u1 = tn;
-		  tr[t].d0 = tr[t].d1 = -1;
+		  ctx->tr[ctx->tr[tn].d1].u1 = tn;
+		  ctx->tr[t].d0 = ctx->tr[t].d1 = -1;
 		}
 	    }		
 	  else
 	    {
-	      if ((tr[tr[t].d1].u0 > 0) && (tr[tr[t].d1].u1 > 0))
+	      if ((ctx->tr[ctx->tr[t].d1].u0 > 0) && (ctx->tr[ctx->tr[t].d1].u1 > 0))
 		{
-		  if (tr[tr[t].d1].u0 == t) /* passes thru LHS */
+		  if (ctx->tr[ctx->tr[t].d1].u0 == t) /* passes thru LHS */
 		    {
-		      tr[tr[t].d1].usave = tr[tr[t].d1].u1;
-		      tr[tr[t].d1].uside = S_LEFT;
+		      ctx->tr[ctx->tr[t].d1].usave = ctx->tr[ctx->tr[t].d1].u1;
+		      ctx->tr[ctx->tr[t].d1].uside = S_LEFT;
 		    }
 		  else
 		    {
-		      tr[tr[t].d1].usave = tr[tr[t].d1].u0;
-		      tr[tr[t].d1].uside = S_RIGHT;
+		      ctx->tr[ctx->tr[t].d1].usave = ctx->tr[ctx->tr[t].d1].u0;
+		      ctx->tr[ctx->tr[t].d1].uside = S_RIGHT;
 		    }		    
 		}
-	      tr[tr[t].d1].u0 = t;
-	      tr[tr[t].d1].u1 = tn;
+	      ctx->tr[ctx->tr[t].d1].u0 = t;
+	      ctx->tr[ctx->tr[t].d1].u1 = tn;
 	    }
 	  
-	  t = tr[t].d1;
+	  t = ctx->tr[t].d1;
 	}
 
       /* two trapezoids below. Find out which one is intersected by */
@@ -842,148 +1032,158 @@ static int add_segment(segnum)
       
       else
 	{
-	  int tmpseg = tr[tr[t].d0].rseg;
-	  double y0, yt;
-	  point_t tmppt;
+	  int tmpseg = ctx->tr[ctx->tr[t].d0].rseg;
 	  int tnext, i_d0, i_d1;
 
 	  i_d0 = i_d1 = FALSE;
-	  if (FP_EQUAL(tr[t].lo.y, s.v0.y))
+	  if (FP_EQUAL(ctx->tr[t].lo.y, s.v0.y))
 	    {
-	      if (tr[t].lo.x > s.v0.x)
+	      if (ctx->tr[t].lo.x > s.v0.x)
 		i_d0 = TRUE;
 	      else
 		i_d1 = TRUE;
 	    }
 	  else
 	    {
-	      tmppt.y = y0 = tr[t].lo.y;
+#ifdef SEIDEL_TOLERANCE
+	      double y0, yt;
+	      point_t tmppt;
+
+	      tmppt.y = y0 = ctx->tr[t].lo.y;
 	      yt = (y0 - s.v0.y)/(s.v1.y - s.v0.y);
 	      tmppt.x = s.v0.x + yt * (s.v1.x - s.v0.x);
 	      
-	      if (_less_than(&tmppt, &tr[t].lo))
+	      if (_less_than(&tmppt, &ctx->tr[t].lo))
+		i_d0 = TRUE;
+	      else
+		i_d1 = TRUE;
+#else
+	      /* Whether the segment passes to the left of lo, which */
+	      /* it does if lo is to the right of the segment, as seen */
+	      /* going up from v1 to v0 */
+	      if (orientation(&s.v1, &s.v0, &ctx->tr[t].lo) < 0)
 		i_d0 = TRUE;
 	      else
 		i_d1 = TRUE;
+#endif
 	    }
 	  
 	  /* check continuity from the top so that the lower-neighbour */
 	  /* values are properly filled for the upper trapezoid */
 
-	  if ((tr[t].u0 > 0) && (tr[t].u1 > 0))
+	  if ((ctx->tr[t].u0 > 0) && (ctx->tr[t].u1 > 0))
 	    {			/* continuation of a chain from abv. */
-	      if (tr[t].usave > 0) /* three upper neighbours */
+	      if (ctx->tr[t].usave > 0) /* three upper neighbours */
 		{
-		  if (tr[t].uside == S_LEFT)
+		  if (ctx->tr[t].uside == S_LEFT)
 		    {
-		      tr[tn].u0 = tr[t].u1;
-		      tr[t].u1 = -1;
-		      tr[tn].u1 = tr[t].usave;
+		      ctx->tr[tn].u0 = ctx->tr[t].u1;
+		      ctx->tr[t].u1 = -1;
+		      ctx->tr[tn].u1 = ctx->tr[t].usave;
 		      
-		      tr[tr[t].u0].d0 = t;
-		      tr[tr[tn].u0].d0 = tn;
-		      tr[tr[tn].u1].d0 = tn;
+		      ctx->tr[ctx->tr[t].u0].d0 = t;
+		      ctx->tr[ctx->tr[tn].u0].d0 = tn;
+		      ctx->tr[ctx->tr[tn].u1].d0 = tn;
 		    }
 		  else		/* intersects in the right */
 		    {
-		      tr[tn].u1 = -1;
-		      tr[tn].u0 = tr[t].u1;
-		      tr[t].u1 = tr[t].u0;
-		      tr[t].u0 = tr[t].usave;
-
-		      tr[tr[t].u0].d0 = t;
-		      tr[tr[t].u1].d0 = t;
-		      tr[tr[tn].u0].d0 = tn;		      
+		      ctx->tr[tn].u1 = -1;
+		      ctx->tr[tn].u0 = ctx->tr[t].u1;
+		      ctx->tr[t].u1 = ctx->tr[t].u0;
+		      ctx->tr[t].u0 = ctx->tr[t].usave;
+
+		      ctx->tr[ctx->tr[t].u0].d0 = t;
+		      ctx->tr[ctx->tr[t].u1].d0 = t;
+		      ctx->tr[ctx->tr[tn].u0].d0 = tn;		      
 		    }
 		  
-		  tr[t].usave = tr[tn].usave = 0;
+		  ctx->tr[t].usave = ctx->tr[tn].usave = 0;
 		}
 	      else		/* No usave.... simple case */
 		{
-		  tr[tn].u0 = tr[t].u1;
-		  tr[tn].u1 = -1;
-		  tr[t].u1 = -1;
-		  tr[tr[tn].u0].d0 = tn;
+		  ctx->tr[tn].u0 = ctx->tr[t].u1;
+		  ctx->tr[tn].u1 = -1;
+		  ctx->tr[t].u1 = -1;
+		  ctx->tr[ctx->tr[tn].u0].d0 = tn;
 		}
 	    }
 	  else 
 	    {			/* fresh seg. or upward cusp */
-	      int tmp_u = tr[t].u0;
+	      int tmp_u = ctx->tr[t].u0;
 	      int td0, td1;
-	      if (((td0 = tr[tmp_u].d0) > 0) && 
-		  ((td1 = tr[tmp_u].d1) > 0))
+	      if (((td0 = ctx->tr[tmp_u].d0) > 0) && 
+		  ((td1 = ctx->tr[tmp_u].d1) > 0))
 		{		/* upward cusp */
-		  if ((tr[td0].rseg > 0) &&
-		      !is_left_of(tr[td0].rseg, &s.v1))
+		  if ((ctx->tr[td0].rseg > 0) &&
+		      !is_left_of(ctx, ctx->tr[td0].rseg, &s.v1))
 		    {
-		      tr[t].u0 = tr[t].u1 = tr[tn].u1 = -1;
-		      tr[tr[tn].u0].d1 = tn;
+		      ctx->tr[t].u0 = ctx->tr[t].u1 = ctx->tr[tn].u1 = -1;
+		      ctx->tr[ctx->tr[tn].u0].d1 = tn;
 		    }
 		  else 
 		    {
-		      tr[tn].u0 = tr[tn].u1 = tr[t].u1 = -1;
-		      tr[tr[t].u0].d0 = t;
+		      ctx->tr[tn].u0 = ctx->tr[tn].u1 = ctx->tr[t].u1 = -1;
+		      ctx->tr[ctx->tr[t].u0].d0 = t;
 		    }
 		}
 	      else		/* fresh segment */
 		{
-		  tr[tr[t].u0].d0 = t;
-		  tr[tr[t].u0].d1 = tn;
+		  ctx->tr[ctx->tr[t].u0].d0 = t;
+		  ctx->tr[ctx->tr[t].u0].d1 = tn;
 		}
 	    }
 	  
-	  if (FP_EQUAL(tr[t].lo.y, tr[tlast].lo.y) && 
-	      FP_EQUAL(tr[t].lo.x, tr[tlast].lo.x) && tribot)
+	  if (_equal_to(&ctx->tr[t].lo, &ctx->tr[tlast].lo) && tribot)
 	    {
 	      /* this case arises only at the lowest trapezoid.. i.e.
 		 tlast, if the lower endpoint of the segment is
 		 already inserted in the structure */
 	      
-	      tr[tr[t].d0].u0 = t;
-	      tr[tr[t].d0].u1 = -1;
-	      tr[tr[t].d1].u0 = tn;
-	      tr[tr[t].d1].u1 = -1;
+	      ctx->tr[ctx->tr[t].d0].u0 = t;
+	      ctx->tr[ctx->tr[t].d0].u1 = -1;
+	      ctx->tr[ctx->tr[t].d1].u0 = tn;
+	      ctx->tr[ctx->tr[t].d1].u1 = -1;
 
-	      tr[tn].d0 = tr[t].d1;
-	      tr[t].d1 = tr[tn].d1 = -1;
+	      ctx->tr[tn].d0 = ctx->tr[t].d1;
+	      ctx->tr[t].d1 = ctx->tr[tn].d1 = -1;
 	      
-	      tnext = tr[t].d1;	      
+	      tnext = ctx->tr[t].d1;	      
 	    }
 	  else if (i_d0)
 				/* intersecting d0 */
 	    {
-	      tr[tr[t].d0].u0 = t;
-	      tr[tr[t].d0].u1 = tn;
-	      tr[tr[t].d1].u0 = tn;
-	      tr[tr[t].d1].u1 = -1;
+	      ctx->tr[ctx->tr[t].d0].u0 = t;
+	      ctx->tr[ctx->tr[t].d0].u1 = tn;
+	      ctx->tr[ctx->tr[t].d1].u0 = tn;
+	      ctx->tr[ctx->tr[t].d1].u1 = -1;
 	      
 	      /* new code to determine the bottom neighbours of the */
 	      /* newly partitioned trapezoid */
 	      
-	      tr[t].d1 = -1;
+	      ctx->tr[t].d1 = -1;
 
-	      tnext = tr[t].d0;
+	      tnext = ctx->tr[t].d0;
 	    }
 	  else			/* intersecting d1 */
 	    {
-	      tr[tr[t].d0].u0 = t;
-	      tr[tr[t].d0].u1 = -1;
-	      tr[tr[t].d1].u0 = t;
-	      tr[tr[t].d1].u1 = tn;
+	      ctx->tr[ctx->tr[t].d0].u0 = t;
+	      ctx->tr[ctx->tr[t].d0].u1 = -1;
+	      ctx->tr[ctx->tr[t].d1].u0 = t;
+	      ctx->tr[ctx->tr[t].d1].u1 = tn;
 
 	      /* new code to determine the bottom neighbours of the */
 	      /* newly partitioned trapezoid */
 	      
-	      tr[tn].d0 = tr[t].d1;
-	      tr[tn].d1 = -1;
+	      ctx->tr[tn].d0 = ctx->tr[t].d1;
+	      ctx->tr[tn].d1 = -1;
 	      
-	      tnext = tr[t].d1;
+	      tnext = ctx->tr[t].d1;
 	    }	    
 	  
 	  t = tnext;
 	}
       
-      tr[t_sav].rseg = tr[tn_sav].lseg  = segnum;
+      ctx->tr[t_sav].rseg = ctx->tr[tn_sav].lseg  = segnum;
     } /* end-while */
   
   /* Now combine those trapezoids which share common segments. We can */
@@ -993,10 +1193,10 @@ static int add_segment(segnum)
 
   tfirstl = tfirst; 
   tlastl = tlast;
-  merge_trapezoids(segnum, tfirstl, tlastl, S_LEFT);
-  merge_trapezoids(segnum, tfirstr, tlastr, S_RIGHT);
+  merge_trapezoids(ctx, segnum, tfirstl, tlastl, S_LEFT);
+  merge_trapezoids(ctx, segnum, tfirstr, tlastr, S_RIGHT);
 
-  seg[segnum].is_inserted = TRUE;
+  ctx->seg[segnum].is_inserted = TRUE;
   return 0;
 }
 
@@ -1005,25 +1205,27 @@ static int add_segment(segnum)
  * This is done to speed up the location-query for the endpoint when
  * the segment is inserted into the trapezoidation subsequently
  */
-static int find_new_roots(segnum)
+static int find_new_roots(ctx, segnum)
+     seidel_context_t *ctx;
      int segnum;
 {
-  segment_t *s = &seg[segnum];
+  segment_t *s = &ctx->seg[segnum];
   
   if (s->is_inserted)
     return 0;
 
-  s->root0 = locate_endpoint(&s->v0, &s->v1, s->root0);
-  s->root0 = tr[s->root0].sink;
+  s->root0 = locate_endpoint(ctx, &s->v0, &s->v1, s->root0);
+  s->root0 = ctx->tr[s->root0].sink;
 
-  s->root1 = locate_endpoint(&s->v1, &s->v0, s->root1);
-  s->root1 = tr[s->root1].sink;  
+  s->root1 = locate_endpoint(ctx, &s->v1, &s->v0, s->root1);
+  s->root1 = ctx->tr[s->root1].sink;  
   return 0;
 }
 
 
 /* Main routine to perform trapezoidation */
-int construct_trapezoids(nseg)
+int construct_trapezoids(ctx, nseg)
+     seidel_context_t *ctx;
      int nseg;
 {
   register int i;
@@ -1032,23 +1234,23 @@ int construct_trapezoids(nseg)
   /* Add the first segment and get the query structure and trapezoid */
   /* list initialised */
 
-  root = init_query_structure(choose_segment());
+  root = init_query_structure(ctx, choose_segment(ctx));
 
   for (i = 1; i <= nseg; i++)
-    seg[i].root0 = seg[i].root1 = root;
+    ctx->seg[i].root0 = ctx->seg[i].root1 = root;
   
   for (h = 1; h <= math_logstar_n(nseg); h++)
     {
       for (i = math_N(nseg, h -1) + 1; i <= math_N(nseg, h); i++)
-	add_segment(choose_segment());
+	add_segment(ctx, choose_segment(ctx));
       
       /* Find a new root for each of the segment endpoints */
       for (i = 1; i <= nseg; i++)
-	find_new_roots(i);
+	find_new_roots(ctx, i);
     }
   
   for (i = math_N(nseg, math_logstar_n(nseg)) + 1; i <= nseg; i++)
-    add_segment(choose_segment());
+    add_segment(ctx, choose_segment(ctx));
 
   return 0;
 }
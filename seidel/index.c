@@ -0,0 +1,309 @@
+#include "triangulate.h"
+#include <string.h>
+
+
+/* Number of points which seidel_index_are_points_inside() walks */
+/* down the index at the same time */
+#define IX_BATCH 8
+
+
+/* Number of nodes which make up a block of the index: a query */
+/* node and the descendants which follow it, breadth first. With */
+/* 16 byte nodes, a block fills two cache lines. Blocks of 8 came */
+/* out faster than blocks of 4 or 16. */
+#define IX_BLOCK 8
+
+
+/* Return the reference for the query node q, given its place in */
+/* the index. Sinks become leaves. */
+static int index_ref(ctx, map, q)
+     seidel_context_t *ctx;
+     int *map;
+     int q;
+{
+  node_t *node = &ctx->qs[q];
+
+  if (node->nodetype == T_SINK)
+    return is_inside_trapezoid(ctx, node->trnum) ? IX_INSIDE : IX_OUTSIDE;
+  return map[q];
+}
+
+
+/* Append the query node q to the index, with the numbers of its */
+/* query node children, which are replaced by references once */
+/* every node has its place. map holds the reference of every */
+/* query node appended so far, and -1 for the others. */
+static void index_append(ctx, index, map, q)
+     seidel_context_t *ctx;
+     seidel_index_t *index;
+     int *map;
+     int q;
+{
+  node_t *node = &ctx->qs[q];
+  int i = index->nnodes++;
+  index_node_t *inode = &index->nodes[i];
+
+  if (node->nodetype == T_Y)
+    {
+      inode->key.y = node->yval.y;
+      index->xs[i] = node->yval.x;
+      map[q] = IX_REF(i, IX_Y);
+    }
+  else
+    {
+      inode->key.segnum = node->segnum;
+      map[q] = IX_REF(i, IX_X);
+    }
+  inode->left = node->left;
+  inode->right = node->right;
+}
+
+
+/* Whether the query node q still has to be appended to the index */
+static int index_pending(ctx, map, q)
+     seidel_context_t *ctx;
+     int *map;
+     int q;
+{
+  return (ctx->qs[q].nodetype != T_SINK) && (map[q] < 0);
+}
+
+
+/* Fill in the index over the polygon, using ctx for the query */
+/* structure. Jumps to ctx->env if out of memory. Kept apart from */
+/* seidel_create_index(), so that its locals aren't live across */
+/* the setjmp() there. */
+static void build_index(ctx, index, ncontours, cntr, vertices)
+     seidel_context_t *ctx;
+     seidel_index_t *index;
+     int ncontours;
+     int cntr[];
+     double (*vertices)[2];
+{
+  index_node_t *nodes;
+  double *xs;
+  int *map, *queue;
+  int i, j, k, n, q, first, size = 0, head = 0, tail = 0;
+
+  n = load_contours(ctx, ncontours, cntr, vertices);
+  generate_random_ordering(ctx, n);
+  construct_trapezoids(ctx, n);
+
+  index->ends = (point_t *) grow_table(ctx, index->ends, &size,
+				       2 * ((size_t) n + 1), sizeof(point_t));
+  for (i = 1; i <= n; i++)
+    {
+      index->ends[2 * i] = ctx->seg[i].v0;
+      index->ends[2 * i + 1] = ctx->seg[i].v1;
+    }
+
+  size = 0;
+  index->nodes = (index_node_t *) grow_table(ctx, index->nodes, &size,
+					     (size_t) ctx->q_idx,
+					     sizeof(index_node_t));
+  size = 0;
+  index->xs = (double *) grow_table(ctx, index->xs, &size,
+				    (size_t) ctx->q_idx, sizeof(double));
+
+  /* The context is thrown away afterwards, so its visited table */
+  /* can serve as the map from query nodes to index nodes, and its */
+  /* mon table as the queue of nodes which start a block. Every */
+  /* node is queued at most once by each of its parents. */
+  ctx->visited = (int *) grow_table(ctx, ctx->visited, &ctx->visited_size,
+				    (size_t) ctx->q_idx, sizeof(int));
+  ctx->mon = (int *) grow_table(ctx, ctx->mon, &ctx->mon_size,
+				2 * (size_t) ctx->q_idx + 1, sizeof(int));
+  map = ctx->visited;
+  queue = ctx->mon;
+  for (i = 0; i < ctx->q_idx; i++)
+    map[i] = -1;
+
+  /* Lay the query structure out in blocks, starting at its root */
+  /* (see init_query_structure()). Each block holds a node and the */
+  /* descendants which follow it breadth first, so that a query */
+  /* takes a few steps on each cache line it loads, and the blocks */
+  /* follow each other breadth first, so that the levels near the */
+  /* root, which every query visits, are kept together. */
+  queue[tail++] = 1;
+  while (head < tail)
+    {
+      if (!index_pending(ctx, map, queue[head]))
+	{
+	  head++;
+	  continue;
+	}
+
+      first = index->nnodes;
+      index_append(ctx, index, map, queue[head++]);
+      for (j = first; j < index->nnodes; j++)
+	for (k = 0; k < 2; k++)
+	  {
+	    q = k ? index->nodes[j].right : index->nodes[j].left;
+	    if (!index_pending(ctx, map, q))
+	      continue;
+	    if (index->nnodes - first < IX_BLOCK)
+	      index_append(ctx, index, map, q);
+	    else
+	      queue[tail++] = q;
+	  }
+    }
+
+  for (i = 0; i < index->nnodes; i++)
+    {
+      index->nodes[i].left = index_ref(ctx, map, index->nodes[i].left);
+      index->nodes[i].right = index_ref(ctx, map, index->nodes[i].right);
+    }
+  index->root = index_ref(ctx, map, 1);
+
+  /* Without the sinks, the index needs fewer nodes than the query */
+  /* structure */
+  nodes = (index_node_t *) realloc(index->nodes,
+				   index->nnodes * sizeof(index_node_t));
+  if (nodes != NULL)
+    index->nodes = nodes;
+  xs = (double *) realloc(index->xs, index->nnodes * sizeof(double));
+  if (xs != NULL)
+    index->xs = xs;
+}
+
+
+/* Build an index over the polygon. Returns NULL if out of memory. */
+seidel_index_t *seidel_create_index(ncontours, cntr, vertices)
+     int ncontours;
+     int cntr[];
+     double (*vertices)[2];
+{
+  seidel_context_t *ctx;
+  seidel_index_t *volatile index;	/* freed after a longjmp() */
+
+  if ((index = (seidel_index_t *) calloc(1, sizeof(seidel_index_t))) == NULL)
+    return NULL;
+
+  if ((ctx = seidel_create_context()) == NULL)
+    {
+      free(index);
+      return NULL;
+    }
+
+  if (setjmp(ctx->env))
+    {
+      seidel_destroy_context(ctx);
+      seidel_destroy_index(index);
+      return NULL;
+    }
+
+  build_index(ctx, index, ncontours, cntr, vertices);
+
+  seidel_destroy_context(ctx);
+  return index;
+}
+
+
+void seidel_destroy_index(index)
+     seidel_index_t *index;
+{
+  if (index == NULL)
+    return;
+
+  free(index->nodes);
+  free(index->xs);
+  free(index->ends);
+  free(index);
+}
+
+
+/* Take one step down the index from the node ref, towards the */
+/* leaf of the point v. The tests are those locate_endpoint() */
+/* makes for a point query. */
+static int index_step(index, ref, v)
+     const seidel_index_t *index;
+     int ref;
+     point_t *v;
+{
+  const index_node_t *node = &index->nodes[IX_NODE(ref)];
+  point_t *s;
+
+  if (IX_KIND(ref) == IX_Y)
+    {
+      if (v->y != node->key.y)
+	return (v->y > node->key.y) ? node->right : node->left;
+      return (v->x > index->xs[IX_NODE(ref)]) ? node->right : node->left;
+    }
+
+  s = &index->ends[2 * node->key.segnum];
+  if (_equal_to(v, &s[0]) || _equal_to(v, &s[1]))
+    return node->right;
+  return _left_of(&s[0], &s[1], v) ? node->left : node->right;
+}
+
+
+int seidel_index_is_point_inside(index, vertex)
+     const seidel_index_t *index;
+     double vertex[2];
+{
+  point_t v;
+  int ref = index->root;
+
+  v.x = vertex[0];
+  v.y = vertex[1];
+
+  while (IX_KIND(ref) < IX_OUTSIDE)
+    ref = index_step(index, ref, &v);
+
+  return IX_KIND(ref) == IX_INSIDE;
+}
+
+
+/* Sets inside[i] to whether points[i] is inside the polygon, for */
+/* all npoints points. IX_BATCH points walk down the index in turns, */
+/* one step at a time, and each step prefetches the next node of */
+/* its point, so that the cache misses of the different points */
+/* overlap. A point which reaches its leaf makes room for the next */
+/* one. */
+void seidel_index_are_points_inside(index, npoints, points, inside)
+     const seidel_index_t *index;
+     int npoints;
+     double (*points)[2];
+     int inside[];
+{
+  point_t v[IX_BATCH];
+  int ref[IX_BATCH], pos[IX_BATCH];
+  int j, nlanes, active, next;
+
+  for (next = 0; (next < npoints) && (next < IX_BATCH); next++)
+    {
+      v[next].x = points[next][0];
+      v[next].y = points[next][1];
+      ref[next] = index->root;
+      pos[next] = next;
+    }
+  nlanes = active = next;
+
+  while (active > 0)
+    for (j = 0; j < nlanes; j++)
+      {
+	if (pos[j] < 0)
+	  continue;
+
+	ref[j] = index_step(index, ref[j], &v[j]);
+	if (IX_KIND(ref[j]) < IX_OUTSIDE)
+	  {
+	    PREFETCH(&index->nodes[IX_NODE(ref[j])]);
+	    continue;
+	  }
+
+	inside[pos[j]] = (IX_KIND(ref[j]) == IX_INSIDE);
+	if (next < npoints)
+	  {
+	    v[j].x = points[next][0];
+	    v[j].y = points[next][1];
+	    ref[j] = index->root;
+	    pos[j] = next++;
+	  }
+	else
+	  {
+	    pos[j] = -1;
+	    active--;
+	  }
+      }
+}
@@ -0,0 +1,67 @@
+#ifndef _interface_h
+#define _interface_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A triangulation context owns all the tables used by the */
+/* triangulator. A context can be reused for any number of */
+/* triangulations, but by one thread at a time. Threads which */
+/* triangulate concurrently each need their own context. */
+
+typedef struct seidel_context seidel_context_t;
+
+extern seidel_context_t *seidel_create_context(void);
+extern void seidel_destroy_context(seidel_context_t *);
+
+extern int seidel_triangulate_polygon(seidel_context_t *, int, int *,
+				      double (*)[2], int (*)[3]);
+extern int seidel_is_point_inside_polygon(seidel_context_t *, double *);
+
+/* The same, on a context shared by the whole process. These are */
+/* not reentrant. */
+
+extern int triangulate_polygon(int, int *, double (*)[2], int (*)[3]);
+extern int is_point_inside_polygon(double *);
+
+/* triangulate_polygon() of the seidel_tolerance library, which */
+/* compares points with the original tolerance C_EPS rather than */
+/* exactly (see SEIDEL_TOLERANCE in triangulate.h). */
+
+extern int triangulate_polygon_tolerance(int, int *, double (*)[2],
+					 int (*)[3]);
+
+/* The segments are added in a random order. By default, each */
+/* triangulation seeds the order from the time of day. Once a seed */
+/* is set with seidel_set_seed(), every triangulation in the */
+/* context uses that seed, so runs can be reproduced. */
+/* seidel_get_seed() returns the seed used by the last */
+/* triangulation in the context. */
+
+extern void seidel_set_seed(seidel_context_t *, unsigned long long);
+extern unsigned long long seidel_get_seed(seidel_context_t *);
+
+/* A point-location index over a polygon, given in the same way as */
+/* to seidel_triangulate_polygon(). It keeps the query structure */
+/* of the trapezoidation in a compact table, and answers whether */
+/* points are inside the polygon in O(log n) expected time. */
+/* seidel_index_are_points_inside() locates several points at */
+/* once, overlapping their cache misses. Like */
+/* seidel_is_point_inside_polygon(), results for points on the */
+/* boundary are not consistent. An index is not modified by */
+/* queries, so threads can share it. */
+
+typedef struct seidel_index seidel_index_t;
+
+extern seidel_index_t *seidel_create_index(int, int *, double (*)[2]);
+extern void seidel_destroy_index(seidel_index_t *);
+extern int seidel_index_is_point_inside(const seidel_index_t *, double *);
+extern void seidel_index_are_points_inside(const seidel_index_t *, int,
+					   double (*)[2], int *);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* interface_h */
@@ -1,6 +1,8 @@
 #include "triangulate.h"
 #include <sys/time.h>
 #include <math.h>
+#include <limits.h>
+#include <string.h>
 
 #ifdef __STDC__
 extern double log2(double);
@@ -8,33 +10,88 @@ extern double log2(double);
 extern double log2();
 #endif
 
-static int choose_idx;
-static int permute[SEGSIZE];
+
+/* Make room for at least needed entries of elsize bytes in table, */
+/* which has room for *size entries, and return the table. Tables */
+/* grow by doubling, so that filling one entry at a time takes */
+/* amortized constant time. If the table can't grow, this jumps */
+/* to ctx->env, leaving the table as it was. */
+void *grow_table(ctx, table, size, needed, elsize)
+     seidel_context_t *ctx;
+     void *table;
+     int *size;
+     size_t needed;
+     size_t elsize;
+{
+  size_t new_size;
+  void *new_table;
+
+  if (needed <= (size_t) *size)
+    return table;
+
+  if (needed > INT_MAX)
+    longjmp(ctx->env, 1);
+
+  new_size = (*size > 0) ? (size_t) *size : 16;
+  while (new_size < needed)
+    new_size *= 2;
+  if (new_size > INT_MAX)
+    new_size = INT_MAX;
+
+  if ((new_size > ((size_t) -1) / elsize) ||
+      ((new_table = realloc(table, new_size * elsize)) == NULL))
+    longjmp(ctx->env, 1);
+
+  *size = (int) new_size;
+  return new_table;
+}
+
+
+/* splitmix64: a fast generator with 64 bits of state, which works */
+/* well for any seed */
+static unsigned long long next_random(state)
+     unsigned long long *state;
+{
+  unsigned long long z = (*state += 0x9E3779B97F4A7C15ULL);
+
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
 
 
 /* Generate a random permutation of the segments 1..n */
-int generate_random_ordering(n)
+int generate_random_ordering(ctx, n)
+     seidel_context_t *ctx;
      int n;
 {
   struct timeval tval;
   struct timezone tzone;
   register int i;
-  int m, st[SEGSIZE], *p;
+  int m, tmp, *p;
   
-  choose_idx = 1;
-  gettimeofday(&tval, &tzone);
-  srand48(tval.tv_sec);
+  ctx->choose_idx = 1;
+  if (!ctx->seed_is_set)
+    {
+      gettimeofday(&tval, &tzone);
+      ctx->seed = (unsigned long long) tval.tv_sec * 1000000 + tval.tv_usec;
+    }
+  ctx->rand_state = ctx->seed;
 
+  /* Shuffle in place: the segments not chosen yet are the ones */
+  /* after position i - 1 */
   for (i = 0; i <= n; i++)
-    st[i] = i;
+    ctx->permute[i] = i;
 
-  p = st;
+  p = ctx->permute;
   for (i = 1; i <= n; i++, p++)
     {
-      m = lrand48() % (n + 1 - i) + 1;
-      permute[i] = p[m];
-      if (m != 1)
-	p[m] = p[1];
+      /* Scale the top 32 bits to 1..n + 1 - i, without a division */
+      m = (int) (((next_random(&ctx->rand_state) >> 32) *
+		  (unsigned long long) (n + 1 - i)) >> 32) + 1;
+      tmp = p[m];
+      p[m] = p[1];
+      p[1] = tmp;
     }
   return 0;
 }
@@ -42,21 +99,23 @@ int generate_random_ordering(n)
   
 /* Return the next segment in the generated random ordering of all the */
 /* segments in S */
-int choose_segment()
+int choose_segment(ctx)
+     seidel_context_t *ctx;
 {
   int i;
 
 #ifdef DEBUG
-  fprintf(stderr, "choose_segment: %d\n", permute[choose_idx]);
+  fprintf(stderr, "choose_segment: %d\n", ctx->permute[ctx->choose_idx]);
 #endif 
-  return permute[choose_idx++];
+  return ctx->permute[ctx->choose_idx++];
 }
 
 
 #ifdef STANDALONE
 
 /* Read in the list of vertices from infile */
-int read_segments(filename, genus)
+int read_segments(ctx, filename, genus)
+     seidel_context_t *ctx;
      char *filename;
      int *genus;
 {
@@ -80,6 +139,11 @@ int read_segments(filename, genus)
   /* anti-clockwise order). Next, the inner contours are input in */
   /* clockwise order */
 
+  /* Segment 0 is unused, but cleared as load_contours() does */
+  ctx->seg = (segment_t *) grow_table(ctx, ctx->seg, &ctx->seg_size,
+				      (size_t) 1, sizeof(segment_t));
+  memset((void *)&ctx->seg[0], 0, sizeof(segment_t));
+
   ccount = 0;
   i = 1;
   
@@ -88,31 +152,41 @@ int read_segments(filename, genus)
       int j;
 
       fscanf(infile, "%d", &npoints);
+      if (npoints <= 0)
+	return -1;
+
+      /* The first point of a contour sets seg[last].v1, so the */
+      /* whole contour has to be there and cleared before the loop */
       first = i;
       last = first + npoints - 1;
+      ctx->seg = (segment_t *) grow_table(ctx, ctx->seg, &ctx->seg_size,
+					  (size_t) last + 1,
+					  sizeof(segment_t));
+      memset((void *)&ctx->seg[first], 0, npoints * sizeof(segment_t));
+
       for (j = 0; j < npoints; j++, i++)
 	{
-	  fscanf(infile, "%lf%lf", &seg[i].v0.x, &seg[i].v0.y);
+	  fscanf(infile, "%lf%lf", &ctx->seg[i].v0.x, &ctx->seg[i].v0.y);
 	  if (i == last)
 	    {
-	      seg[i].next = first;
-	      seg[i].prev = i-1;
-	      seg[i-1].v1 = seg[i].v0;
+	      ctx->seg[i].next = first;
+	      ctx->seg[i].prev = i-1;
+	      ctx->seg[i-1].v1 = ctx->seg[i].v0;
 	    }
 	  else if (i == first)
 	    {
-	      seg[i].next = i+1;
-	      seg[i].prev = last;
-	      seg[last].v1 = seg[i].v0;
+	      ctx->seg[i].next = i+1;
+	      ctx->seg[i].prev = last;
+	      ctx->seg[last].v1 = ctx->seg[i].v0;
 	    }
 	  else
 	    {
-	      seg[i].prev = i-1;
-	      seg[i].next = i+1;
-	      seg[i-1].v1 = seg[i].v0;
+	      ctx->seg[i].prev = i-1;
+	      ctx->seg[i].next = i+1;
+	      ctx->seg[i-1].v1 = ctx->seg[i].v0;
 	    }
 	  
-	  seg[i].is_inserted = FALSE;
+	  ctx->seg[i].is_inserted = FALSE;
 	}
 
       ccount++;
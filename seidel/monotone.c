@@ -3,30 +3,15 @@
 #include <string.h>
 
 #define CROSS_SINE(v0, v1) ((v0).x * (v1).y - (v1).x * (v0).y)
-#define LENGTH(v0) (sqrt((v0).x * (v0).x + (v0).y * (v0).y))
 
-static monchain_t mchain[TRSIZE]; /* Table to hold all the monotone */
-				  /* polygons . Each monotone polygon */
-				  /* is a circularly linked list */
-
-static vertexchain_t vert[SEGSIZE]; /* chain init. information. This */
-				    /* is used to decide which */
-				    /* monotone polygon to split if */
-				    /* there are several other */
-				    /* polygons touching at the same */
-				    /* vertex  */
-
-static int mon[SEGSIZE];	/* contains position of any vertex in */
-				/* the monotone chain for the polygon */
-static int visited[TRSIZE];
-static int chain_idx, op_idx, mon_idx;
-
-
-static int triangulate_single_polygon(int, int, int, int (*)[3]);
-static int traverse_polygon(int, int, int, int);
+static int triangulate_single_polygon(seidel_context_t *, int, int, int, int (*)[3]);
+static int traverse_polygon(seidel_context_t *, int, int, int, int);
+static int visit_trapezoid(seidel_context_t *, int, int, int, int);
+static void follow(seidel_context_t *, int, int, int, int);
 
 /* Function returns TRUE if the trapezoid lies inside the polygon */
-static int inside_polygon(t)
+static int inside_polygon(ctx, t)
+     seidel_context_t *ctx;
      trap_t *t;
 {
   int rseg = t->rseg;
@@ -39,97 +24,120 @@ static int inside_polygon(t)
   
   if (((t->u0 <= 0) && (t->u1 <= 0)) || 
       ((t->d0 <= 0) && (t->d1 <= 0))) /* triangle */
-    return (_greater_than(&seg[rseg].v1, &seg[rseg].v0));
+    return (_greater_than(&ctx->seg[rseg].v1, &ctx->seg[rseg].v0));
   
   return 0;
 }
 
 
 /* return a new mon structure from the table */
-static int newmon()
+static int newmon(ctx)
+     seidel_context_t *ctx;
 {
-  return ++mon_idx;
+  if (ctx->mon_idx + 1 >= ctx->mon_size)
+    ctx->mon = (int *) grow_table(ctx, ctx->mon, &ctx->mon_size,
+				  (size_t) ctx->mon_idx + 2, sizeof(int));
+
+  return ++ctx->mon_idx;
 }
 
 
 /* return a new chain element from the table */
-static int new_chain_element()
+static int new_chain_element(ctx)
+     seidel_context_t *ctx;
 {
-  return ++chain_idx;
+  if (ctx->chain_idx + 1 >= ctx->mchain_size)
+    ctx->mchain = (monchain_t *) grow_table(ctx, ctx->mchain,
+					    &ctx->mchain_size,
+					    (size_t) ctx->chain_idx + 2,
+					    sizeof(monchain_t));
+
+  ++ctx->chain_idx;
+  memset((void *)&ctx->mchain[ctx->chain_idx], 0, sizeof(monchain_t));
+  return ctx->chain_idx;
 }
 
 
-static double get_angle(vp0, vpnext, vp1)
-     point_t *vp0;
-     point_t *vpnext;
-     point_t *vp1;
+/* Returns TRUE if the direction d is reached by a smaller */
+/* anti-clockwise turn from the direction a than from the direction */
+/* b. beyond_a and beyond_b tell whether the turns from a and b take */
+/* more than half a turn (CROSS_SINE(a, d) < 0). Turns on the same */
+/* side of half a turn differ by less than half a turn, so the sign */
+/* of one cross product orders them, without any angles. */
+static int smaller_turn(a, beyond_a, b, beyond_b, d)
+     point_t *a;
+     int beyond_a;
+     point_t *b;
+     int beyond_b;
+     point_t *d;
 {
-  point_t v0, v1;
-  
-  v0.x = vpnext->x - vp0->x;
-  v0.y = vpnext->y - vp0->y;
+  double cross;
+
+  if (beyond_a != beyond_b)
+    return beyond_b;
 
-  v1.x = vp1->x - vp0->x;
-  v1.y = vp1->y - vp0->y;
+  cross = CROSS_SINE(*b, *a);
+  if (cross != 0)
+    return (cross > 0);
 
-  if (CROSS_SINE(v0, v1) >= 0)	/* sine is positive */
-    return DOT(v0, v1)/LENGTH(v0)/LENGTH(v1);
-  else
-    return (-1.0 * DOT(v0, v1)/LENGTH(v0)/LENGTH(v1) - 2);
+  /* a and b are parallel. Only when they point in opposite */
+  /* directions, one of them along d, do their turns differ. */
+  return (DOT(*a, *b) < 0) && (DOT(*a, *d) > 0);
 }
 
 
-/* (v0, v1) is the new diagonal to be added to the polygon. Find which */
-/* chain to use and return the positions of v0 and v1 in p and q */ 
-static int get_vertex_positions(v0, v1, ip, iq)
-     int v0;
-     int v1;
-     int *ip;
-     int *iq;
+/* Returns the chain of vertex v whose next edge is reached by the */
+/* smallest clockwise turn from the new diagonal (v, w), which is */
+/* the chain the diagonal splits */
+static int chain_for_diagonal(ctx, v, w)
+     seidel_context_t *ctx;
+     int v;
+     int w;
 {
-  vertexchain_t *vp0, *vp1;
+  vertexchain_t *vp = &ctx->vert[v];
+  point_t d, e, best;
   register int i;
-  double angle, temp;
-  int tp, tq;
+  int beyond, best_beyond, ip = -1;
+
+  d.x = ctx->vert[w].pt.x - vp->pt.x;
+  d.y = ctx->vert[w].pt.y - vp->pt.y;
 
-  vp0 = &vert[v0];
-  vp1 = &vert[v1];
-  
-  /* p is identified as follows. Scan from (v0, v1) rightwards till */
-  /* you hit the first segment starting from v0. That chain is the */
-  /* chain of our interest */
-  
-  angle = -4.0;
   for (i = 0; i < 4; i++)
     {
-      if (vp0->vnext[i] <= 0)
+      if (vp->vnext[i] <= 0)
 	continue;
-      if ((temp = get_angle(&vp0->pt, &(vert[vp0->vnext[i]].pt), 
-			    &vp1->pt)) > angle)
+
+      e.x = ctx->vert[vp->vnext[i]].pt.x - vp->pt.x;
+      e.y = ctx->vert[vp->vnext[i]].pt.y - vp->pt.y;
+      beyond = (CROSS_SINE(e, d) < 0);
+      if ((ip < 0) || smaller_turn(&e, beyond, &best, best_beyond, &d))
 	{
-	  angle = temp;
-	  tp = i;
+	  ip = i;
+	  best = e;
+	  best_beyond = beyond;
 	}
     }
 
-  *ip = tp;
+  return ip;
+}
 
-  /* Do similar actions for q */
 
-  angle = -4.0;
-  for (i = 0; i < 4; i++)
-    {
-      if (vp1->vnext[i] <= 0)
-	continue;      
-      if ((temp = get_angle(&vp1->pt, &(vert[vp1->vnext[i]].pt), 
-			    &vp0->pt)) > angle)
-	{
-	  angle = temp;
-	  tq = i;
-	}
-    }
+/* (v0, v1) is the new diagonal to be added to the polygon. Find which */
+/* chain to use and return the positions of v0 and v1 in p and q */ 
+static int get_vertex_positions(ctx, v0, v1, ip, iq)
+     seidel_context_t *ctx;
+     int v0;
+     int v1;
+     int *ip;
+     int *iq;
+{
+  /* p is identified as follows. Scan from (v0, v1) rightwards till */
+  /* you hit the first segment starting from v0. That chain is the */
+  /* chain of our interest */
+  *ip = chain_for_diagonal(ctx, v0, v1);
 
-  *iq = tq;
+  /* Do similar actions for q */
+  *iq = chain_for_diagonal(ctx, v1, v0);
 
   return 0;
 }
@@ -139,20 +147,21 @@ static int get_vertex_positions(v0, v1, ip, iq)
  * the current monotone polygon mcur. Split the current polygon into 
  * two polygons using the diagonal (v0, v1) 
  */
-static int make_new_monotone_poly(mcur, v0, v1)
+static int make_new_monotone_poly(ctx, mcur, v0, v1)
+     seidel_context_t *ctx;
      int mcur;
      int v0;
      int v1;
 {
   int p, q, ip, iq;
-  int mnew = newmon();
+  int mnew = newmon(ctx);
   int i, j, nf0, nf1;
   vertexchain_t *vp0, *vp1;
   
-  vp0 = &vert[v0];
-  vp1 = &vert[v1];
+  vp0 = &ctx->vert[v0];
+  vp1 = &ctx->vert[v1];
 
-  get_vertex_positions(v0, v1, &ip, &iq);
+  get_vertex_positions(ctx, v0, v1, &ip, &iq);
 
   p = vp0->vpos[ip];
   q = vp1->vpos[iq];
@@ -160,21 +169,21 @@ static int make_new_monotone_poly(mcur, v0, v1)
   /* At this stage, we have got the positions of v0 and v1 in the */
   /* desired chain. Now modify the linked lists */
 
-  i = new_chain_element();	/* for the new list */
-  j = new_chain_element();
+  i = new_chain_element(ctx);	/* for the new list */
+  j = new_chain_element(ctx);
 
-  mchain[i].vnum = v0;
-  mchain[j].vnum = v1;
+  ctx->mchain[i].vnum = v0;
+  ctx->mchain[j].vnum = v1;
 
-  mchain[i].next = mchain[p].next;
-  mchain[mchain[p].next].prev = i;
-  mchain[i].prev = j;
-  mchain[j].next = i;
-  mchain[j].prev = mchain[q].prev;
-  mchain[mchain[q].prev].next = j;
+  ctx->mchain[i].next = ctx->mchain[p].next;
+  ctx->mchain[ctx->mchain[p].next].prev = i;
+  ctx->mchain[i].prev = j;
+  ctx->mchain[j].next = i;
+  ctx->mchain[j].prev = ctx->mchain[q].prev;
+  ctx->mchain[ctx->mchain[q].prev].next = j;
 
-  mchain[p].next = q;
-  mchain[q].prev = p;
+  ctx->mchain[p].next = q;
+  ctx->mchain[q].prev = p;
 
   nf0 = vp0->nextfree;
   nf1 = vp1->nextfree;
@@ -182,7 +191,7 @@ static int make_new_monotone_poly(mcur, v0, v1)
   vp0->vnext[ip] = v1;
 
   vp0->vpos[nf0] = i;
-  vp0->vnext[nf0] = mchain[mchain[i].next].vnum;
+  vp0->vnext[nf0] = ctx->mchain[ctx->mchain[i].next].vnum;
   vp1->vpos[nf1] = j;
   vp1->vnext[nf1] = v0;
 
@@ -195,8 +204,8 @@ static int make_new_monotone_poly(mcur, v0, v1)
   fprintf(stderr, "next posns = (p, q) = (%d, %d)\n", p, q);
 #endif
 
-  mon[mcur] = p;
-  mon[mnew] = i;
+  ctx->mon[mcur] = p;
+  ctx->mon[mnew] = i;
   return mnew;
 }
 
@@ -204,21 +213,27 @@ static int make_new_monotone_poly(mcur, v0, v1)
  * the polygon.
  */
 
-int monotonate_trapezoids(n)
+int monotonate_trapezoids(ctx, n)
+     seidel_context_t *ctx;
      int n;
 {
   register int i;
   int tr_start;
 
-  memset((void *)vert, 0, sizeof(vert));
-  memset((void *)visited, 0, sizeof(visited));
-  memset((void *)mchain, 0, sizeof(mchain));
-  memset((void *)mon, 0, sizeof(mon));
+  /* Clear only the entries for the n vertices and the trapezoids */
+  /* in use. Chain elements beyond n are cleared by */
+  /* new_chain_element(), and every entry of mon is set before it */
+  /* is read. */
+  ctx->visited = (int *) grow_table(ctx, ctx->visited, &ctx->visited_size,
+				    (size_t) ctx->tr_idx, sizeof(int));
+  memset((void *)ctx->vert, 0, (n + 1) * sizeof(vertexchain_t));
+  memset((void *)ctx->visited, 0, ctx->tr_idx * sizeof(int));
+  memset((void *)ctx->mchain, 0, (n + 1) * sizeof(monchain_t));
   
   /* First locate a trapezoid which lies inside the polygon */
   /* and which is triangular */
-  for (i = 0; i < TRSIZE; i++)
-    if (inside_polygon(&tr[i]))
+  for (i = 0; i < ctx->tr_idx; i++)
+    if (inside_polygon(ctx, &ctx->tr[i]))
       break;
   tr_start = i;
   
@@ -228,71 +243,73 @@ int monotonate_trapezoids(n)
 #if 0
   for (i = 1; i <= n; i++)
     {
-      mchain[i].prev = i - 1;
-      mchain[i].next = i + 1;
-      mchain[i].vnum = i;
-      vert[i].pt = seg[i].v0;
-      vert[i].vnext[0] = i + 1;	/* next vertex */
-      vert[i].vpos[0] = i;	/* locn. of next vertex */
-      vert[i].nextfree = 1;
+      ctx->mchain[i].prev = i - 1;
+      ctx->mchain[i].next = i + 1;
+      ctx->mchain[i].vnum = i;
+      ctx->vert[i].pt = ctx->seg[i].v0;
+      ctx->vert[i].vnext[0] = i + 1;	/* next vertex */
+      ctx->vert[i].vpos[0] = i;	/* locn. of next vertex */
+      ctx->vert[i].nextfree = 1;
     }
-  mchain[1].prev = n;
-  mchain[n].next = 1;
-  vert[n].vnext[0] = 1;
-  vert[n].vpos[0] = n;
-  chain_idx = n;
-  mon_idx = 0;
-  mon[0] = 1;			/* position of any vertex in the first */
+  ctx->mchain[1].prev = n;
+  ctx->mchain[n].next = 1;
+  ctx->vert[n].vnext[0] = 1;
+  ctx->vert[n].vpos[0] = n;
+  ctx->chain_idx = n;
+  ctx->mon_idx = 0;
+  ctx->mon[0] = 1;			/* position of any vertex in the first */
 				/* chain  */
 
 #else
 
   for (i = 1; i <= n; i++)
     {
-      mchain[i].prev = seg[i].prev;
-      mchain[i].next = seg[i].next;
-      mchain[i].vnum = i;
-      vert[i].pt = seg[i].v0;
-      vert[i].vnext[0] = seg[i].next; /* next vertex */
-      vert[i].vpos[0] = i;	/* locn. of next vertex */
-      vert[i].nextfree = 1;
+      ctx->mchain[i].prev = ctx->seg[i].prev;
+      ctx->mchain[i].next = ctx->seg[i].next;
+      ctx->mchain[i].vnum = i;
+      ctx->vert[i].pt = ctx->seg[i].v0;
+      ctx->vert[i].vnext[0] = ctx->seg[i].next; /* next vertex */
+      ctx->vert[i].vpos[0] = i;	/* locn. of next vertex */
+      ctx->vert[i].nextfree = 1;
     }
 
-  chain_idx = n;
-  mon_idx = 0;
-  mon[0] = 1;			/* position of any vertex in the first */
+  ctx->chain_idx = n;
+  ctx->mon_idx = 0;
+  ctx->mon[0] = 1;			/* position of any vertex in the first */
 				/* chain  */
 
 #endif
   
   /* traverse the polygon */
-  if (tr[tr_start].u0 > 0)
-    traverse_polygon(0, tr_start, tr[tr_start].u0, TR_FROM_UP);
-  else if (tr[tr_start].d0 > 0)
-    traverse_polygon(0, tr_start, tr[tr_start].d0, TR_FROM_DN);
+  if (ctx->tr[tr_start].u0 > 0)
+    traverse_polygon(ctx, 0, tr_start, ctx->tr[tr_start].u0, TR_FROM_UP);
+  else if (ctx->tr[tr_start].d0 > 0)
+    traverse_polygon(ctx, 0, tr_start, ctx->tr[tr_start].d0, TR_FROM_DN);
   
   /* return the number of polygons created */
-  return newmon();
+  return newmon(ctx);
 }
 
 
-/* recursively visit all the trapezoids */
-static int traverse_polygon(mcur, trnum, from, dir)
+/* Visit trapezoid trnum, entered from trapezoid from, as a part */
+/* of monotone polygon mcur, and queue visits of its neighbours */
+static int visit_trapezoid(ctx, mcur, trnum, from, dir)
+     seidel_context_t *ctx;
      int mcur;
      int trnum;
      int from;
      int dir;
 {
-  trap_t *t = &tr[trnum];
+  trap_t *t = &ctx->tr[trnum];
   int howsplit, mnew;
   int v0, v1, v0next, v1next;
   int retval, tmp;
   int do_switch = FALSE;
 
-  if ((trnum <= 0) || visited[trnum])
+  if ((trnum <= 0) || ctx->visited[trnum])
     return 0;
 
-  visited[trnum] = TRUE;
+  ctx->visited[trnum] = TRUE;
   
   /* We have much more information available here. */
   /* rseg: goes upwards   */
@@ -308,29 +325,29 @@ static int traverse_polygon(mcur, trnum, from, dir)
     {
       if ((t->d0 > 0) && (t->d1 > 0)) /* downward opening triangle */
 	{
-	  v0 = tr[t->d1].lseg;
+	  v0 = ctx->tr[t->d1].lseg;
 	  v1 = t->lseg;
 	  if (from == t->d1)
 	    {
 	      do_switch = TRUE;
-	      mnew = make_new_monotone_poly(mcur, v1, v0);
-	      traverse_polygon(mcur, t->d1, trnum, TR_FROM_UP);
-	      traverse_polygon(mnew, t->d0, trnum, TR_FROM_UP);	    
+	      mnew = make_new_monotone_poly(ctx, mcur, v1, v0);
+	      follow(ctx, mcur, t->d1, trnum, TR_FROM_UP);
+	      follow(ctx, mnew, t->d0, trnum, TR_FROM_UP);	    
 	    }
 	  else
 	    {
-	      mnew = make_new_monotone_poly(mcur, v0, v1);
-	      traverse_polygon(mcur, t->d0, trnum, TR_FROM_UP);
-	      traverse_polygon(mnew, t->d1, trnum, TR_FROM_UP);
+	      mnew = make_new_monotone_poly(ctx, mcur, v0, v1);
+	      follow(ctx, mcur, t->d0, trnum, TR_FROM_UP);
+	      follow(ctx, mnew, t->d1, trnum, TR_FROM_UP);
 	    }
 	}
       else
 	{
 	  retval = SP_NOSPLIT;	/* Just traverse all neighbours */
-	  traverse_polygon(mcur, t->u0, trnum, TR_FROM_DN);
-	  traverse_polygon(mcur, t->u1, trnum, TR_FROM_DN);
-	  traverse_polygon(mcur, t->d0, trnum, TR_FROM_UP);
-	  traverse_polygon(mcur, t->d1, trnum, TR_FROM_UP);
+	  follow(ctx, mcur, t->u0, trnum, TR_FROM_DN);
+	  follow(ctx, mcur, t->u1, trnum, TR_FROM_DN);
+	  follow(ctx, mcur, t->d0, trnum, TR_FROM_UP);
+	  follow(ctx, mcur, t->d1, trnum, TR_FROM_UP);
 	}
     }
   
@@ -339,28 +356,28 @@ static int traverse_polygon(mcur, trnum, from, dir)
       if ((t->u0 > 0) && (t->u1 > 0)) /* upward opening triangle */
 	{
 	  v0 = t->rseg;
-	  v1 = tr[t->u0].rseg;
+	  v1 = ctx->tr[t->u0].rseg;
 	  if (from == t->u1)
 	    {
 	      do_switch = TRUE;
-	      mnew = make_new_monotone_poly(mcur, v1, v0);
-	      traverse_polygon(mcur, t->u1, trnum, TR_FROM_DN);
-	      traverse_polygon(mnew, t->u0, trnum, TR_FROM_DN);	    
+	      mnew = make_new_monotone_poly(ctx, mcur, v1, v0);
+	      follow(ctx, mcur, t->u1, trnum, TR_FROM_DN);
+	      follow(ctx, mnew, t->u0, trnum, TR_FROM_DN);	    
 	    }
 	  else
 	    {
-	      mnew = make_new_monotone_poly(mcur, v0, v1);
-	      traverse_polygon(mcur, t->u0, trnum, TR_FROM_DN);
-	      traverse_polygon(mnew, t->u1, trnum, TR_FROM_DN);
+	      mnew = make_new_monotone_poly(ctx, mcur, v0, v1);
+	      follow(ctx, mcur, t->u0, trnum, TR_FROM_DN);
+	      follow(ctx, mnew, t->u1, trnum, TR_FROM_DN);
 	    }
 	}
       else
 	{
 	  retval = SP_NOSPLIT;	/* Just traverse all neighbours */
-	  traverse_polygon(mcur, t->u0, trnum, TR_FROM_DN);
-	  traverse_polygon(mcur, t->u1, trnum, TR_FROM_DN);
-	  traverse_polygon(mcur, t->d0, trnum, TR_FROM_UP);
-	  traverse_polygon(mcur, t->d1, trnum, TR_FROM_UP);
+	  follow(ctx, mcur, t->u0, trnum, TR_FROM_DN);
+	  follow(ctx, mcur, t->u1, trnum, TR_FROM_DN);
+	  follow(ctx, mcur, t->d0, trnum, TR_FROM_UP);
+	  follow(ctx, mcur, t->d1, trnum, TR_FROM_UP);
 	}
     }
   
@@ -368,75 +385,75 @@ static int traverse_polygon(mcur, trnum, from, dir)
     {
       if ((t->d0 > 0) && (t->d1 > 0)) /* downward + upward cusps */
 	{
-	  v0 = tr[t->d1].lseg;
-	  v1 = tr[t->u0].rseg;
+	  v0 = ctx->tr[t->d1].lseg;
+	  v1 = ctx->tr[t->u0].rseg;
 	  retval = SP_2UP_2DN;
 	  if (((dir == TR_FROM_DN) && (t->d1 == from)) ||
 	      ((dir == TR_FROM_UP) && (t->u1 == from)))
 	    {
 	      do_switch = TRUE;
-	      mnew = make_new_monotone_poly(mcur, v1, v0);
-	      traverse_polygon(mcur, t->u1, trnum, TR_FROM_DN);
-	      traverse_polygon(mcur, t->d1, trnum, TR_FROM_UP);
-	      traverse_polygon(mnew, t->u0, trnum, TR_FROM_DN);
-	      traverse_polygon(mnew, t->d0, trnum, TR_FROM_UP);
+	      mnew = make_new_monotone_poly(ctx, mcur, v1, v0);
+	      follow(ctx, mcur, t->u1, trnum, TR_FROM_DN);
+	      follow(ctx, mcur, t->d1, trnum, TR_FROM_UP);
+	      follow(ctx, mnew, t->u0, trnum, TR_FROM_DN);
+	      follow(ctx, mnew, t->d0, trnum, TR_FROM_UP);
 	    }
 	  else
 	    {
-	      mnew = make_new_monotone_poly(mcur, v0, v1);
-	      traverse_polygon(mcur, t->u0, trnum, TR_FROM_DN);
-	      traverse_polygon(mcur, t->d0, trnum, TR_FROM_UP);
-	      traverse_polygon(mnew, t->u1, trnum, TR_FROM_DN);
-	      traverse_polygon(mnew, t->d1, trnum, TR_FROM_UP);	      
+	      mnew = make_new_monotone_poly(ctx, mcur, v0, v1);
+	      follow(ctx, mcur, t->u0, trnum, TR_FROM_DN);
+	      follow(ctx, mcur, t->d0, trnum, TR_FROM_UP);
+	      follow(ctx, mnew, t->u1, trnum, TR_FROM_DN);
+	      follow(ctx, mnew, t->d1, trnum, TR_FROM_UP);	      
 	    }
 	}
       else			/* only downward cusp */
 	{
-	  if (_equal_to(&t->lo, &seg[t->lseg].v1))
+	  if (_equal_to(&t->lo, &ctx->seg[t->lseg].v1))
 	    {
-	      v0 = tr[t->u0].rseg;
-	      v1 = seg[t->lseg].next;
+	      v0 = ctx->tr[t->u0].rseg;
+	      v1 = ctx->seg[t->lseg].next;
 
 	      retval = SP_2UP_LEFT;
 	      if ((dir == TR_FROM_UP) && (t->u0 == from))
 		{
 		  do_switch = TRUE;
-		  mnew = make_new_monotone_poly(mcur, v1, v0);
-		  traverse_polygon(mcur, t->u0, trnum, TR_FROM_DN);
-		  traverse_polygon(mnew, t->d0, trnum, TR_FROM_UP);
-		  traverse_polygon(mnew, t->u1, trnum, TR_FROM_DN);
-		  traverse_polygon(mnew, t->d1, trnum, TR_FROM_UP);
+		  mnew = make_new_monotone_poly(ctx, mcur, v1, v0);
+		  follow(ctx, mcur, t->u0, trnum, TR_FROM_DN);
+		  follow(ctx, mnew, t->d0, trnum, TR_FROM_UP);
+		  follow(ctx, mnew, t->u1, trnum, TR_FROM_DN);
+		  follow(ctx, mnew, t->d1, trnum, TR_FROM_UP);
 		}
 	      else
 		{
-		  mnew = make_new_monotone_poly(mcur, v0, v1);
-		  traverse_polygon(mcur, t->u1, trnum, TR_FROM_DN);
-		  traverse_polygon(mcur, t->d0, trnum, TR_FROM_UP);
-		  traverse_polygon(mcur, t->d1, trnum, TR_FROM_UP);
-		  traverse_polygon(mnew, t->u0, trnum, TR_FROM_DN);
+		  mnew = make_new_monotone_poly(ctx, mcur, v0, v1);
+		  follow(ctx, mcur, t->u1, trnum, TR_FROM_DN);
+		  follow(ctx, mcur, t->d0, trnum, TR_FROM_UP);
+		  follow(ctx, mcur, t->d1, trnum, TR_FROM_UP);
+		  follow(ctx, mnew, t->u0, trnum, TR_FROM_DN);
 		}
 	    }
 	  else
 	    {
 	      v0 = t->rseg;
-	      v1 = tr[t->u0].rseg;	
+	      v1 = ctx->tr[t->u0].rseg;	
 	      retval = SP_2UP_RIGHT;
 	      if ((dir == TR_FROM_UP) && (t->u1 == from))
 		{
 		  do_switch = TRUE;
-		  mnew = make_new_monotone_poly(mcur, v1, v0);
-		  traverse_polygon(mcur, t->u1, trnum, TR_FROM_DN);
-		  traverse_polygon(mnew, t->d1, trnum, TR_FROM_UP);
-		  traverse_polygon(mnew, t->d0, trnum, TR_FROM_UP);
-		  traverse_polygon(mnew, t->u0, trnum, TR_FROM_DN);
+		  mnew = make_new_monotone_poly(ctx, mcur, v1, v0);
+		  follow(ctx, mcur, t->u1, trnum, TR_FROM_DN);
+		  follow(ctx, mnew, t->d1, trnum, TR_FROM_UP);
+		  follow(ctx, mnew, t->d0, trnum, TR_FROM_UP);
+		  follow(ctx, mnew, t->u0, trnum, TR_FROM_DN);
 		}
 	      else
 		{
-		  mnew = make_new_monotone_poly(mcur, v0, v1);
-		  traverse_polygon(mcur, t->u0, trnum, TR_FROM_DN);
-		  traverse_polygon(mcur, t->d0, trnum, TR_FROM_UP);
-		  traverse_polygon(mcur, t->d1, trnum, TR_FROM_UP);
-		  traverse_polygon(mnew, t->u1, trnum, TR_FROM_DN);
+		  mnew = make_new_monotone_poly(ctx, mcur, v0, v1);
+		  follow(ctx, mcur, t->u0, trnum, TR_FROM_DN);
+		  follow(ctx, mcur, t->d0, trnum, TR_FROM_UP);
+		  follow(ctx, mcur, t->d1, trnum, TR_FROM_UP);
+		  follow(ctx, mnew, t->u1, trnum, TR_FROM_DN);
 		}
 	    }
 	}
@@ -445,58 +462,58 @@ static int traverse_polygon(mcur, trnum, from, dir)
     {
       if ((t->d0 > 0) && (t->d1 > 0)) /* only upward cusp */
 	{
-	  if (_equal_to(&t->hi, &seg[t->lseg].v0))
+	  if (_equal_to(&t->hi, &ctx->seg[t->lseg].v0))
 	    {
-	      v0 = tr[t->d1].lseg;
+	      v0 = ctx->tr[t->d1].lseg;
 	      v1 = t->lseg;
 	      retval = SP_2DN_LEFT;
 	      if (!((dir == TR_FROM_DN) && (t->d0 == from)))
 		{
 		  do_switch = TRUE;
-		  mnew = make_new_monotone_poly(mcur, v1, v0);
-		  traverse_polygon(mcur, t->u1, trnum, TR_FROM_DN);
-		  traverse_polygon(mcur, t->d1, trnum, TR_FROM_UP);
-		  traverse_polygon(mcur, t->u0, trnum, TR_FROM_DN);
-		  traverse_polygon(mnew, t->d0, trnum, TR_FROM_UP);
+		  mnew = make_new_monotone_poly(ctx, mcur, v1, v0);
+		  follow(ctx, mcur, t->u1, trnum, TR_FROM_DN);
+		  follow(ctx, mcur, t->d1, trnum, TR_FROM_UP);
+		  follow(ctx, mcur, t->u0, trnum, TR_FROM_DN);
+		  follow(ctx, mnew, t->d0, trnum, TR_FROM_UP);
 		}
 	      else
 		{
-		  mnew = make_new_monotone_poly(mcur, v0, v1);
-		  traverse_polygon(mcur, t->d0, trnum, TR_FROM_UP);
-		  traverse_polygon(mnew, t->u0, trnum, TR_FROM_DN);
-		  traverse_polygon(mnew, t->u1, trnum, TR_FROM_DN);
-		  traverse_polygon(mnew, t->d1, trnum, TR_FROM_UP);	      
+		  mnew = make_new_monotone_poly(ctx, mcur, v0, v1);
+		  follow(ctx, mcur, t->d0, trnum, TR_FROM_UP);
+		  follow(ctx, mnew, t->u0, trnum, TR_FROM_DN);
+		  follow(ctx, mnew, t->u1, trnum, TR_FROM_DN);
+		  follow(ctx, mnew, t->d1, trnum, TR_FROM_UP);	      
 		}
 	    }
 	  else
 	    {
-	      v0 = tr[t->d1].lseg;
-	      v1 = seg[t->rseg].next;
+	      v0 = ctx->tr[t->d1].lseg;
+	      v1 = ctx->seg[t->rseg].next;
 
 	      retval = SP_2DN_RIGHT;	    
 	      if ((dir == TR_FROM_DN) && (t->d1 == from))
 		{
 		  do_switch = TRUE;
-		  mnew = make_new_monotone_poly(mcur, v1, v0);
-		  traverse_polygon(mcur, t->d1, trnum, TR_FROM_UP);
-		  traverse_polygon(mnew, t->u1, trnum, TR_FROM_DN);
-		  traverse_polygon(mnew, t->u0, trnum, TR_FROM_DN);
-		  traverse_polygon(mnew, t->d0, trnum, TR_FROM_UP);
+		  mnew = make_new_monotone_poly(ctx, mcur, v1, v0);
+		  follow(ctx, mcur, t->d1, trnum, TR_FROM_UP);
+		  follow(ctx, mnew, t->u1, trnum, TR_FROM_DN);
+		  follow(ctx, mnew, t->u0, trnum, TR_FROM_DN);
+		  follow(ctx, mnew, t->d0, trnum, TR_FROM_UP);
 		}
 	      else
 		{
-		  mnew = make_new_monotone_poly(mcur, v0, v1);
-		  traverse_polygon(mcur, t->u0, trnum, TR_FROM_DN);
-		  traverse_polygon(mcur, t->d0, trnum, TR_FROM_UP);
-		  traverse_polygon(mcur, t->u1, trnum, TR_FROM_DN);
-		  traverse_polygon(mnew, t->d1, trnum, TR_FROM_UP);
+		  mnew = make_new_monotone_poly(ctx, mcur, v0, v1);
+		  follow(ctx, mcur, t->u0, trnum, TR_FROM_DN);
+		  follow(ctx, mcur, t->d0, trnum, TR_FROM_UP);
+		  follow(ctx, mcur, t->u1, trnum, TR_FROM_DN);
+		  follow(ctx, mnew, t->d1, trnum, TR_FROM_UP);
 		}
 	    }
 	}
       else			/* no cusp */
 	{
-	  if (_equal_to(&t->hi, &seg[t->lseg].v0) &&
-	      _equal_to(&t->lo, &seg[t->rseg].v0))
+	  if (_equal_to(&t->hi, &ctx->seg[t->lseg].v0) &&
+	      _equal_to(&t->lo, &ctx->seg[t->rseg].v0))
 	    {
 	      v0 = t->rseg;
 	      v1 = t->lseg;
@@ -504,53 +521,53 @@ static int traverse_polygon(mcur, trnum, from, dir)
 	      if (dir == TR_FROM_UP)
 		{
 		  do_switch = TRUE;
-		  mnew = make_new_monotone_poly(mcur, v1, v0);
-		  traverse_polygon(mcur, t->u0, trnum, TR_FROM_DN);
-		  traverse_polygon(mcur, t->u1, trnum, TR_FROM_DN);
-		  traverse_polygon(mnew, t->d1, trnum, TR_FROM_UP);
-		  traverse_polygon(mnew, t->d0, trnum, TR_FROM_UP);
+		  mnew = make_new_monotone_poly(ctx, mcur, v1, v0);
+		  follow(ctx, mcur, t->u0, trnum, TR_FROM_DN);
+		  follow(ctx, mcur, t->u1, trnum, TR_FROM_DN);
+		  follow(ctx, mnew, t->d1, trnum, TR_FROM_UP);
+		  follow(ctx, mnew, t->d0, trnum, TR_FROM_UP);
 		}
 	      else
 		{
-		  mnew = make_new_monotone_poly(mcur, v0, v1);
-		  traverse_polygon(mcur, t->d1, trnum, TR_FROM_UP);
-		  traverse_polygon(mcur, t->d0, trnum, TR_FROM_UP);
-		  traverse_polygon(mnew, t->u0, trnum, TR_FROM_DN);
-		  traverse_polygon(mnew, t->u1, trnum, TR_FROM_DN);
+		  mnew = make_new_monotone_poly(ctx, mcur, v0, v1);
+		  follow(ctx, mcur, t->d1, trnum, TR_FROM_UP);
+		  follow(ctx, mcur, t->d0, trnum, TR_FROM_UP);
+		  follow(ctx, mnew, t->u0, trnum, TR_FROM_DN);
+		  follow(ctx, mnew, t->u1, trnum, TR_FROM_DN);
 		}
 	    }
-	  else if (_equal_to(&t->hi, &seg[t->rseg].v1) &&
-		   _equal_to(&t->lo, &seg[t->lseg].v1))
+	  else if (_equal_to(&t->hi, &ctx->seg[t->rseg].v1) &&
+		   _equal_to(&t->lo, &ctx->seg[t->lseg].v1))
 	    {
-	      v0 = seg[t->rseg].next;
-	      v1 = seg[t->lseg].next;
+	      v0 = ctx->seg[t->rseg].next;
+	      v1 = ctx->seg[t->lseg].next;
 
 	      retval = SP_SIMPLE_LRUP;
 	      if (dir == TR_FROM_UP)
 		{
 		  do_switch = TRUE;
-		  mnew = make_new_monotone_poly(mcur, v1, v0);
-		  traverse_polygon(mcur, t->u0, trnum, TR_FROM_DN);
-		  traverse_polygon(mcur, t->u1, trnum, TR_FROM_DN);
-		  traverse_polygon(mnew, t->d1, trnum, TR_FROM_UP);
-		  traverse_polygon(mnew, t->d0, trnum, TR_FROM_UP);
+		  mnew = make_new_monotone_poly(ctx, mcur, v1, v0);
+		  follow(ctx, mcur, t->u0, trnum, TR_FROM_DN);
+		  follow(ctx, mcur, t->u1, trnum, TR_FROM_DN);
+		  follow(ctx, mnew, t->d1, trnum, TR_FROM_UP);
+		  follow(ctx, mnew, t->d0, trnum, TR_FROM_UP);
 		}
 	      else
 		{
-		  mnew = make_new_monotone_poly(mcur, v0, v1);
-		  traverse_polygon(mcur, t->d1, trnum, TR_FROM_UP);
-		  traverse_polygon(mcur, t->d0, trnum, TR_FROM_UP);
-		  traverse_polygon(mnew, t->u0, trnum, TR_FROM_DN);
-		  traverse_polygon(mnew, t->u1, trnum, TR_FROM_DN);
+		  mnew = make_new_monotone_poly(ctx, mcur, v0, v1);
+		  follow(ctx, mcur, t->d1, trnum, TR_FROM_UP);
+		  follow(ctx, mcur, t->d0, trnum, TR_FROM_UP);
+		  follow(ctx, mnew, t->u0, trnum, TR_FROM_DN);
+		  follow(ctx, mnew, t->u1, trnum, TR_FROM_DN);
 		}
 	    }
 	  else			/* no split possible */
 	    {
 	      retval = SP_NOSPLIT;
-	      traverse_polygon(mcur, t->u0, trnum, TR_FROM_DN);
-	      traverse_polygon(mcur, t->d0, trnum, TR_FROM_UP);
-	      traverse_polygon(mcur, t->u1, trnum, TR_FROM_DN);
-	      traverse_polygon(mcur, t->d1, trnum, TR_FROM_UP);	      	      
+	      follow(ctx, mcur, t->u0, trnum, TR_FROM_DN);
+	      follow(ctx, mcur, t->d0, trnum, TR_FROM_UP);
+	      follow(ctx, mcur, t->u1, trnum, TR_FROM_DN);
+	      follow(ctx, mcur, t->d1, trnum, TR_FROM_UP);	      	      
 	    }
 	}
     }
@@ -559,12 +576,74 @@ static int traverse_polygon(mcur, trnum, from, dir)
 }
 
 
+/* Queue a visit of trapezoid trnum, entered from trapezoid from, */
+/* as a part of monotone polygon mcur */
+static void follow(ctx, mcur, trnum, from, dir)
+     seidel_context_t *ctx;
+     int mcur;
+     int trnum;
+     int from;
+     int dir;
+{
+  trav_t *f;
+
+  if (ctx->trav_idx >= ctx->trav_size)
+    ctx->trav = (trav_t *) grow_table(ctx, ctx->trav, &ctx->trav_size,
+				      (size_t) ctx->trav_idx + 1,
+				      sizeof(trav_t));
+
+  f = &ctx->trav[ctx->trav_idx++];
+  f->mcur = mcur;
+  f->trnum = trnum;
+  f->from = from;
+  f->dir = dir;
+}
+
+
+/* Visit all the trapezoids reachable from trnum, depth first. The */
+/* visits queued by a trapezoid are reversed on the stack, so that */
+/* they happen in the order they were queued, each with everything */
+/* it leads to before the next one, just as the recursive calls */
+/* they replace did. An explicit stack keeps the depth of the */
+/* traversal, which grows with the polygon, off the call stack. */
+static int traverse_polygon(ctx, mcur, trnum, from, dir)
+     seidel_context_t *ctx;
+     int mcur;
+     int trnum;
+     int from;
+     int dir;
+{
+  trav_t f, tmp;
+  int i, j;
+
+  ctx->trav_idx = 0;
+  follow(ctx, mcur, trnum, from, dir);
+
+  while (ctx->trav_idx > 0)
+    {
+      f = ctx->trav[--ctx->trav_idx];
+      i = ctx->trav_idx;
+      visit_trapezoid(ctx, f.mcur, f.trnum, f.from, f.dir);
+
+      for (j = ctx->trav_idx - 1; i < j; i++, j--)
+	{
+	  tmp = ctx->trav[i];
+	  ctx->trav[i] = ctx->trav[j];
+	  ctx->trav[j] = tmp;
+	}
+    }
+
+  return 0;
+}
+
+
 /* For each monotone polygon, find the ymax and ymin (to determine the */
 /* two y-monotone chains) and pass on this monotone polygon for greedy */
 /* triangulation. */
 /* Take care not to triangulate duplicate monotone polygons */
 
-int triangulate_monotone_polygons(nvert, nmonpoly, op)
+int triangulate_monotone_polygons(ctx, nvert, nmonpoly, op)
+     seidel_context_t *ctx;
      int nvert;
      int nmonpoly;
      int op[][3];
@@ -578,49 +657,49 @@ int triangulate_monotone_polygons(nvert, nmonpoly, op)
   for (i = 0; i < nmonpoly; i++)
     {
       fprintf(stderr, "\n\nPolygon %d: ", i);
-      vfirst = mchain[mon[i]].vnum;
-      p = mchain[mon[i]].next;
-      fprintf (stderr, "%d ", mchain[mon[i]].vnum);
-      while (mchain[p].vnum != vfirst)
+      vfirst = ctx->mchain[ctx->mon[i]].vnum;
+      p = ctx->mchain[ctx->mon[i]].next;
+      fprintf (stderr, "%d ", ctx->mchain[ctx->mon[i]].vnum);
+      while (ctx->mchain[p].vnum != vfirst)
 	{
-	  fprintf(stderr, "%d ", mchain[p].vnum);
-	  p = mchain[p].next;
+	  fprintf(stderr, "%d ", ctx->mchain[p].vnum);
+	  p = ctx->mchain[p].next;
 	}
     }
   fprintf(stderr, "\n");
 #endif
 
-  op_idx = 0;
+  ctx->op_idx = 0;
   for (i = 0; i < nmonpoly; i++)
     {
       vcount = 1;
       processed = FALSE;
-      vfirst = mchain[mon[i]].vnum;
-      ymax = ymin = vert[vfirst].pt;
-      posmax = posmin = mon[i];
-      mchain[mon[i]].marked = TRUE;
-      p = mchain[mon[i]].next;
-      while ((v = mchain[p].vnum) != vfirst)
+      vfirst = ctx->mchain[ctx->mon[i]].vnum;
+      ymax = ymin = ctx->vert[vfirst].pt;
+      posmax = posmin = ctx->mon[i];
+      ctx->mchain[ctx->mon[i]].marked = TRUE;
+      p = ctx->mchain[ctx->mon[i]].next;
+      while ((v = ctx->mchain[p].vnum) != vfirst)
 	{
-	 if (mchain[p].marked)
+	 if (ctx->mchain[p].marked)
 	   {
 	     processed = TRUE;
 	     break;		/* break from while */
 	   }
 	 else
-	   mchain[p].marked = TRUE;
+	   ctx->mchain[p].marked = TRUE;
 
-	  if (_greater_than(&vert[v].pt, &ymax))
+	  if (_greater_than(&ctx->vert[v].pt, &ymax))
 	    {
-	      ymax = vert[v].pt;
+	      ymax = ctx->vert[v].pt;
 	      posmax = p;
 	    }
-	  if (_less_than(&vert[v].pt, &ymin))
+	  if (_less_than(&ctx->vert[v].pt, &ymin))
 	    {
-	      ymin = vert[v].pt;
+	      ymin = ctx->vert[v].pt;
 	      posmin = p;
 	    }
-	  p = mchain[p].next;
+	  p = ctx->mchain[p].next;
 	  vcount++;
        }
 
@@ -629,29 +708,29 @@ int triangulate_monotone_polygons(nvert, nmonpoly, op)
       
       if (vcount == 3)		/* already a triangle */
 	{
-	  op[op_idx][0] = mchain[p].vnum;
-	  op[op_idx][1] = mchain[mchain[p].next].vnum;
-	  op[op_idx][2] = mchain[mchain[p].prev].vnum;
-	  op_idx++;
+	  op[ctx->op_idx][0] = ctx->mchain[p].vnum;
+	  op[ctx->op_idx][1] = ctx->mchain[ctx->mchain[p].next].vnum;
+	  op[ctx->op_idx][2] = ctx->mchain[ctx->mchain[p].prev].vnum;
+	  ctx->op_idx++;
 	}
       else			/* triangulate the polygon */
 	{
-	  v = mchain[mchain[posmax].next].vnum;
-	  if (_equal_to(&vert[v].pt, &ymin))
+	  v = ctx->mchain[ctx->mchain[posmax].next].vnum;
+	  if (_equal_to(&ctx->vert[v].pt, &ymin))
 	    {			/* LHS is a single line */
-	      triangulate_single_polygon(nvert, posmax, TRI_LHS, op);
+	      triangulate_single_polygon(ctx, nvert, posmax, TRI_LHS, op);
 	    }
 	  else
-	    triangulate_single_polygon(nvert, posmax, TRI_RHS, op);
+	    triangulate_single_polygon(ctx, nvert, posmax, TRI_RHS, op);
 	}
     }
   
 #ifdef DEBUG
-  for (i = 0; i < op_idx; i++)
+  for (i = 0; i < ctx->op_idx; i++)
     fprintf(stderr, "tri #%d: (%d, %d, %d)\n", i, op[i][0], op[i][1],
 	   op[i][2]);
 #endif
-  return op_idx;
+  return ctx->op_idx;
 }
 
 
@@ -659,77 +738,83 @@ int triangulate_monotone_polygons(nvert, nmonpoly, op)
  * polygon in O(n) time.
  * Joseph O-Rourke, Computational Geometry in C.
  */
-static int triangulate_single_polygon(nvert, posmax, side, op)
+static int triangulate_single_polygon(ctx, nvert, posmax, side, op)
+     seidel_context_t *ctx;
      int nvert;
      int posmax;
      int side;
      int op[][3];
 {
   register int v;
-  int rc[SEGSIZE], ri = 0;	/* reflex chain */
+  int *rc = ctx->rc, ri = 0;	/* reflex chain */
   int endv, tmp, vpos;
   
   if (side == TRI_RHS)		/* RHS segment is a single segment */
     {
-      rc[0] = mchain[posmax].vnum;
-      tmp = mchain[posmax].next;
-      rc[1] = mchain[tmp].vnum;
+      rc[0] = ctx->mchain[posmax].vnum;
+      tmp = ctx->mchain[posmax].next;
+      rc[1] = ctx->mchain[tmp].vnum;
       ri = 1;
       
-      vpos = mchain[tmp].next;
-      v = mchain[vpos].vnum;
+      vpos = ctx->mchain[tmp].next;
+      v = ctx->mchain[vpos].vnum;
       
-      if ((endv = mchain[mchain[posmax].prev].vnum) == 0)
+      if ((endv = ctx->mchain[ctx->mchain[posmax].prev].vnum) == 0)
 	endv = nvert;
     }
   else				/* LHS is a single segment */
     {
-      tmp = mchain[posmax].next;
-      rc[0] = mchain[tmp].vnum;
-      tmp = mchain[tmp].next;
-      rc[1] = mchain[tmp].vnum;
+      tmp = ctx->mchain[posmax].next;
+      rc[0] = ctx->mchain[tmp].vnum;
+      tmp = ctx->mchain[tmp].next;
+      rc[1] = ctx->mchain[tmp].vnum;
       ri = 1;
 
-      vpos = mchain[tmp].next;
-      v = mchain[vpos].vnum;
+      vpos = ctx->mchain[tmp].next;
+      v = ctx->mchain[vpos].vnum;
 
-      endv = mchain[posmax].vnum;
+      endv = ctx->mchain[posmax].vnum;
     }
   
   while ((v != endv) || (ri > 1))
     {
       if (ri > 0)		/* reflex chain is non-empty */
 	{
-	  if (CROSS(vert[v].pt, vert[rc[ri - 1]].pt, 
-		    vert[rc[ri]].pt) > 0)
+#ifdef SEIDEL_TOLERANCE
+	  if (CROSS(ctx->vert[v].pt, ctx->vert[rc[ri - 1]].pt, 
+		    ctx->vert[rc[ri]].pt) > 0)
+#else
+	  if (orientation(&ctx->vert[v].pt, &ctx->vert[rc[ri - 1]].pt,
+			  &ctx->vert[rc[ri]].pt) > 0)
+#endif
 	    {			/* convex corner: cut if off */
-	      op[op_idx][0] = rc[ri - 1];
-	      op[op_idx][1] = rc[ri];
-	      op[op_idx][2] = v;
-	      op_idx++;	     
+	      op[ctx->op_idx][0] = rc[ri - 1];
+	      op[ctx->op_idx][1] = rc[ri];
+	      op[ctx->op_idx][2] = v;
+	      ctx->op_idx++;	     
 	      ri--;
 	    }
 	  else		/* non-convex */
 	    {		/* add v to the chain */
 	      ri++;
 	      rc[ri] = v;
-	      vpos = mchain[vpos].next;
-	      v = mchain[vpos].vnum;
+	      vpos = ctx->mchain[vpos].next;
+	      v = ctx->mchain[vpos].vnum;
 	    }
 	}
       else			/* reflex-chain empty: add v to the */
 	{			/* reflex chain and advance it  */
 	  rc[++ri] = v;
-	  vpos = mchain[vpos].next;
-	  v = mchain[vpos].vnum;
+	  vpos = ctx->mchain[vpos].next;
+	  v = ctx->mchain[vpos].vnum;
 	}
     } /* end-while */
   
   /* reached the bottom vertex. Add in the triangle formed */
-  op[op_idx][0] = rc[ri - 1];
-  op[op_idx][1] = rc[ri];
-  op[op_idx][2] = v;
-  op_idx++;	     
+  op[ctx->op_idx][0] = rc[ri - 1];
+  op[ctx->op_idx][1] = rc[ri];
+  op[ctx->op_idx][2] = v;
+  ctx->op_idx++;	     
   ri--;
   
   return 0;
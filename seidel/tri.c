@@ -3,19 +3,178 @@
 #include <string.h>
 
 
-static int initialise(n)
+static int initialise(ctx, n)
+     seidel_context_t *ctx;
      int n;
 {
   register int i;
 
   for (i = 1; i <= n; i++)
-    seg[i].is_inserted = FALSE;
+    ctx->seg[i].is_inserted = FALSE;
 
-  generate_random_ordering(n);
+  generate_random_ordering(ctx, n);
   
   return 0;
 }
 
+
+/* Make room in the tables of ctx for n segments. The trapezoid, */
+/* query, monotone chain and mon tables may still grow while the */
+/* polygon is triangulated. Jumps to ctx->env if out of memory. */
+static void reserve_tables(ctx, n)
+     seidel_context_t *ctx;
+     int n;
+{
+  size_t size = (size_t) n + 1;
+
+  ctx->seg = (segment_t *) grow_table(ctx, ctx->seg, &ctx->seg_size,
+				      size, sizeof(segment_t));
+  ctx->qs = (node_t *) grow_table(ctx, ctx->qs, &ctx->q_size,
+				  Q_PER_SEG * size, sizeof(node_t));
+  ctx->tr = (trap_t *) grow_table(ctx, ctx->tr, &ctx->tr_size,
+				  TR_PER_SEG * size, sizeof(trap_t));
+  ctx->mchain = (monchain_t *) grow_table(ctx, ctx->mchain,
+					  &ctx->mchain_size, 2 * size,
+					  sizeof(monchain_t));
+  ctx->vert = (vertexchain_t *) grow_table(ctx, ctx->vert, &ctx->vert_size,
+					   size, sizeof(vertexchain_t));
+  ctx->mon = (int *) grow_table(ctx, ctx->mon, &ctx->mon_size, size,
+				sizeof(int));
+  ctx->rc = (int *) grow_table(ctx, ctx->rc, &ctx->rc_size, size,
+			       sizeof(int));
+  ctx->permute = (int *) grow_table(ctx, ctx->permute, &ctx->permute_size,
+				    size, sizeof(int));
+}
+
+
+/* Allocate a context. Its tables start out empty, and grow to fit */
+/* the polygons triangulated in it. Returns NULL if out of memory. */
+seidel_context_t *seidel_create_context()
+{
+  return (seidel_context_t *) calloc(1, sizeof(seidel_context_t));
+}
+
+
+void seidel_destroy_context(ctx)
+     seidel_context_t *ctx;
+{
+  if (ctx == NULL)
+    return;
+
+  free(ctx->qs);
+  free(ctx->tr);
+  free(ctx->seg);
+  free(ctx->mchain);
+  free(ctx->vert);
+  free(ctx->mon);
+  free(ctx->visited);
+  free(ctx->rc);
+  free(ctx->trav);
+  free(ctx->permute);
+  free(ctx);
+}
+
+
+void seidel_set_seed(ctx, seed)
+     seidel_context_t *ctx;
+     unsigned long long seed;
+{
+  ctx->seed = seed;
+  ctx->seed_is_set = TRUE;
+}
+
+
+unsigned long long seidel_get_seed(ctx)
+     seidel_context_t *ctx;
+{
+  return ctx->seed;
+}
+
+
+/* Make room in the tables of ctx for the contours, given as for */
+/* seidel_triangulate_polygon(), and load their segments. Returns */
+/* the number of segments. Jumps to ctx->env if out of memory. */
+int load_contours(ctx, ncontours, cntr, vertices)
+     seidel_context_t *ctx;
+     int ncontours;
+     int cntr[];
+     double (*vertices)[2];
+{
+  register int i;
+  int ccount, npoints;
+  int n;
+
+  /* Clear only the segments of this polygon */
+  for (ccount = 0, n = 0; ccount < ncontours; ccount++)
+    n += cntr[ccount];
+
+  reserve_tables(ctx, n);
+  memset((void *)ctx->seg, 0, (n + 1) * sizeof(segment_t));
+
+  ccount = 0;
+  i = 1;
+  
+  while (ccount < ncontours)
+    {
+      int j;
+      int first, last;
+
+      npoints = cntr[ccount];
+      first = i;
+      last = first + npoints - 1;
+      for (j = 0; j < npoints; j++, i++)
+	{
+	  ctx->seg[i].v0.x = vertices[i][0];
+	  ctx->seg[i].v0.y = vertices[i][1];
+
+	  if (i == last)
+	    {
+	      ctx->seg[i].next = first;
+	      ctx->seg[i].prev = i-1;
+	      ctx->seg[i-1].v1 = ctx->seg[i].v0;
+	    }
+	  else if (i == first)
+	    {
+	      ctx->seg[i].next = i+1;
+	      ctx->seg[i].prev = last;
+	      ctx->seg[last].v1 = ctx->seg[i].v0;
+	    }
+	  else
+	    {
+	      ctx->seg[i].prev = i-1;
+	      ctx->seg[i].next = i+1;
+	      ctx->seg[i-1].v1 = ctx->seg[i].v0;
+	    }
+	  
+	  ctx->seg[i].is_inserted = FALSE;
+	}
+      
+      ccount++;
+    }
+  
+  return i-1;
+}
+
+
+/* Returns TRUE if the trapezoid trnum of the trapezoidation in ctx */
+/* lies inside the polygon */
+int is_inside_trapezoid(ctx, trnum)
+     seidel_context_t *ctx;
+     int trnum;
+{
+  trap_t *t = &ctx->tr[trnum];
+  int rseg;
+  
+  if (t->state == ST_INVALID)
+    return FALSE;
+  
+  if ((t->lseg <= 0) || (t->rseg <= 0))
+    return FALSE;
+  rseg = t->rseg;
+  return _greater_than_equal_to(&ctx->seg[rseg].v1, &ctx->seg[rseg].v0);
+}
+
+
 #ifdef STANDALONE
 
 int main(argc, argv)
@@ -23,23 +182,40 @@ int main(argc, argv)
      char *argv[];
 {
   int n, nmonpoly, genus;
-  int op[SEGSIZE][3], i, ntriangles;
+  int (*op)[3], i, ntriangles;
+  seidel_context_t *ctx;
 
-  if ((argc < 2) || ((n = read_segments(argv[1], &genus)) < 0))
+  if (((ctx = seidel_create_context()) == NULL) || setjmp(ctx->env))
     {
-      fprintf(stderr, "usage: triangulate <filename>\n");
+      fprintf(stderr, "triangulate: out of memory\n");
       exit(1);
     }
 
-  initialise(n);
-  construct_trapezoids(n);
-  nmonpoly = monotonate_trapezoids(n);
-  ntriangles = triangulate_monotone_polygons(n, nmonpoly, op);
+  if ((argc < 2) || ((n = read_segments(ctx, argv[1], &genus)) < 0))
+    {
+      fprintf(stderr, "usage: triangulate <filename> [seed]\n");
+      exit(1);
+    }
+
+  if (argc > 2)
+    seidel_set_seed(ctx, strtoull(argv[2], NULL, 10));
+
+  if ((op = (int (*)[3]) malloc((n + 1) * sizeof(int[3]))) == NULL)
+    longjmp(ctx->env, 1);
+
+  reserve_tables(ctx, n);
+  initialise(ctx, n);
+  construct_trapezoids(ctx, n);
+  nmonpoly = monotonate_trapezoids(ctx, n);
+  ntriangles = triangulate_monotone_polygons(ctx, n, nmonpoly, op);
 
+  printf("seed: %llu\n", seidel_get_seed(ctx));
   for (i = 0; i < ntriangles; i++)
     printf("triangle #%d: %d %d %d\n", i, 
 	   op[i][0], op[i][1], op[i][2]);
 
+  free(op);
+  seidel_destroy_context(ctx);
   return 0;
 }
 
@@ -65,70 +241,33 @@ int main(argc, argv)
  *	     specified  w.r.t. the indices of these vertices.
  * triangles: Output array to hold triangles.
  *  
- * Enough space must be allocated for all the arrays before calling
- * this routine
+ * Enough space must be allocated for the vertices and triangles
+ * before calling this routine. The tables of ctx grow to fit the
+ * polygon. Returns 0 on success, and -1 if they can't grow, in
+ * which case no triangles have been written.
  */
 
 
-int triangulate_polygon(ncontours, cntr, vertices, triangles)
+int seidel_triangulate_polygon(ctx, ncontours, cntr, vertices, triangles)
+     seidel_context_t *ctx;
      int ncontours;
      int cntr[];
      double (*vertices)[2];
      int (*triangles)[3];
 {
-  register int i;
-  int nmonpoly, ccount, npoints, genus;
+  int nmonpoly, genus;
   int n;
 
-  memset((void *)seg, 0, sizeof(seg));
-  ccount = 0;
-  i = 1;
-  
-  while (ccount < ncontours)
-    {
-      int j;
-      int first, last;
-
-      npoints = cntr[ccount];
-      first = i;
-      last = first + npoints - 1;
-      for (j = 0; j < npoints; j++, i++)
-	{
-	  seg[i].v0.x = vertices[i][0];
-	  seg[i].v0.y = vertices[i][1];
+  if (setjmp(ctx->env))
+    return -1;
 
-	  if (i == last)
-	    {
-	      seg[i].next = first;
-	      seg[i].prev = i-1;
-	      seg[i-1].v1 = seg[i].v0;
-	    }
-	  else if (i == first)
-	    {
-	      seg[i].next = i+1;
-	      seg[i].prev = last;
-	      seg[last].v1 = seg[i].v0;
-	    }
-	  else
-	    {
-	      seg[i].prev = i-1;
-	      seg[i].next = i+1;
-	      seg[i-1].v1 = seg[i].v0;
-	    }
-	  
-	  seg[i].is_inserted = FALSE;
-	}
-      
-      ccount++;
-    }
-  
+  n = load_contours(ctx, ncontours, cntr, vertices);
   genus = ncontours - 1;
-  n = i-1;
 
-  initialise(n);
-  construct_trapezoids(n);
-  nmonpoly = monotonate_trapezoids(n);
-  triangulate_monotone_polygons(n, nmonpoly, triangles);
+  initialise(ctx, n);
+  construct_trapezoids(ctx, n);
+  nmonpoly = monotonate_trapezoids(ctx, n);
+  triangulate_monotone_polygons(ctx, n, nmonpoly, triangles);
   
   return 0;
 }
@@ -142,26 +281,46 @@ int triangulate_polygon(ncontours, cntr, vertices, triangles)
  * on the boundary is not consistent!!!
  */
 
-int is_point_inside_polygon(vertex)
+int seidel_is_point_inside_polygon(ctx, vertex)
+     seidel_context_t *ctx;
      double vertex[2];
 {
   point_t v;
-  int trnum, rseg;
-  trap_t *t;
+  int trnum;
 
   v.x = vertex[0];
   v.y = vertex[1];
   
-  trnum = locate_endpoint(&v, &v, 1);
-  t = &tr[trnum];
-  
-  if (t->state == ST_INVALID)
-    return FALSE;
-  
-  if ((t->lseg <= 0) || (t->rseg <= 0))
+  trnum = locate_endpoint(ctx, &v, &v, 1);
+  return is_inside_trapezoid(ctx, trnum);
+}
+
+
+/* The context used by triangulate_polygon() and */
+/* is_point_inside_polygon(), created by the first call. */
+static seidel_context_t *shared_ctx;
+
+int triangulate_polygon(ncontours, cntr, vertices, triangles)
+     int ncontours;
+     int cntr[];
+     double (*vertices)[2];
+     int (*triangles)[3];
+{
+  if ((shared_ctx == NULL) && ((shared_ctx = seidel_create_context()) == NULL))
+    return -1;
+
+  return seidel_triangulate_polygon(shared_ctx, ncontours, cntr, vertices,
+				    triangles);
+}
+
+
+int is_point_inside_polygon(vertex)
+     double vertex[2];
+{
+  if (shared_ctx == NULL)
     return FALSE;
-  rseg = t->rseg;
-  return _greater_than_equal_to(&seg[rseg].v1, &seg[rseg].v0);
+
+  return seidel_is_point_inside_polygon(shared_ctx, vertex);
 }
 
 
@@ -4,6 +4,47 @@
 #include <sys/types.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <setjmp.h>
+
+/* With SEIDEL_TOLERANCE defined, points are compared, and the side */
+/* of a segment a point lies on is decided, with the tolerance */
+/* C_EPS, as before the predicates were made exact. That build */
+/* gives every function a _tolerance suffix, so that it can be */
+/* linked into the same program as the exact build. */
+
+#ifdef SEIDEL_TOLERANCE
+#define choose_segment                 choose_segment_tolerance
+#define construct_trapezoids           construct_trapezoids_tolerance
+#define _equal_to                      _equal_to_tolerance
+#define generate_random_ordering       generate_random_ordering_tolerance
+#define _greater_than                  _greater_than_tolerance
+#define _greater_than_equal_to         _greater_than_equal_to_tolerance
+#define grow_table                     grow_table_tolerance
+#define is_inside_trapezoid            is_inside_trapezoid_tolerance
+#define is_point_inside_polygon        is_point_inside_polygon_tolerance
+#define _left_of                       _left_of_tolerance
+#define _less_than                     _less_than_tolerance
+#define load_contours                  load_contours_tolerance
+#define locate_endpoint                locate_endpoint_tolerance
+#define math_N                         math_N_tolerance
+#define math_logstar_n                 math_logstar_n_tolerance
+#define monotonate_trapezoids          monotonate_trapezoids_tolerance
+#define orientation                    orientation_tolerance
+#define seidel_create_context          seidel_create_context_tolerance
+#define seidel_create_index            seidel_create_index_tolerance
+#define seidel_destroy_context         seidel_destroy_context_tolerance
+#define seidel_destroy_index           seidel_destroy_index_tolerance
+#define seidel_get_seed                seidel_get_seed_tolerance
+#define seidel_index_are_points_inside seidel_index_are_points_inside_tolerance
+#define seidel_index_is_point_inside   seidel_index_is_point_inside_tolerance
+#define seidel_is_point_inside_polygon seidel_is_point_inside_polygon_tolerance
+#define seidel_set_seed                seidel_set_seed_tolerance
+#define seidel_triangulate_polygon     seidel_triangulate_polygon_tolerance
+#define triangulate_monotone_polygons  triangulate_monotone_polygons_tolerance
+#define triangulate_polygon            triangulate_polygon_tolerance
+#endif
+
+#include "interface.h"
 
 typedef struct {
   double x, y;
@@ -62,6 +103,16 @@ typedef struct {
 } vertexchain_t;
 
 
+/* A pending visit in the traversal of the trapezoids */
+
+typedef struct {
+  int mcur;			/* monotone polygon */
+  int trnum;			/* trapezoid to visit */
+  int from;			/* trapezoid it is entered from */
+  int dir;			/* TR_FROM_UP or TR_FROM_DN */
+} trav_t;
+
+
 /* Node types */
 
 #define T_X     1
@@ -69,14 +120,13 @@ typedef struct {
 #define T_SINK  3
 
 
-#define SEGSIZE 50000		/* max# of segments. Determines how */
-				/* many points can be specified as */
-				/* input. If your datasets have large */
-				/* number of points, increase this */
-				/* value accordingly. */
+/* Number of entries per segment that the tables start out */
+/* with. Trapezoids and query nodes usually end up at about 5 and */
+/* 10 per segment, and all tables grow when they run out of room, */
+/* so these only save reallocations. */
 
-#define QSIZE   8*SEGSIZE	/* maximum table sizes */
-#define TRSIZE  4*SEGSIZE	/* max# trapezoids */
+#define TR_PER_SEG 5
+#define Q_PER_SEG 10
 
 
 #define TRUE  1
@@ -88,11 +138,15 @@ typedef struct {
 
 
 #define INFINITY 1<<30
+
+
+#ifdef SEIDEL_TOLERANCE
 #define C_EPS 1.0e-7		/* tolerance value: Used for making */
 				/* all decisions about collinearity or */
 				/* left/right of segment. Decrease */
 				/* this value if the input points are */
 				/* spaced very close together */
+#endif
 
 
 #define S_LEFT 1		/* for merge-direction */
@@ -127,32 +181,116 @@ typedef struct {
 
 #define DOT(v0, v1) ((v0).x * (v1).x + (v0).y * (v1).y)
 
+#ifdef SEIDEL_TOLERANCE
 #define FP_EQUAL(s, t) (fabs(s - t) <= C_EPS)
+#else
+#define FP_EQUAL(s, t) ((s) == (t))
+#endif
+
+
+/* All the state of a triangulation. Every table is owned by the */
+/* context, so contexts are independent of each other, and several */
+/* threads can triangulate at the same time, each with its own */
+/* context. */
+
+struct seidel_context {
+  node_t *qs;			/* Query structure */
+  trap_t *tr;			/* Trapezoid structure */
+  segment_t *seg;		/* Segment table */
+  int q_idx, tr_idx;		/* next free node and trapezoid */
+  int q_size, tr_size, seg_size; /* number of entries allocated */
+
+  monchain_t *mchain;		/* Table to hold all the monotone */
+				/* polygons . Each monotone polygon */
+				/* is a circularly linked list */
+  vertexchain_t *vert;		/* chain init. information. This */
+				/* is used to decide which */
+				/* monotone polygon to split if */
+				/* there are several other */
+				/* polygons touching at the same */
+				/* vertex  */
+  int *mon;			/* contains position of any vertex in */
+				/* the monotone chain for the polygon */
+  int *visited;
+  int *rc;			/* reflex chain of the monotone */
+				/* polygon being triangulated */
+  trav_t *trav;			/* stack of pending visits */
+  int chain_idx, op_idx, mon_idx, trav_idx;
+  int mchain_size, vert_size, mon_size, visited_size, rc_size, trav_size;
+
+  int *permute;			/* random ordering of the segments */
+  int permute_size;
+  int choose_idx;
+  unsigned long long seed;	/* seed of the last random ordering */
+  int seed_is_set;		/* seed set by seidel_set_seed() ? */
+  unsigned long long rand_state; /* state of next_random() */
+
+  jmp_buf env;			/* where to go when a table can't */
+				/* grow */
+};
+
+
+/* A node of a seidel_index. Nodes are referred to by their */
+/* position shifted left by two bits, ORed with the kind of the */
+/* node. The two kinds of leaves, which replace the sinks of the */
+/* query structure, have no node. A node takes 16 bytes: an IX_Y */
+/* node only keeps the y of its point, since x is needed only to */
+/* break ties, and is kept in a separate table. */
 
+typedef struct {
+  union {
+    double y;			/* IX_Y: y of the point to compare with */
+    int segnum;			/* IX_X: segment to compare with */
+  } key;
+  int left, right;		/* children */
+} index_node_t;
+
+#define IX_Y       0		/* node kinds */
+#define IX_X       1
+#define IX_OUTSIDE 2		/* leaf in a trapezoid outside the polygon */
+#define IX_INSIDE  3		/* leaf in a trapezoid inside the polygon */
 
+#define IX_KIND(ref) ((ref) & 3)
+#define IX_NODE(ref) ((ref) >> 2)
+#define IX_REF(i, kind) (((i) << 2) | (kind))
 
-/* Global variables */
+struct seidel_index {
+  index_node_t *nodes;		/* in breadth first blocks */
+  double *xs;			/* x of the point of each IX_Y node */
+  int nnodes;
+  int root;			/* reference to the root */
+  point_t *ends;		/* endpoints 2 i and 2 i + 1 of segment */
+				/* i, for the IX_X nodes */
+};
 
-extern node_t qs[QSIZE];		/* Query structure */
-extern trap_t tr[TRSIZE];		/* Trapezoid structure */
-extern segment_t seg[SEGSIZE];		/* Segment table */
+
+#if defined(__GNUC__)
+#define PREFETCH(p) __builtin_prefetch(p)
+#else
+#define PREFETCH(p) ((void) 0)
+#endif
 
 
 /* Functions */
 
-extern int monotonate_trapezoids(int);
-extern int triangulate_monotone_polygons(int, int, int (*)[3]);
+extern int monotonate_trapezoids(seidel_context_t *, int);
+extern int triangulate_monotone_polygons(seidel_context_t *, int, int, int (*)[3]);
 
 extern int _greater_than(point_t *, point_t *);
 extern int _equal_to(point_t *, point_t *);
 extern int _greater_than_equal_to(point_t *, point_t *);
 extern int _less_than(point_t *, point_t *);
-extern int locate_endpoint(point_t *, point_t *, int);
-extern int construct_trapezoids(int);
-
-extern int generate_random_ordering(int);
-extern int choose_segment(void);
-extern int read_segments(char *, int *);
+extern int orientation(point_t *, point_t *, point_t *);
+extern int _left_of(point_t *, point_t *, point_t *);
+extern int locate_endpoint(seidel_context_t *, point_t *, point_t *, int);
+extern int construct_trapezoids(seidel_context_t *, int);
+
+extern void *grow_table(seidel_context_t *, void *, int *, size_t, size_t);
+extern int load_contours(seidel_context_t *, int, int *, double (*)[2]);
+extern int is_inside_trapezoid(seidel_context_t *, int);
+extern int generate_random_ordering(seidel_context_t *, int);
+extern int choose_segment(seidel_context_t *);
+extern int read_segments(seidel_context_t *, char *, int *);
 extern int math_logstar_n(int);
 extern int math_N(int, int);
 
@@ -1,24 +1,130 @@
+#include "compressed_polygon_store.hpp"
 #include "countries_geojson.hpp"
 #include "dida/polygon2_utils.hpp"
+#include "geojson_seq_reader.hpp"
+#include "libtess2_variant.hpp"
+#include "polygon_store.hpp"
 #include "validation.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <catch2/benchmark/catch_benchmark_all.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
 #include <sstream>
+#include <thread>
 
 #include "libtess2/tesselator.h"
 #include "mapbox/earcut.hpp"
 
 #include "poly2tri/poly2tri.h"
 
-extern "C"
+#include "seidel/interface.h"
+
+using SeidelPoint = double[2];
+using SeidelTriangle = int[3];
+
+/// Makes sure that @c buffer has room for at least @c size elements. A vector of C arrays such as @c SeidelPoint can't
+/// be resized, since its elements can't be moved, so a buffer which is too small is replaced by a new one, and a buffer
+/// which is large enough is kept as it is, so that it's reused.
+template <class T>
+void reserve_seidel_buffer(std::vector<T>& buffer, size_t size)
+{
+  if (buffer.size() < size)
+  {
+    buffer = std::vector<T>(size);
+  }
+}
+
+/// Runs libtess2 once on the given contour with statistics enabled, and prints the time spent in each phase and the
+/// work counters, so that the benchmark rows of libtess2 can be broken down.
+void print_libtess2_stats(const std::string& name, const std::vector<float>& vertices, bool constrained_delaunay)
+{
+  TESSstats stats;
+  TESStesselator* tessellator = tessNewTess(nullptr);
+  tessSetStats(tessellator, &stats);
+  tessSetOption(tessellator, TESS_CONSTRAINED_DELAUNAY_TRIANGULATION, constrained_delaunay ? 1 : 0);
+  tessAddContour(tessellator, 2, vertices.data(), 2 * sizeof(float), static_cast<int>(vertices.size() / 2));
+  tessTesselate(tessellator, TESS_WINDING_ODD, TESS_POLYGONS, 3, 2, nullptr);
+  tessDeleteTess(tessellator);
+
+  std::cout << name << ": project " << stats.projectTime * 1e6 << " us, sweep " << stats.sweepTime * 1e6
+            << " us, tessellate " << stats.tessellateTime * 1e6 << " us, refine " << stats.refineTime * 1e6
+            << " us, output " << stats.outputTime * 1e6 << " us; " << stats.events << " events, "
+            << stats.edgeComparisons << " edge comparisons, " << stats.intersections << " intersections, "
+            << stats.delaunayFlips << " Delaunay flips" << std::endl;
+}
+
+/// The output of one libtess2 run with TESS_POLYGONS of at most 3 vertices.
+struct Libtess2Output
+{
+  bool succeeded = false;
+  std::vector<float> vertices;
+  std::vector<TESSindex> vertex_indices;
+  std::vector<TESSindex> elements;
+};
+
+/// Triangulates the given contour with libtess2 and returns its output arrays, optionally with TESS_SIMPLE_POLYGON.
+Libtess2Output run_libtess2(const std::vector<float>& vertices, bool simple_polygon)
+{
+  Libtess2Output output;
+  TESStesselator* tessellator = tessNewTess(nullptr);
+  tessSetOption(tessellator, TESS_CONSTRAINED_DELAUNAY_TRIANGULATION, 0);
+  tessSetOption(tessellator, TESS_SIMPLE_POLYGON, simple_polygon ? 1 : 0);
+  tessAddContour(tessellator, 2, vertices.data(), 2 * sizeof(float), static_cast<int>(vertices.size() / 2));
+  output.succeeded = tessTesselate(tessellator, TESS_WINDING_ODD, TESS_POLYGONS, 3, 2, nullptr) != 0;
+  if (output.succeeded)
+  {
+    size_t num_vertices = static_cast<size_t>(tessGetVertexCount(tessellator));
+    size_t num_elements = 3 * static_cast<size_t>(tessGetElementCount(tessellator));
+    output.vertices.assign(tessGetVertices(tessellator), tessGetVertices(tessellator) + 2 * num_vertices);
+    output.vertex_indices.assign(tessGetVertexIndices(tessellator), tessGetVertexIndices(tessellator) + num_vertices);
+    output.elements.assign(tessGetElements(tessellator), tessGetElements(tessellator) + num_elements);
+  }
+
+  tessDeleteTess(tessellator);
+  return output;
+}
+
+/// Triangulates the given contour with libtess2's TESS_TRIANGLE_INDICES output, written into a caller buffer or passed
+/// to a callback, and returns the triangles. Returns an empty vector if tessTesselate failed.
+std::vector<TESSindex> run_libtess2_triangle_indices(const std::vector<float>& vertices, bool use_callback)
 {
+  std::vector<TESSindex> triangles;
+  std::vector<TESSindex> triangle_buffer(3 * vertices.size());
+  TESStriangleFn append_triangles = [](void* user_data, const TESSindex* batch, int count)
+  {
+    std::vector<TESSindex>& triangles = *static_cast<std::vector<TESSindex>*>(user_data);
+    triangles.insert(triangles.end(), batch, batch + 3 * count);
+  };
 
-  using SeidelPoint = double[2];
-  using SeidelTriangle = int[3];
+  TESStesselator* tessellator = tessNewTess(nullptr);
+  tessSetOption(tessellator, TESS_CONSTRAINED_DELAUNAY_TRIANGULATION, 0);
+  if (use_callback)
+  {
+    tessSetTriangleOutput(tessellator, nullptr, 0, append_triangles, &triangles);
+  }
+  else
+  {
+    tessSetTriangleOutput(tessellator, triangle_buffer.data(), static_cast<int>(triangle_buffer.size() / 3), nullptr,
+                          nullptr);
+  }
+  tessAddContour(tessellator, 2, vertices.data(), 2 * sizeof(float), static_cast<int>(vertices.size() / 2));
+  if (!tessTesselate(tessellator, TESS_WINDING_ODD, TESS_TRIANGLE_INDICES, 3, 2, nullptr))
+  {
+    triangles.clear();
+  }
+  else if (!use_callback)
+  {
+    triangles.assign(triangle_buffer.begin(), triangle_buffer.begin() + 3 * tessGetElementCount(tessellator));
+  }
 
-  // Seidel's triangulate function.
-  int triangulate_polygon(int ncontours, int cntr[], SeidelPoint* vertices, SeidelTriangle* triangles);
+  tessDeleteTess(tessellator);
+  return triangles;
 }
 
 void benchmark_triangulate(const std::string& name, PolygonView2 polygon)
@@ -73,6 +179,9 @@ void benchmark_triangulate(const std::string& name, PolygonView2 polygon)
       CHECK(validate_triangulation(polygon, triangulation));
     }*/
 
+    print_libtess2_stats(name_and_num_vertices + " libtess2", vertices, false);
+    print_libtess2_stats(name_and_num_vertices + " libtess2, constrained delaunay", vertices, true);
+
     BENCHMARK(name_and_num_vertices + " libtess2")
     {
       TESStesselator* tessellator = tessNewTess(nullptr);
@@ -94,6 +203,65 @@ void benchmark_triangulate(const std::string& name, PolygonView2 polygon)
 
       return tessellator;
     };
+
+    // Writes the triangles as indices of the input vertices straight into a buffer owned by the caller, rather than
+    // building libtess2's own vertex and element arrays, which would then have to be remapped to the input vertices.
+    // Both the buffer and the callback must give exactly the generic triangles, remapped to the input vertices.
+    Libtess2Output generic_output = run_libtess2(vertices, false);
+    REQUIRE(generic_output.succeeded);
+    std::vector<TESSindex> remapped_triangles(generic_output.elements.size());
+    for (size_t i = 0; i < remapped_triangles.size(); i++)
+    {
+      remapped_triangles[i] = generic_output.vertex_indices[generic_output.elements[i]];
+    }
+    CHECK(run_libtess2_triangle_indices(vertices, false) == remapped_triangles);
+    CHECK(run_libtess2_triangle_indices(vertices, true) == remapped_triangles);
+
+    std::vector<TESSindex> triangle_buffer(3 * 2 * polygon.size());
+    BENCHMARK(name_and_num_vertices + " libtess2, triangle indices into caller buffer")
+    {
+      TESStesselator* tessellator = tessNewTess(nullptr);
+      tessSetOption(tessellator, TESS_CONSTRAINED_DELAUNAY_TRIANGULATION, 0);
+      tessSetTriangleOutput(tessellator, triangle_buffer.data(), static_cast<int>(triangle_buffer.size() / 3), nullptr,
+                            nullptr);
+      tessAddContour(tessellator, 2, vertices.data(), 2 * sizeof(float), polygon.size());
+      int succeeded = tessTesselate(tessellator, TESS_WINDING_ODD, TESS_TRIANGLE_INDICES, 3, 2, nullptr);
+      tessDeleteTess(tessellator);
+
+      return succeeded;
+    };
+
+    // The simple polygon fast path is undefined behaviour unless the polygon is still simple after its coordinates
+    // were rounded to floats, which isn't implied by the original polygon being simple, since rounding can make edges
+    // touch or cross. The rounded coordinates are therefore validated as a polygon of their own, and the fast path is
+    // only benchmarked if they pass.
+    std::vector<Point2> rounded_vertices;
+    rounded_vertices.reserve(polygon.size());
+    for (size_t i = 0; i < polygon.size(); i++)
+    {
+      rounded_vertices.emplace_back(ScalarDeg1(static_cast<double>(vertices[2 * i])),
+                                    ScalarDeg1(static_cast<double>(vertices[2 * i + 1])));
+    }
+    if (Polygon2::try_construct_from_vertices(std::move(rounded_vertices)))
+    {
+      // The fast path skips work which a simple polygon doesn't need, so it must give exactly the generic output.
+      Libtess2Output simple_output = run_libtess2(vertices, true);
+      CHECK(simple_output.succeeded);
+      CHECK(simple_output.vertices == generic_output.vertices);
+      CHECK(simple_output.elements == generic_output.elements);
+
+      BENCHMARK(name_and_num_vertices + " libtess2, simple polygon")
+      {
+        TESStesselator* tessellator = tessNewTess(nullptr);
+        tessSetOption(tessellator, TESS_CONSTRAINED_DELAUNAY_TRIANGULATION, 0);
+        tessSetOption(tessellator, TESS_SIMPLE_POLYGON, 1);
+        tessAddContour(tessellator, 2, vertices.data(), 2 * sizeof(float), polygon.size());
+        tessTesselate(tessellator, TESS_WINDING_ODD, TESS_POLYGONS, 3, 2, nullptr);
+        tessDeleteTess(tessellator);
+
+        return tessellator;
+      };
+    }
   }
 
   {
@@ -162,6 +330,15 @@ void benchmark_triangulate(const std::string& name, PolygonView2 polygon)
       triangulate_polygon(1, &num_vertices, vertices.data(), result.data());
       return result;
     };
+
+    // The same with the seidel_tolerance library, which compares points with a tolerance instead of exactly.
+    BENCHMARK(name_and_num_vertices + ", Seidel, tolerance")
+    {
+      std::vector<SeidelTriangle> result(polygon.size() - 2);
+      int num_vertices = static_cast<int>(polygon.size());
+      triangulate_polygon_tolerance(1, &num_vertices, vertices.data(), result.data());
+      return result;
+    };
   }
 
   {
@@ -220,6 +397,222 @@ void benchmark_triangulate(const std::string& name, PolygonView2 polygon)
   };
 }
 
+void benchmark_triangulate_with_holes(const std::string& name, const std::vector<PolygonWithHoles2>& parts)
+{
+  size_t num_vertices = 0;
+  size_t num_holes = 0;
+  for (const PolygonWithHoles2& part : parts)
+  {
+    num_vertices += part.num_vertices();
+    num_holes += part.holes.size();
+  }
+
+  std::stringstream s;
+  s << name << " (" << num_vertices << " vertices, " << parts.size() << " parts, " << num_holes << " holes)";
+  std::string name_and_num_vertices = s.str();
+
+  {
+    // All rings of all parts are added as separate contours of a single tessellation, the odd winding rule takes care
+    // of the holes.
+    std::vector<std::vector<float>> contours;
+    for (const PolygonWithHoles2& part : parts)
+    {
+      contours.emplace_back();
+      for (Point2 vertex : part.outer_boundary)
+      {
+        contours.back().push_back(static_cast<float>(static_cast<double>(vertex.x())));
+        contours.back().push_back(static_cast<float>(static_cast<double>(vertex.y())));
+      }
+
+      for (const Polygon2& hole : part.holes)
+      {
+        contours.emplace_back();
+        for (Point2 vertex : hole)
+        {
+          contours.back().push_back(static_cast<float>(static_cast<double>(vertex.x())));
+          contours.back().push_back(static_cast<float>(static_cast<double>(vertex.y())));
+        }
+      }
+    }
+
+    BENCHMARK(name_and_num_vertices + ", libtess2")
+    {
+      TESStesselator* tessellator = tessNewTess(nullptr);
+      tessSetOption(tessellator, TESS_CONSTRAINED_DELAUNAY_TRIANGULATION, 0);
+      for (const std::vector<float>& contour : contours)
+      {
+        tessAddContour(tessellator, 2, contour.data(), 2 * sizeof(float), static_cast<int>(contour.size() / 2));
+      }
+      tessTesselate(tessellator, TESS_WINDING_ODD, TESS_POLYGONS, 3, 2, nullptr);
+      tessDeleteTess(tessellator);
+
+      return tessellator;
+    };
+  }
+
+  {
+    using MapboxPoint = std::pair<float, float>;
+    std::vector<std::vector<std::vector<MapboxPoint>>> mapbox_polygons;
+    for (const PolygonWithHoles2& part : parts)
+    {
+      std::vector<std::vector<MapboxPoint>>& mapbox_polygon = mapbox_polygons.emplace_back();
+
+      std::vector<MapboxPoint>& mapbox_outer_ring = mapbox_polygon.emplace_back();
+      for (Point2 vertex : part.outer_boundary)
+      {
+        mapbox_outer_ring.emplace_back(static_cast<double>(vertex.x()), static_cast<double>(vertex.y()));
+      }
+
+      for (const Polygon2& hole : part.holes)
+      {
+        std::vector<MapboxPoint>& mapbox_hole_ring = mapbox_polygon.emplace_back();
+        for (Point2 vertex : hole)
+        {
+          mapbox_hole_ring.emplace_back(static_cast<double>(vertex.x()), static_cast<double>(vertex.y()));
+        }
+      }
+    }
+
+    BENCHMARK(name_and_num_vertices + ", Mapbox earcut.hpp")
+    {
+      std::vector<std::vector<uint32_t>> result;
+      for (const std::vector<std::vector<MapboxPoint>>& mapbox_polygon : mapbox_polygons)
+      {
+        result.push_back(mapbox::earcut<uint32_t>(mapbox_polygon));
+      }
+      return result;
+    };
+  }
+
+  {
+    // Seidel expects the outer contour to be counter clockwise and the holes to be clockwise, so the holes are added in
+    // reverse order. As always, index 0 of the vertex array is unused.
+    struct SeidelPart
+    {
+      std::vector<int> contour_sizes;
+      std::vector<SeidelPoint> vertices;
+      std::vector<Point2> points;
+      size_t num_triangles;
+    };
+
+    std::vector<SeidelPart> seidel_parts;
+    for (const PolygonWithHoles2& part : parts)
+    {
+      SeidelPart& seidel_part = seidel_parts.emplace_back();
+      reserve_seidel_buffer(seidel_part.vertices, part.num_vertices() + 1);
+
+      size_t i = 1;
+      seidel_part.contour_sizes.push_back(static_cast<int>(part.outer_boundary.size()));
+      for (Point2 vertex : part.outer_boundary)
+      {
+        seidel_part.vertices[i][0] = static_cast<double>(vertex.x());
+        seidel_part.vertices[i][1] = static_cast<double>(vertex.y());
+        seidel_part.points.push_back(vertex);
+        i++;
+      }
+
+      for (const Polygon2& hole : part.holes)
+      {
+        seidel_part.contour_sizes.push_back(static_cast<int>(hole.size()));
+        for (size_t j = hole.size(); j-- > 0;)
+        {
+          seidel_part.vertices[i][0] = static_cast<double>(hole[j].x());
+          seidel_part.vertices[i][1] = static_cast<double>(hole[j].y());
+          seidel_part.points.push_back(hole[j]);
+          i++;
+        }
+      }
+
+      seidel_part.num_triangles = part.num_vertices() - 2 + 2 * part.holes.size();
+    }
+
+    // Seidel's trapezoidation handles the holes itself, rather than bridging them into the outer boundary like
+    // earcut.hpp, so each part is checked once to be a tessellation of the part with its holes. Triangles which Seidel
+    // didn't output keep their vertex indices of 0.
+    for (size_t i = 0; i < parts.size(); i++)
+    {
+      SeidelPart& seidel_part = seidel_parts[i];
+      std::vector<SeidelTriangle> triangles(seidel_part.num_triangles);
+      CHECK(triangulate_polygon(static_cast<int>(seidel_part.contour_sizes.size()), seidel_part.contour_sizes.data(),
+                                seidel_part.vertices.data(), triangles.data()) == 0);
+
+      std::vector<Triangle2> triangulation;
+      triangulation.reserve(triangles.size());
+      for (const SeidelTriangle& triangle : triangles)
+      {
+        if (std::any_of(std::begin(triangle), std::end(triangle),
+                        [&](int index) { return index < 1 || index > static_cast<int>(seidel_part.points.size()); }))
+        {
+          break;
+        }
+
+        std::array<Point2, 3> vertices{seidel_part.points[triangle[0] - 1], seidel_part.points[triangle[1] - 1],
+                                       seidel_part.points[triangle[2] - 1]};
+        triangulation.push_back(Triangle2(vertices));
+      }
+
+      CHECK(validate_triangulation(parts[i], triangulation));
+    }
+
+    BENCHMARK(name_and_num_vertices + ", Seidel")
+    {
+      std::vector<std::vector<SeidelTriangle>> result;
+      for (SeidelPart& seidel_part : seidel_parts)
+      {
+        std::vector<SeidelTriangle>& triangles = result.emplace_back(seidel_part.num_triangles);
+        triangulate_polygon(static_cast<int>(seidel_part.contour_sizes.size()), seidel_part.contour_sizes.data(),
+                            seidel_part.vertices.data(), triangles.data());
+      }
+      return result;
+    };
+  }
+
+  BENCHMARK(name_and_num_vertices + ", poly2tri")
+  {
+    for (const PolygonWithHoles2& part : parts)
+    {
+      std::vector<p2t::Point> p2t_vertices;
+      p2t_vertices.reserve(part.num_vertices());
+      for (Point2 vertex : part.outer_boundary)
+      {
+        p2t_vertices.emplace_back(static_cast<double>(vertex.x()), static_cast<double>(vertex.y()));
+      }
+
+      for (const Polygon2& hole : part.holes)
+      {
+        for (Point2 vertex : hole)
+        {
+          p2t_vertices.emplace_back(static_cast<double>(vertex.x()), static_cast<double>(vertex.y()));
+        }
+      }
+
+      std::vector<p2t::Point*> p2t_outer_boundary(part.outer_boundary.size());
+      for (size_t i = 0; i < part.outer_boundary.size(); i++)
+      {
+        p2t_outer_boundary[i] = &p2t_vertices[i];
+      }
+
+      p2t::CDT cdt(p2t_outer_boundary);
+
+      size_t hole_start = part.outer_boundary.size();
+      for (const Polygon2& hole : part.holes)
+      {
+        std::vector<p2t::Point*> p2t_hole(hole.size());
+        for (size_t i = 0; i < hole.size(); i++)
+        {
+          p2t_hole[i] = &p2t_vertices[hole_start + i];
+        }
+
+        cdt.AddHole(p2t_hole);
+        hole_start += hole.size();
+      }
+
+      cdt.Triangulate();
+      cdt.GetTriangles();
+    }
+  };
+}
+
 TEST_CASE("triangulate benchmark")
 {
   CountriesGeoJson countries =
@@ -230,4 +623,828 @@ TEST_CASE("triangulate benchmark")
   benchmark_triangulate("Bangladesh", countries.polygon_for_country("Bangladesh"));
   benchmark_triangulate("Netherlands", countries.polygon_for_country("Netherlands"));
   benchmark_triangulate("San Marino", countries.polygon_for_country("San Marino"));
-}
\ No newline at end of file
+}
+
+/// Returns the vertices of @c polygon in the layout Seidel expects, which starts at index 1.
+std::vector<SeidelPoint> seidel_vertices(PolygonView2 polygon)
+{
+  std::vector<SeidelPoint> vertices(polygon.size() + 1);
+  for (size_t i = 0; i < polygon.size(); i++)
+  {
+    vertices[i + 1][0] = static_cast<double>(polygon[i].x());
+    vertices[i + 1][1] = static_cast<double>(polygon[i].y());
+  }
+
+  return vertices;
+}
+
+/// Returns the names of the (at most) @c count countries with the largest outer boundaries, from largest to smallest.
+std::vector<std::string> largest_country_names(const CountriesGeoJson& countries, size_t count)
+{
+  std::vector<std::string> country_names = countries.country_names();
+  std::sort(country_names.begin(), country_names.end(),
+            [&](const std::string& a, const std::string& b)
+            { return countries.polygon_for_country(a).size() > countries.polygon_for_country(b).size(); });
+  country_names.resize(std::min(country_names.size(), count));
+  return country_names;
+}
+
+/// Returns the names of the (at most) @c count countries with the most holes, summed over all their parts, from most
+/// to fewest.
+std::vector<std::string> most_holes_country_names(const CountriesGeoJson& countries, size_t count)
+{
+  auto num_holes = [&](const std::string& country_name)
+  {
+    size_t result = 0;
+    for (const PolygonWithHoles2& part : countries.parts_for_country(country_name))
+    {
+      result += part.holes.size();
+    }
+
+    return result;
+  };
+
+  std::vector<std::string> country_names = countries.country_names();
+  std::stable_sort(country_names.begin(), country_names.end(),
+                   [&](const std::string& a, const std::string& b) { return num_holes(a) > num_holes(b); });
+  country_names.resize(std::min(country_names.size(), count));
+  return country_names;
+}
+
+TEST_CASE("libtess2 scaling benchmark")
+{
+  CountriesGeoJson countries = *CountriesGeoJson::read_from_file("data/countries.geojson");
+
+  // The outer boundaries of the largest countries, from largest to smallest, which show how the sweep of libtess2
+  // scales with the number of edges crossing the sweep line.
+  std::vector<std::string> country_names = largest_country_names(countries, 8);
+
+  for (size_t i = 0; i < country_names.size(); i++)
+  {
+    PolygonView2 polygon = countries.polygon_for_country(country_names[i]);
+
+    std::vector<float> vertices(2 * polygon.size());
+    for (size_t j = 0; j < polygon.size(); j++)
+    {
+      vertices[2 * j] = static_cast<double>(polygon[j].x());
+      vertices[2 * j + 1] = static_cast<double>(polygon[j].y());
+    }
+
+    std::stringstream s;
+    s << country_names[i] << " (" << polygon.size() << " vertices), libtess2";
+    BENCHMARK(s.str())
+    {
+      TESStesselator* tessellator = tessNewTess(nullptr);
+      tessAddContour(tessellator, 2, vertices.data(), 2 * sizeof(float), polygon.size());
+      tessTesselate(tessellator, TESS_WINDING_ODD, TESS_POLYGONS, 3, 2, nullptr);
+      tessDeleteTess(tessellator);
+
+      return tessellator;
+    };
+  }
+}
+
+TEST_CASE("Seidel scaling benchmark")
+{
+  CountriesGeoJson countries = *CountriesGeoJson::read_from_file("data/countries.geojson");
+
+  // The same outer boundaries as the libtess2 scaling benchmark. Seidel's tables grow to fit the input, so it isn't
+  // limited to small polygons.
+  for (const std::string& country_name : largest_country_names(countries, 8))
+  {
+    PolygonView2 polygon = countries.polygon_for_country(country_name);
+
+    std::vector<SeidelPoint> vertices = seidel_vertices(polygon);
+    std::vector<SeidelTriangle> triangles(polygon.size() - 2);
+    int num_vertices = static_cast<int>(polygon.size());
+    CHECK(triangulate_polygon(1, &num_vertices, vertices.data(), triangles.data()) == 0);
+
+    std::stringstream s;
+    s << country_name << " (" << polygon.size() << " vertices), Seidel";
+    BENCHMARK(s.str())
+    {
+      triangulate_polygon(1, &num_vertices, vertices.data(), triangles.data());
+      return triangles.data();
+    };
+  }
+}
+
+TEST_CASE("Seidel seed spread benchmark")
+{
+  CountriesGeoJson countries = *CountriesGeoJson::read_from_file("data/countries.geojson");
+
+  // Seidel adds the segments in a random order, so its O(n log* n) running time only holds in expectation.
+  // Triangulating with many seeds shows how much the time varies between orders, and which seed reproduces the
+  // slowest one.
+  const size_t num_seeds = 100;
+  std::shared_ptr<seidel_context_t> context(seidel_create_context(), seidel_destroy_context);
+  for (const char* country_name : {"Canada", "Chile", "Bangladesh", "Netherlands", "San Marino"})
+  {
+    PolygonView2 polygon = countries.polygon_for_country(country_name);
+    std::vector<SeidelPoint> vertices = seidel_vertices(polygon);
+    std::vector<SeidelTriangle> triangles(polygon.size() - 2);
+    int num_vertices = static_cast<int>(polygon.size());
+
+    // The duration in microseconds and the seed of every run.
+    std::vector<std::pair<double, unsigned long long>> runs;
+    for (unsigned long long seed = 0; seed < num_seeds; seed++)
+    {
+      seidel_set_seed(context.get(), seed);
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      int result = seidel_triangulate_polygon(context.get(), 1, &num_vertices, vertices.data(), triangles.data());
+      std::chrono::duration<double, std::micro> duration = std::chrono::steady_clock::now() - start;
+      CHECK(result == 0);
+      runs.emplace_back(duration.count(), seed);
+    }
+
+    std::sort(runs.begin(), runs.end());
+    std::stringstream s;
+    s << country_name << " (" << polygon.size() << " vertices), Seidel";
+    std::string name = s.str();
+    std::cout << name << " over " << num_seeds << " seeds: min " << runs.front().first << " us, median "
+              << runs[num_seeds / 2].first << " us, 90th percentile " << runs[num_seeds * 9 / 10].first
+              << " us, max " << runs.back().first << " us (seed " << runs.back().second << ")" << std::endl;
+
+    // With a fixed seed, every sample triangulates in the same order.
+    seidel_set_seed(context.get(), 0);
+    BENCHMARK(name + ", seed 0")
+    {
+      seidel_triangulate_polygon(context.get(), 1, &num_vertices, vertices.data(), triangles.data());
+      return triangles.data();
+    };
+  }
+}
+
+TEST_CASE("point location benchmark")
+{
+  CountriesGeoJson countries = *CountriesGeoJson::read_from_file("data/countries.geojson");
+
+  // Brute force is_within is linear in the number of vertices, so the number of query points is kept small enough for
+  // it to finish on the larger countries.
+  const size_t num_points = 1000;
+  std::mt19937 random(1);
+
+  for (const char* country_name : {"Canada", "Chile", "Bangladesh", "Netherlands", "San Marino"})
+  {
+    PolygonView2 polygon = countries.polygon_for_country(country_name);
+    std::vector<SeidelPoint> vertices = seidel_vertices(polygon);
+    int num_vertices = static_cast<int>(polygon.size());
+
+    // Query points spread uniformly over the bounding box of the polygon.
+    double min_x = vertices[1][0], max_x = vertices[1][0], min_y = vertices[1][1], max_y = vertices[1][1];
+    for (size_t i = 1; i < vertices.size(); i++)
+    {
+      min_x = std::min(min_x, vertices[i][0]);
+      max_x = std::max(max_x, vertices[i][0]);
+      min_y = std::min(min_y, vertices[i][1]);
+      max_y = std::max(max_y, vertices[i][1]);
+    }
+
+    std::uniform_real_distribution<double> x_distribution(min_x, max_x);
+    std::uniform_real_distribution<double> y_distribution(min_y, max_y);
+    std::vector<Point2> points(num_points);
+    std::vector<SeidelPoint> seidel_points(num_points);
+    for (size_t i = 0; i < num_points; i++)
+    {
+      points[i] = Point2(x_distribution(random), y_distribution(random));
+      seidel_points[i][0] = static_cast<double>(points[i].x());
+      seidel_points[i][1] = static_cast<double>(points[i].y());
+    }
+
+    std::shared_ptr<seidel_index_t> index(seidel_create_index(1, &num_vertices, vertices.data()),
+                                          seidel_destroy_index);
+    REQUIRE(index);
+
+    // Seidel's results on the boundary aren't consistent, but random points are unlikely to land there, so the index
+    // has to agree with is_within on all of them.
+    std::vector<int> inside(num_points);
+    seidel_index_are_points_inside(index.get(), static_cast<int>(num_points), seidel_points.data(), inside.data());
+    size_t num_inside = 0;
+    size_t num_disagreements = 0;
+    for (size_t i = 0; i < num_points; i++)
+    {
+      num_inside += inside[i];
+      num_disagreements += inside[i] != is_within(polygon, points[i]);
+    }
+
+    std::stringstream s;
+    s << country_name << " (" << polygon.size() << " vertices, " << num_points << " points)";
+    std::string name = s.str();
+    std::cout << name << ": " << num_inside << " inside, " << num_disagreements << " disagreements with is_within"
+              << std::endl;
+    CHECK(num_disagreements == 0);
+
+    BENCHMARK(name + ", is_within")
+    {
+      size_t num_inside = 0;
+      for (Point2 point : points)
+      {
+        num_inside += is_within(polygon, point);
+      }
+
+      return num_inside;
+    };
+
+    // A context keeps the query structure as the trapezoidation left it, in 40 byte nodes in allocation order, which
+    // is the layout before the index packs it into breadth first blocks of 16 byte nodes. Building a context also
+    // triangulates, which building an index doesn't.
+    std::shared_ptr<seidel_context_t> context(seidel_create_context(), seidel_destroy_context);
+    std::vector<SeidelTriangle> triangles(polygon.size() - 2);
+    CHECK(seidel_triangulate_polygon(context.get(), 1, &num_vertices, vertices.data(), triangles.data()) == 0);
+
+    BENCHMARK(name + ", Seidel context build")
+    {
+      return seidel_triangulate_polygon(context.get(), 1, &num_vertices, vertices.data(), triangles.data());
+    };
+
+    BENCHMARK(name + ", Seidel context, one at a time")
+    {
+      size_t num_inside = 0;
+      for (SeidelPoint& point : seidel_points)
+      {
+        num_inside += seidel_is_point_inside_polygon(context.get(), point);
+      }
+
+      return num_inside;
+    };
+
+    BENCHMARK(name + ", Seidel index build")
+    {
+      return std::shared_ptr<seidel_index_t>(seidel_create_index(1, &num_vertices, vertices.data()),
+                                             seidel_destroy_index);
+    };
+
+    BENCHMARK(name + ", Seidel index, one at a time")
+    {
+      size_t num_inside = 0;
+      for (SeidelPoint& point : seidel_points)
+      {
+        num_inside += seidel_index_is_point_inside(index.get(), point);
+      }
+
+      return num_inside;
+    };
+
+    BENCHMARK(name + ", Seidel index, batched")
+    {
+      seidel_index_are_points_inside(index.get(), static_cast<int>(num_points), seidel_points.data(), inside.data());
+      return inside.data();
+    };
+  }
+}
+
+TEST_CASE("libtess2 coordinate type benchmark")
+{
+  CountriesGeoJson countries = *CountriesGeoJson::read_from_file("data/countries.geojson");
+
+  using TriangulateFn = bool (*)(PolygonView2, std::vector<std::array<int, 3>>&);
+  std::array<std::pair<const char*, TriangulateFn>, 3> variants{{{"float", triangulate_libtess2_float},
+                                                                 {"double", triangulate_libtess2_double},
+                                                                 {"fixed point", triangulate_libtess2_fixed}}};
+
+  for (const char* country_name : {"Canada", "Chile", "Bangladesh", "Netherlands", "San Marino"})
+  {
+    PolygonView2 polygon = countries.polygon_for_country(country_name);
+
+    for (const auto& [variant_name, triangulate_fn] : variants)
+    {
+      std::stringstream s;
+      s << country_name << " (" << polygon.size() << " vertices), libtess2 " << variant_name;
+      std::string name = s.str();
+
+      // A triangulation of a simple polygon has exactly n - 2 triangles, none of which have zero area, so both
+      // counts show where the rounding of the coordinates made libtess2 go wrong.
+      std::vector<std::array<int, 3>> triangles;
+      bool succeeded = triangulate_fn(polygon, triangles);
+      size_t num_zero_area_triangles = std::count_if(triangles.begin(), triangles.end(),
+                                                     [&](const std::array<int, 3>& triangle)
+                                                     {
+                                                       Point2 a = polygon[triangle[0]];
+                                                       return cross(polygon[triangle[1]] - a,
+                                                                    polygon[triangle[2]] - a) == 0;
+                                                     });
+      std::cout << name << ": " << (succeeded ? "succeeded" : "failed") << ", " << triangles.size() << " triangles, "
+                << num_zero_area_triangles << " with zero area" << std::endl;
+
+      BENCHMARK(name)
+      {
+        triangulate_fn(polygon, triangles);
+        return triangles.size();
+      };
+    }
+  }
+}
+
+TEST_CASE("libtess2 2D pipeline benchmark")
+{
+  CountriesGeoJson countries = *CountriesGeoJson::read_from_file("data/countries.geojson");
+
+  for (const char* country_name : {"Canada", "Chile", "Bangladesh", "Netherlands", "San Marino"})
+  {
+    PolygonView2 polygon = countries.polygon_for_country(country_name);
+
+    std::stringstream s;
+    s << country_name << " (" << polygon.size() << " vertices), libtess2";
+    std::string name = s.str();
+
+    // The 2D only build sweeps the same coordinates as the generic float build. Country outlines have no intersecting
+    // edges, so both builds find the same triangles. Where edges do intersect, the builds place the new vertices
+    // differently, and the output can differ.
+    std::vector<std::array<int, 3>> generic_triangles, triangles_2d;
+    CHECK(triangulate_libtess2_float(polygon, generic_triangles));
+    CHECK(triangulate_libtess2_2d(polygon, triangles_2d));
+    CHECK(generic_triangles == triangles_2d);
+
+    BENCHMARK(name + ", generic")
+    {
+      triangulate_libtess2_float(polygon, generic_triangles);
+      return generic_triangles.size();
+    };
+
+    BENCHMARK(name + ", 2D only")
+    {
+      triangulate_libtess2_2d(polygon, triangles_2d);
+      return triangles_2d.size();
+    };
+  }
+}
+
+TEST_CASE("triangulate with holes benchmark")
+{
+  CountriesGeoJson countries = *CountriesGeoJson::read_from_file("data/countries.geojson");
+
+  // A few countries with well known holes, followed by the countries with the most holes, mostly lakes, where the
+  // hole handling of each backend matters most.
+  std::vector<std::string> country_names{"Canada", "Italy", "South Africa"};
+  for (const std::string& country_name : most_holes_country_names(countries, 5))
+  {
+    if (std::find(country_names.begin(), country_names.end(), country_name) == country_names.end())
+    {
+      country_names.push_back(country_name);
+    }
+  }
+
+  for (const std::string& country_name : country_names)
+  {
+    benchmark_triangulate_with_holes(country_name, countries.parts_for_country(country_name));
+  }
+}
+
+TEST_CASE("polygon store benchmark")
+{
+  CountriesGeoJson countries = *CountriesGeoJson::read_from_file("data/countries.geojson");
+  std::vector<std::string> country_names = countries.country_names();
+
+  BENCHMARK("build PolygonStore")
+  {
+    return PolygonStore::from_countries(countries);
+  };
+
+  PolygonStore store = PolygonStore::from_countries(countries);
+
+  std::stringstream s;
+  s << "Whole dataset (" << store.num_polygons() << " polygons, " << store.vertices().size() << " vertices, "
+    << store.memory_usage() << " bytes in store)";
+  std::string name = s.str();
+
+  BENCHMARK(name + ", vertex sweep, CountriesGeoJson")
+  {
+    double sum = 0.0;
+    for (const std::string& country_name : country_names)
+    {
+      for (const PolygonWithHoles2& part : countries.parts_for_country(country_name))
+      {
+        for (Point2 vertex : part.outer_boundary)
+        {
+          sum += static_cast<double>(vertex.x());
+        }
+
+        for (const Polygon2& hole : part.holes)
+        {
+          for (Point2 vertex : hole)
+          {
+            sum += static_cast<double>(vertex.x());
+          }
+        }
+      }
+    }
+
+    return sum;
+  };
+
+  BENCHMARK(name + ", vertex sweep, PolygonStore")
+  {
+    double sum = 0.0;
+    for (Point2 vertex : store.vertices())
+    {
+      sum += static_cast<double>(vertex.x());
+    }
+
+    return sum;
+  };
+
+  BENCHMARK(name + ", triangulate outer boundaries, CountriesGeoJson")
+  {
+    size_t num_triangles = 0;
+    for (const std::string& country_name : country_names)
+    {
+      for (const PolygonWithHoles2& part : countries.parts_for_country(country_name))
+      {
+        num_triangles += triangulate(part.outer_boundary).size();
+      }
+    }
+
+    return num_triangles;
+  };
+
+  BENCHMARK(name + ", triangulate outer boundaries, PolygonStore")
+  {
+    size_t num_triangles = 0;
+    for (size_t i = 0; i < store.num_polygons(); i++)
+    {
+      num_triangles += triangulate(store.polygon(i).outer_boundary()).size();
+    }
+
+    return num_triangles;
+  };
+}
+
+TEST_CASE("compressed polygon store benchmark")
+{
+  CountriesGeoJson countries = *CountriesGeoJson::read_from_file("data/countries.geojson");
+  PolygonStore store = PolygonStore::from_countries(countries);
+  CompressedPolygonStore compressed_store = CompressedPolygonStore::compress(store);
+
+  // The compressed store has no names, so it's compared with the vertices, rings and polygons of the original store.
+  size_t num_vertices = compressed_store.num_vertices();
+  size_t geometry_memory_usage = store.geometry_memory_usage();
+  std::cout << "PolygonStore: " << geometry_memory_usage << " bytes of vertices, rings and polygons, "
+            << "CompressedPolygonStore: " << compressed_store.memory_usage() << " bytes, saved "
+            << geometry_memory_usage - std::min(geometry_memory_usage, compressed_store.memory_usage()) << " bytes ("
+            << static_cast<double>(compressed_store.memory_usage()) / static_cast<double>(num_vertices)
+            << " bytes per vertex)" << std::endl;
+
+  // Every decoded ring must be identical to the ring of the original store.
+  std::vector<Point2> vertices;
+  REQUIRE(compressed_store.num_polygons() == store.num_polygons());
+  size_t num_mismatched_rings = 0;
+  for (size_t i = 0; i < store.num_polygons(); i++)
+  {
+    PolygonStore::PolygonWithHolesView polygon = store.polygon(i);
+    REQUIRE(compressed_store.num_rings(i) == 1 + polygon.num_holes());
+    for (size_t j = 0; j < compressed_store.num_rings(i); j++)
+    {
+      PolygonView2 original = j == 0 ? polygon.outer_boundary() : polygon.hole(j - 1);
+      PolygonView2 decoded = compressed_store.decode_ring(i, j, vertices);
+      if (!std::equal(decoded.begin(), decoded.end(), original.begin(), original.end()))
+      {
+        num_mismatched_rings++;
+      }
+    }
+  }
+  CHECK(num_mismatched_rings == 0);
+
+  auto decode_all = [&]()
+  {
+    size_t num_decoded = 0;
+    for (size_t i = 0; i < compressed_store.num_polygons(); i++)
+    {
+      for (size_t j = 0; j < compressed_store.num_rings(i); j++)
+      {
+        num_decoded += compressed_store.decode_ring(i, j, vertices).size();
+      }
+    }
+
+    return num_decoded;
+  };
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  decode_all();
+  std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+  std::cout << "CompressedPolygonStore decode: " << duration.count() / static_cast<double>(num_vertices)
+            << " ns per vertex" << std::endl;
+
+  std::stringstream s;
+  s << "Whole dataset (" << compressed_store.num_polygons() << " polygons, " << num_vertices << " vertices)";
+  std::string name = s.str();
+
+  BENCHMARK(name + ", decode, CompressedPolygonStore")
+  {
+    return decode_all();
+  };
+
+  BENCHMARK(name + ", triangulate outer boundaries, CompressedPolygonStore")
+  {
+    size_t num_triangles = 0;
+    for (size_t i = 0; i < compressed_store.num_polygons(); i++)
+    {
+      num_triangles += triangulate(compressed_store.decode_ring(i, 0, vertices)).size();
+    }
+
+    return num_triangles;
+  };
+}
+
+/// Reads all polygons from the given GeoJSONSeq file and passes each of them to @c triangulate_fn, which returns the
+/// number of triangles, or 0 if it failed. Returns the number of features for which all polygons were triangulated.
+template <class TriangulateFn>
+size_t triangulate_geojson_seq(const std::string& file_name, TriangulateFn& triangulate_fn)
+{
+  std::ifstream stream(file_name);
+  GeoJsonSeqReader reader(stream);
+  size_t num_triangulated = 0;
+  size_t feature = 0;
+  bool feature_ok = true;
+  while (reader.next())
+  {
+    if (reader.num_features() != feature)
+    {
+      num_triangulated += feature != 0 && feature_ok ? 1 : 0;
+      feature = reader.num_features();
+      feature_ok = true;
+    }
+
+    if (triangulate_fn(reader) == 0)
+    {
+      feature_ok = false;
+    }
+  }
+
+  return num_triangulated + (feature != 0 && feature_ok ? 1 : 0);
+}
+
+template <class TriangulateFn>
+void benchmark_triangulate_geojson_seq(const std::string& file_name, const std::string& backend_name,
+                                       TriangulateFn triangulate_fn)
+{
+  // A single timed pass over the whole stream, to report the sustained throughput.
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  size_t num_features = triangulate_geojson_seq(file_name, triangulate_fn);
+  std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+  std::cout << "GeoJSONSeq stream, " << backend_name << ": " << static_cast<double>(num_features) / duration.count()
+            << " features/s" << std::endl;
+
+  std::stringstream s;
+  s << "GeoJSONSeq stream (" << num_features << " features), " << backend_name;
+  BENCHMARK(s.str())
+  {
+    return triangulate_geojson_seq(file_name, triangulate_fn);
+  };
+}
+
+TEST_CASE("GeoJSONSeq stream benchmark")
+{
+  const std::string file_name = "data/countries.geojsonseq";
+  REQUIRE(convert_geojson_to_geojson_seq("data/countries.geojson", file_name));
+
+  // Reading and decoding only, for comparison.
+  benchmark_triangulate_geojson_seq(file_name, "decode only",
+                                    [](const GeoJsonSeqReader& reader) { return reader.num_vertices(); });
+
+  // The buffers of each backend are reused from polygon to polygon, just like the vertex buffer of the reader.
+
+  std::vector<float> tess_contour;
+  auto triangulate_libtess2 = [&](const GeoJsonSeqReader& reader)
+  {
+    TESStesselator* tessellator = tessNewTess(nullptr);
+    tessSetOption(tessellator, TESS_CONSTRAINED_DELAUNAY_TRIANGULATION, 0);
+    for (size_t i = 0; i < reader.num_rings(); i++)
+    {
+      tess_contour.clear();
+      for (Point2 vertex : reader.ring(i))
+      {
+        tess_contour.push_back(static_cast<float>(static_cast<double>(vertex.x())));
+        tess_contour.push_back(static_cast<float>(static_cast<double>(vertex.y())));
+      }
+
+      tessAddContour(tessellator, 2, tess_contour.data(), 2 * sizeof(float), static_cast<int>(reader.ring(i).size()));
+    }
+    tessTesselate(tessellator, TESS_WINDING_ODD, TESS_POLYGONS, 3, 2, nullptr);
+    int num_triangles = tessGetElementCount(tessellator);
+    tessDeleteTess(tessellator);
+
+    return num_triangles;
+  };
+  benchmark_triangulate_geojson_seq(file_name, "libtess2", triangulate_libtess2);
+
+  // The same, but with a single tesselator which keeps its memory warm from polygon to polygon.
+  TESStesselator* reused_tessellator = tessNewTess(nullptr);
+  tessSetOption(reused_tessellator, TESS_CONSTRAINED_DELAUNAY_TRIANGULATION, 0);
+  auto triangulate_libtess2_reused = [&](const GeoJsonSeqReader& reader)
+  {
+    for (size_t i = 0; i < reader.num_rings(); i++)
+    {
+      tess_contour.clear();
+      for (Point2 vertex : reader.ring(i))
+      {
+        tess_contour.push_back(static_cast<float>(static_cast<double>(vertex.x())));
+        tess_contour.push_back(static_cast<float>(static_cast<double>(vertex.y())));
+      }
+
+      tessAddContour(reused_tessellator, 2, tess_contour.data(), 2 * sizeof(float),
+                     static_cast<int>(reader.ring(i).size()));
+    }
+    tessTesselate(reused_tessellator, TESS_WINDING_ODD, TESS_POLYGONS, 3, 2, nullptr);
+
+    return tessGetElementCount(reused_tessellator);
+  };
+  benchmark_triangulate_geojson_seq(file_name, "libtess2, reused tesselator", triangulate_libtess2_reused);
+  tessDeleteTess(reused_tessellator);
+
+  using MapboxPoint = std::pair<float, float>;
+  std::vector<std::vector<MapboxPoint>> mapbox_polygon;
+  auto triangulate_earcut = [&](const GeoJsonSeqReader& reader)
+  {
+    mapbox_polygon.resize(reader.num_rings());
+    for (size_t i = 0; i < reader.num_rings(); i++)
+    {
+      mapbox_polygon[i].clear();
+      for (Point2 vertex : reader.ring(i))
+      {
+        mapbox_polygon[i].emplace_back(static_cast<double>(vertex.x()), static_cast<double>(vertex.y()));
+      }
+    }
+
+    return mapbox::earcut<uint32_t>(mapbox_polygon).size() / 3;
+  };
+  benchmark_triangulate_geojson_seq(file_name, "Mapbox earcut.hpp", triangulate_earcut);
+
+  // As in benchmark_triangulate_with_holes, the holes are reversed to make them clockwise, and index 0 of the vertex
+  // array is unused.
+  std::vector<int> seidel_contour_sizes;
+  std::vector<SeidelPoint> seidel_vertices;
+  std::vector<SeidelTriangle> seidel_triangles;
+  auto triangulate_seidel = [&](const GeoJsonSeqReader& reader)
+  {
+    seidel_contour_sizes.clear();
+    reserve_seidel_buffer(seidel_vertices, reader.num_vertices() + 1);
+
+    size_t j = 1;
+    for (size_t i = 0; i < reader.num_rings(); i++)
+    {
+      ArrayView<const Point2> ring = reader.ring(i);
+      seidel_contour_sizes.push_back(static_cast<int>(ring.size()));
+      for (size_t k = 0; k < ring.size(); k++)
+      {
+        Point2 vertex = i == 0 ? ring[k] : ring[ring.size() - 1 - k];
+        seidel_vertices[j][0] = static_cast<double>(vertex.x());
+        seidel_vertices[j][1] = static_cast<double>(vertex.y());
+        j++;
+      }
+    }
+
+    size_t num_triangles = reader.num_vertices() - 2 + 2 * (reader.num_rings() - 1);
+    reserve_seidel_buffer(seidel_triangles, num_triangles);
+    if (triangulate_polygon(static_cast<int>(seidel_contour_sizes.size()), seidel_contour_sizes.data(),
+                            seidel_vertices.data(), seidel_triangles.data()) != 0)
+    {
+      return size_t(0);
+    }
+
+    return num_triangles;
+  };
+  benchmark_triangulate_geojson_seq(file_name, "Seidel", triangulate_seidel);
+}
+
+/// Triangulates the outer boundaries of the polygons of @c store with the given indices on @c num_threads threads, and
+/// returns the total number of triangles. The threads take polygons from a shared counter, so that a thread which drew
+/// small polygons doesn't sit idle while another one is still busy with a large one. @c make_worker is called once on
+/// every thread, and returns the function which triangulates a single polygon on that thread, so that each thread owns
+/// the state of its triangulator.
+template <class MakeWorker>
+size_t triangulate_on_threads(const PolygonStore& store, const std::vector<size_t>& polygon_indices,
+                              unsigned num_threads, MakeWorker make_worker)
+{
+  std::atomic<size_t> next_polygon{0};
+  std::atomic<size_t> num_triangles{0};
+  auto run = [&]()
+  {
+    auto worker = make_worker();
+    size_t thread_num_triangles = 0;
+    for (size_t i = next_polygon++; i < polygon_indices.size(); i = next_polygon++)
+    {
+      thread_num_triangles += worker(store.polygon(polygon_indices[i]).outer_boundary());
+    }
+
+    num_triangles += thread_num_triangles;
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned i = 1; i < num_threads; i++)
+  {
+    threads.emplace_back(run);
+  }
+
+  run();
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  return num_triangles;
+}
+
+TEST_CASE("multicore throughput benchmark")
+{
+  CountriesGeoJson countries = *CountriesGeoJson::read_from_file("data/countries.geojson");
+  PolygonStore store = PolygonStore::from_countries(countries);
+
+  std::vector<size_t> polygon_indices(store.num_polygons());
+  size_t num_vertices = 0;
+  for (size_t i = 0; i < store.num_polygons(); i++)
+  {
+    polygon_indices[i] = i;
+    num_vertices += store.polygon(i).outer_boundary().size();
+  }
+
+  // Each thread triangulates with its own Seidel context, which owns all of Seidel's tables.
+  auto make_seidel_worker = []()
+  {
+    std::shared_ptr<seidel_context_t> context(seidel_create_context(), seidel_destroy_context);
+    return [context, vertices = std::vector<SeidelPoint>(),
+            triangles = std::vector<SeidelTriangle>()](PolygonView2 polygon) mutable
+    {
+      reserve_seidel_buffer(vertices, polygon.size() + 1);
+      for (size_t i = 0; i < polygon.size(); i++)
+      {
+        vertices[i + 1][0] = static_cast<double>(polygon[i].x());
+        vertices[i + 1][1] = static_cast<double>(polygon[i].y());
+      }
+
+      reserve_seidel_buffer(triangles, polygon.size() - 2);
+      int num_vertices = static_cast<int>(polygon.size());
+      if (seidel_triangulate_polygon(context.get(), 1, &num_vertices, vertices.data(), triangles.data()) != 0)
+      {
+        return size_t(0);
+      }
+
+      return polygon.size() - 2;
+    };
+  };
+
+  // Each thread reuses its own tesselator.
+  auto make_libtess2_worker = []()
+  {
+    std::shared_ptr<TESStesselator> tessellator(tessNewTess(nullptr), tessDeleteTess);
+    return [tessellator, vertices = std::vector<float>()](PolygonView2 polygon) mutable
+    {
+      vertices.resize(2 * polygon.size());
+      for (size_t i = 0; i < polygon.size(); i++)
+      {
+        vertices[2 * i] = static_cast<float>(static_cast<double>(polygon[i].x()));
+        vertices[2 * i + 1] = static_cast<float>(static_cast<double>(polygon[i].y()));
+      }
+
+      tessAddContour(tessellator.get(), 2, vertices.data(), 2 * sizeof(float), static_cast<int>(polygon.size()));
+      tessTesselate(tessellator.get(), TESS_WINDING_ODD, TESS_POLYGONS, 3, 2, nullptr);
+      return static_cast<size_t>(tessGetElementCount(tessellator.get()));
+    };
+  };
+
+  auto make_earcut_worker = []()
+  {
+    return [](PolygonView2 polygon)
+    {
+      using MapboxPoint = std::pair<double, double>;
+      std::vector<std::vector<MapboxPoint>> mapbox_polygon(1);
+      mapbox_polygon[0].reserve(polygon.size());
+      for (Point2 vertex : polygon)
+      {
+        mapbox_polygon[0].emplace_back(static_cast<double>(vertex.x()), static_cast<double>(vertex.y()));
+      }
+
+      return mapbox::earcut<uint32_t>(mapbox_polygon).size() / 3;
+    };
+  };
+
+  std::vector<unsigned> thread_counts{1};
+  unsigned hardware_threads = std::thread::hardware_concurrency();
+  if (hardware_threads > 1)
+  {
+    thread_counts.push_back(hardware_threads);
+  }
+
+  for (unsigned num_threads : thread_counts)
+  {
+    std::stringstream s;
+    s << "Outer boundaries (" << polygon_indices.size() << " polygons, " << num_vertices << " vertices), "
+      << num_threads << (num_threads == 1 ? " thread" : " threads");
+    std::string name = s.str();
+
+    BENCHMARK(name + ", Seidel")
+    {
+      return triangulate_on_threads(store, polygon_indices, num_threads, make_seidel_worker);
+    };
+
+    BENCHMARK(name + ", libtess2")
+    {
+      return triangulate_on_threads(store, polygon_indices, num_threads, make_libtess2_worker);
+    };
+
+    BENCHMARK(name + ", Mapbox earcut.hpp")
+    {
+      return triangulate_on_threads(store, polygon_indices, num_threads, make_earcut_worker);
+    };
+  }
+}
@@ -1,5 +1,7 @@
 #include "validation.hpp"
 
+#include <algorithm>
+#include <array>
 #include <iostream>
 #include <unordered_set>
 
@@ -138,4 +140,140 @@ bool validate_triangulation(PolygonView2 polygon, ArrayView<const Triangle2> tri
   }
 
   return true;
-}
\ No newline at end of file
+}
+
+namespace
+{
+
+/// A use of the edge from @c start to @c end, with <tt>lex_less_than(start, end)</tt>, counted as @c +1 when it's
+/// used from @c start to @c end and as @c -1 when it's used from @c end to @c start.
+struct EdgeUse
+{
+  Point2 start;
+  Point2 end;
+  int count;
+};
+
+/// Adds a use of the edge from @c a to @c b to @c edge_uses, with the given count.
+void add_edge_use(std::vector<EdgeUse>& edge_uses, Point2 a, Point2 b, int count)
+{
+  if (lex_less_than(a, b))
+  {
+    edge_uses.push_back({a, b, count});
+  }
+  else
+  {
+    edge_uses.push_back({b, a, -count});
+  }
+}
+
+} // namespace
+
+bool validate_triangulation(const PolygonWithHoles2& polygon, ArrayView<const Triangle2> triangles)
+{
+  // Each triangle, in counter clockwise order, uses its edges in the direction which has its interior to the left, and
+  // so does the boundary of 'polygon', with the outer boundary counter clockwise and the holes clockwise. If every edge
+  // is used as many times in each direction by the triangles as by the boundary, then the triangles cover each point
+  // as many times as the boundary winds around it, which is once inside 'polygon' and zero times outside it. So we
+  // check the following:
+  //
+  // 1. The number of triangles is the number of vertices minus 2, plus 2 for every hole.
+  // 2. Each triangle is valid.
+  // 3. All triangle vertices are vertices of 'polygon'.
+  // 4. The triangles and the boundary of 'polygon' use every edge the same number of times in each direction.
+  //
+
+  size_t expected_num_triangles = polygon.num_vertices() - 2 + 2 * polygon.holes.size();
+  if (triangles.size() != expected_num_triangles)
+  {
+    std::cout << "Incorrect number of triangles in triangulation. Expected: " << expected_num_triangles
+              << ", actual: " << triangles.size() << std::endl;
+    return false;
+  }
+
+  std::unordered_set<Point2> vertices_set(polygon.outer_boundary.begin(), polygon.outer_boundary.end());
+  for (const Polygon2& hole : polygon.holes)
+  {
+    vertices_set.insert(hole.begin(), hole.end());
+  }
+
+  std::vector<EdgeUse> edge_uses;
+  edge_uses.reserve(3 * triangles.size() + polygon.num_vertices());
+
+  for (size_t i = 0; i < triangles.size(); i++)
+  {
+    std::array<Point2, 3> vertices{triangles[i][0], triangles[i][1], triangles[i][2]};
+    for (size_t j = 0; j < 3; j++)
+    {
+      if (vertices_set.find(vertices[j]) == vertices_set.end())
+      {
+        std::cout << "triangles[" << i << "], vertex " << j << " does not occur in 'polygon'" << std::endl;
+        return false;
+      }
+    }
+
+    if (cross(vertices[1] - vertices[0], vertices[2] - vertices[0]) < 0)
+    {
+      std::swap(vertices[1], vertices[2]);
+    }
+
+    if (!validate_convex_polygon_vertices(Triangle2(vertices)))
+    {
+      std::cout << "triangles[" << i << "] isn't valid." << std::endl;
+      return false;
+    }
+
+    for (size_t j = 0; j < 3; j++)
+    {
+      add_edge_use(edge_uses, vertices[j], vertices[succ_modulo<size_t>(j, 3)], 1);
+    }
+  }
+
+  for (size_t i = 0; i < polygon.outer_boundary.size(); i++)
+  {
+    add_edge_use(edge_uses, polygon.outer_boundary[i],
+                 polygon.outer_boundary[succ_modulo(i, polygon.outer_boundary.size())], -1);
+  }
+
+  for (const Polygon2& hole : polygon.holes)
+  {
+    // The holes are counter clockwise, so their edges are used in the opposite direction.
+    for (size_t i = 0; i < hole.size(); i++)
+    {
+      add_edge_use(edge_uses, hole[i], hole[succ_modulo(i, hole.size())], 1);
+    }
+  }
+
+  std::sort(edge_uses.begin(), edge_uses.end(),
+            [](const EdgeUse& a, const EdgeUse& b)
+            {
+              if (a.start == b.start)
+              {
+                return lex_less_than(a.end, b.end);
+              }
+
+              return lex_less_than(a.start, b.start);
+            });
+
+  for (size_t i = 0; i < edge_uses.size();)
+  {
+    int count = 0;
+    size_t j = i;
+    for (; j < edge_uses.size() && edge_uses[j].start == edge_uses[i].start && edge_uses[j].end == edge_uses[i].end;
+         j++)
+    {
+      count += edge_uses[j].count;
+    }
+
+    if (count != 0)
+    {
+      std::cout << "The edge from " << edge_uses[i].start << " to " << edge_uses[i].end << " is used " << count
+                << " more times from start to end by the triangles than by the boundary of 'polygon'." << std::endl;
+      return false;
+    }
+
+    i = j;
+  }
+
+  return true;
+}
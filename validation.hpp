@@ -1,5 +1,6 @@
 #pragma once
 
+#include "countries_geojson.hpp"
 #include "dida/polygon2.hpp"
 #include "dida/convex_polygon2.hpp"
 
@@ -8,4 +9,10 @@ using namespace dida;
 /// Validates whether @c triangles form a valid triangulation of @c polygon.
 ///
 /// The triangulation is valid if it's a tessellation of @c polygon.
-bool validate_triangulation(PolygonView2 polygon, ArrayView<const Triangle2> triangles);
\ No newline at end of file
+bool validate_triangulation(PolygonView2 polygon, ArrayView<const Triangle2> triangles);
+
+/// Validates whether @c triangles form a valid triangulation of @c polygon, including its holes.
+///
+/// The triangulation is valid if it's a tessellation of @c polygon. The triangles may have either orientation. Unlike
+/// the overload for polygons without holes, this takes O(n log n) time, so it can be used on whole countries.
+bool validate_triangulation(const PolygonWithHoles2& polygon, ArrayView<const Triangle2> triangles);